@@ -6,6 +6,7 @@
 #include <atomic>
 #include <bit>
 #include <concepts>
+#include <condition_variable>
 #include <charconv>
 #include <cassert>
 #include <cctype>
@@ -9,6 +9,7 @@
 #include <memory/memory.h>
 #include <memory/pif.h>
 #include <memory/savestates.h>
+#include <memory/st_hash.h>
 #include <r4300/debugger.h>
 #include <r4300/disasm.h>
 #include <r4300/r4300.h>
@@ -39,6 +40,12 @@ static void log_dummy(std::string_view)
 
 core_result core_create(core_params *params, core_ctx **ctx)
 {
+    // Replacing the params under a running emulator would redirect its callbacks and plugins to another instance.
+    if (emu_launched && g_core && g_core != params)
+    {
+        return IN_InstanceActive;
+    }
+
     g_core = params;
 
     // if (!g_core->io_service)
@@ -113,6 +120,7 @@ core_result core_create(core_params *params, core_ctx **ctx)
     g_ctx.vcr_replace_author_info = vcr_replace_author_info;
     g_ctx.vcr_get_seek_info = vcr_get_seek_info;
     g_ctx.vcr_begin_seek = vcr_begin_seek;
+    g_ctx.vcr_prefetch_seek = vcr_prefetch_seek;
     g_ctx.vcr_stop_seek = vcr_stop_seek;
     g_ctx.vcr_is_seeking = vcr_is_seeking;
     g_ctx.vcr_write_backup = vcr_write_backup;
@@ -123,6 +131,7 @@ core_result core_create(core_params *params, core_ctx **ctx)
     g_ctx.vcr_get_length_vis = vcr_get_length_vis;
     g_ctx.vcr_get_current_vi = vcr_get_current_vi;
     g_ctx.vcr_get_inputs = vcr_get_inputs;
+    g_ctx.vcr_view_inputs = vcr_view_inputs;
     g_ctx.vcr_begin_warp_modify = vcr_begin_warp_modify;
     g_ctx.vcr_get_warp_modify_status = vcr_get_warp_modify_status;
     g_ctx.vcr_get_warp_modify_first_difference_frame = vcr_get_warp_modify_first_difference_frame;
@@ -131,9 +140,12 @@ core_result core_create(core_params *params, core_ctx **ctx)
     g_ctx.tl_active = tl_active;
     g_ctx.tl_start = tl_start;
     g_ctx.tl_stop = tl_stop;
+    g_ctx.tl_get_filter = tl_get_filter;
+    g_ctx.tl_set_filter = tl_set_filter;
     g_ctx.st_do_file = st_do_file;
     g_ctx.st_do_memory = st_do_memory;
     g_ctx.st_get_undo_savestate = st_get_undo_savestate;
+    g_ctx.st_hash = st_hash;
     g_ctx.dbg_get_resumed = dbg_get_resumed;
     g_ctx.dbg_set_is_resumed = dbg_set_is_resumed;
     g_ctx.dbg_step = dbg_step;
@@ -141,6 +153,12 @@ core_result core_create(core_params *params, core_ctx **ctx)
     g_ctx.dbg_set_dma_read_enabled = dbg_set_dma_read_enabled;
     g_ctx.dbg_get_rsp_enabled = dbg_get_rsp_enabled;
     g_ctx.dbg_set_rsp_enabled = dbg_set_rsp_enabled;
+    g_ctx.dbg_add_breakpoint = dbg_add_breakpoint;
+    g_ctx.dbg_remove_breakpoint = dbg_remove_breakpoint;
+    g_ctx.dbg_get_breakpoints = dbg_get_breakpoints;
+    g_ctx.dbg_add_watchpoint = dbg_add_watchpoint;
+    g_ctx.dbg_remove_watchpoint = dbg_remove_watchpoint;
+    g_ctx.dbg_get_watchpoints = dbg_get_watchpoints;
     g_ctx.dbg_disassemble = dbg_disassemble;
 
     *ctx = &g_ctx;
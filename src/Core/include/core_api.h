@@ -505,6 +505,15 @@ extern "C"
          */
         std::function<core_result(std::string str, bool pause_at_end)> vcr_begin_seek;
 
+        /**
+         * \brief Prepares the seek savestate which a seek with the specified parameters would load in the background,
+         * so that seek starts faster if it's initiated soon after.
+         * \param str A seek format string. See <c>vcr_begin_seek</c>.
+         * \param pause_at_end Whether the emu would be paused when the seek operation ends
+         * \remarks Hosts should call this when a seek target becomes likely, e.g. when the user selects a frame.
+         */
+        std::function<void(std::string str, bool pause_at_end)> vcr_prefetch_seek;
+
         /**
          * \brief Stops the current seek operation
          */
@@ -557,6 +566,12 @@ extern "C"
          */
         std::function<std::vector<core_buttons>()> vcr_get_inputs;
 
+        /**
+         * Calls a function with a read-only view of the current input buffer, which avoids copying it. The view is only
+         * valid during the call. The VCR lock is held during the call, so the function must not call VCR functions.
+         */
+        std::function<void(const std::function<void(std::span<const core_buttons>)> &)> vcr_view_inputs;
+
         /**
          * Begins a warp modification operation. A "warp modification operation" is the changing of sample data which is
          * temporally behind the current sample.
@@ -621,18 +636,30 @@ extern "C"
         std::function<bool()> tl_active;
 
         /**
-         * \brief Starts trace logging to the specified file.
+         * \brief Starts trace logging to the specified file. Stops the active trace log, if any.
          * \param path The output path.
-         * \param binary Whether log output is in a binary format.
+         * \param binary Whether log output is in the binary format described in core_trace.h.
          * \param append Whether log output will be appended to the file.
+         * \return The operation result.
          */
-        std::function<void(std::filesystem::path path, bool binary, bool append)> tl_start;
+        std::function<core_result(std::filesystem::path path, bool binary, bool append)> tl_start;
 
         /**
          * \brief Stops trace logging.
          */
         std::function<void()> tl_stop;
 
+        /**
+         * \brief Gets the filter which restricts the logged instructions.
+         */
+        std::function<core_tl_filter()> tl_get_filter;
+
+        /**
+         * \brief Sets the filter which restricts the logged instructions. Takes effect when the next trace log starts.
+         * \param filter The filter.
+         */
+        std::function<void(const core_tl_filter &filter)> tl_set_filter;
+
 #pragma endregion
 
 #pragma region Savestates
@@ -641,7 +668,8 @@ extern "C"
          * \brief Executes a savestate operation to a path.
          * \param path The savestate's path.
          * \param job The job to set.
-         * \param callback The callback to call when the operation is complete.
+         * \param callback The callback to call when the operation is complete. Saves are compressed and written to disk
+         * in the background, and complete on the emu thread once the write has finished.
          * \param ignore_warnings Whether warnings, such as those about ROM compatibility, shouldn't be shown.
          * \warning The operation won't complete immediately. Must be called via AsyncExecutor unless calls are
          * originating from the emu thread. \return Whether the operation was enqueued.
@@ -667,6 +695,15 @@ extern "C"
          */
         std::function<void(std::vector<uint8_t> &buffer)> st_get_undo_savestate;
 
+        /**
+         * \brief Computes a 64-bit hash of the emulator state, which is much cheaper than generating and comparing
+         * savestates.
+         * \param regions The state regions to hash, as a combination of <c>core_st_hash_region</c> flags.
+         * \return The hash. Equal states produce equal hashes for the same set of regions.
+         * \warning Must be called from the emu thread (e.g. from a core callback) or while the emulator is paused.
+         */
+        std::function<uint64_t(uint32_t regions)> st_hash;
+
 #pragma endregion
 
 #pragma region Debugger
@@ -706,6 +743,40 @@ extern "C"
          */
         std::function<void(bool)> dbg_set_rsp_enabled;
 
+        /**
+         * \brief Adds a breakpoint which pauses execution before the instruction at the specified address runs.
+         * \remarks Breakpoints are only honored by the pure interpreter.
+         */
+        std::function<void(uint32_t address)> dbg_add_breakpoint;
+
+        /**
+         * \brief Removes the breakpoint at the specified address, if any.
+         */
+        std::function<void(uint32_t address)> dbg_remove_breakpoint;
+
+        /**
+         * \brief Gets the addresses of all breakpoints in ascending order.
+         */
+        std::function<std::vector<uint32_t>()> dbg_get_breakpoints;
+
+        /**
+         * \brief Adds a watchpoint which pauses execution when the CPU accesses memory in its range. Replaces any
+         * watchpoint at the same address.
+         * \remarks Accesses which bypass the memory handler tables aren't caught. Those are DMA transfers, plugins
+         * accessing RDRAM directly, and the dynarec's inlined RDRAM accesses.
+         */
+        std::function<void(const core_dbg_watchpoint &watchpoint)> dbg_add_watchpoint;
+
+        /**
+         * \brief Removes the watchpoint at the specified address, if any.
+         */
+        std::function<void(uint32_t address)> dbg_remove_watchpoint;
+
+        /**
+         * \brief Gets all watchpoints ordered by address.
+         */
+        std::function<std::vector<core_dbg_watchpoint>()> dbg_get_watchpoints;
+
         /**
          * \brief Disassembles an instruction at a given address.
          * TODO: Refactor
@@ -804,7 +875,12 @@ template <typename T> void core_rdram_store(uint8_t *rdram, const uint32_t addr,
 
 /**
  * \brief Creates a core instance with the specified parameters.
- * \remark Only one core instance is currently supported.
+ * \param params The core parameters. Must outlive the instance.
+ * \param ctx Receives the core context.
+ * \return The operation result. IN_InstanceActive if another instance is running a rom.
+ * \remark Only one core instance per process is supported, as the emulated machine's state and the plugins are
+ * process-global. Calling this again replaces the previous instance, which is only allowed while no rom is running.
+ * Use one process per instance to run several emulators in parallel.
  */
 core_result core_create(core_params *params, core_ctx **ctx);
 
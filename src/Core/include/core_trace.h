@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include "core_types.h"
+
+/*
+ * Binary trace files.
+ *
+ * A trace file starts with a header, followed by chunks of instruction records and an index of the chunks. Each chunk
+ * is compressed on its own and only holds records of a single VI, so readers can locate the chunks of a VI or PC range
+ * through the index and only decompress those.
+ *
+ * Layout:
+ *  core_trace_header
+ *  for each chunk: core_trace_chunk_header, compressed core_trace_record[record_count]
+ *  core_trace_index_header, core_trace_chunk[count]
+ *
+ * The index is written when tracing stops. Files without one, e.g. because the emulator crashed, remain readable, as
+ * the chunk headers hold the same information and can be walked without decompressing anything.
+ *
+ * All values are little-endian.
+ */
+
+// "M64T"
+constexpr uint32_t CORE_TRACE_MAGIC = 0x5434364D;
+// "CHNK"
+constexpr uint32_t CORE_TRACE_CHUNK_MAGIC = 0x4B4E4843;
+// "INDX"
+constexpr uint32_t CORE_TRACE_INDEX_MAGIC = 0x58444E49;
+constexpr uint16_t CORE_TRACE_VERSION = 1;
+
+typedef struct
+{
+    // CORE_TRACE_MAGIC
+    uint32_t magic;
+    // CORE_TRACE_VERSION
+    uint16_t version;
+    // The size of a record in bytes.
+    uint16_t record_size;
+    // The codec the chunks are compressed with. Either core_st_codec_store or core_st_codec_zstd.
+    uint32_t codec;
+    // The movie's current VI when tracing started, or -1 if no movie was active.
+    int32_t start_vi;
+    // The offset of the index, or 0 if tracing didn't stop cleanly.
+    uint64_t index_offset;
+} core_trace_header;
+
+typedef struct
+{
+    // CORE_TRACE_CHUNK_MAGIC
+    uint32_t magic;
+    // The size of the compressed records following the header.
+    uint32_t size;
+    // The amount of records in the chunk.
+    uint32_t record_count;
+    // The VI the records were executed in, counted from the start of the trace.
+    uint32_t vi;
+    // The lowest and highest address among the records.
+    uint32_t pc_min;
+    uint32_t pc_max;
+} core_trace_chunk_header;
+
+typedef struct
+{
+    // CORE_TRACE_INDEX_MAGIC
+    uint32_t magic;
+    // The amount of chunks in the index.
+    uint32_t count;
+} core_trace_index_header;
+
+typedef struct
+{
+    // The offset of the chunk's header in the file.
+    uint64_t offset;
+    core_trace_chunk_header header;
+} core_trace_chunk;
+
+typedef struct
+{
+    // The instruction's address.
+    uint32_t pc;
+    // The instruction's opcode.
+    uint32_t opcode;
+    // Up to two register values or effective addresses the instruction operates on, depending on its format. Unused
+    // operands are 0.
+    uint32_t operands[2];
+} core_trace_record;
+
+/**
+ * \brief Reads binary trace files.
+ */
+class core_trace_reader
+{
+public:
+    /**
+     * \brief Opens a trace file and reads its index, or rebuilds the index from the chunk headers if the file has none.
+     * \param path The trace file's path.
+     * \return The operation result.
+     */
+    core_result open(const std::filesystem::path &path);
+
+    /**
+     * \brief Gets the header of the opened trace file.
+     */
+    const core_trace_header &header() const;
+
+    /**
+     * \brief Gets the chunks of the opened trace file, ordered by their position in the file and thus by VI.
+     */
+    const std::vector<core_trace_chunk> &chunks() const;
+
+    /**
+     * \brief Finds the first chunk whose VI is greater than or equal to the specified one.
+     * \return The chunk's index, or the amount of chunks if there is none.
+     */
+    size_t find_vi(uint32_t vi) const;
+
+    /**
+     * \brief Reads and decompresses a chunk's records.
+     * \param index The chunk's index.
+     * \param records Receives the records.
+     * \return The operation result.
+     */
+    core_result read_chunk(size_t index, std::vector<core_trace_record> &records);
+
+private:
+    std::ifstream m_file;
+    core_trace_header m_header{};
+    std::vector<core_trace_chunk> m_chunks;
+    std::vector<uint8_t> m_buf;
+};
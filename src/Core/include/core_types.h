@@ -97,6 +97,8 @@ typedef enum
     ST_EventQueueTooLong,
     // The CPU registers contained invalid values
     ST_InvalidRegisters,
+    // The savestate was created by a newer version with an incompatible format
+    ST_UnsupportedVersion,
 
     // Plugins
     // ==========================================
@@ -111,6 +113,16 @@ typedef enum
 
     // The core params are missing a critical component.
     IN_MissingComponent,
+    // Another core instance is running a rom in this process.
+    IN_InstanceActive,
+
+    // Tracelog
+    // ==========================================
+
+    // The trace file couldn't be opened or written
+    TL_BadFile,
+    // The trace file has an invalid format or is corrupted
+    TL_InvalidFormat,
 
 } core_result;
 
@@ -130,8 +142,10 @@ struct core_cfg
     /// The currently selected core type
     /// <para/>
     /// 0 - Cached Interpreter
-    /// 1 - Dynamic Recompiler
+    /// 1 - Dynamic Recompiler (x86 builds only. Falls back to the Cached Interpreter elsewhere, or to the experimental
+    /// integer JIT on x86-64 builds with MUPEN64RR_ENABLE_DYNAREC_X64)
     /// 2 - Pure Interpreter
+    /// 3 - Threaded Interpreter
     /// </summary>
     int32_t core_type = 1;
 
@@ -169,6 +183,16 @@ struct core_cfg
     /// </summary>
     int32_t st_screenshot;
 
+    /// <summary>
+    /// The codec used to compress savestate files
+    /// <para/>
+    /// 0 - Store
+    /// 1 - LZ4
+    /// 2 - zstd
+    /// 3 - gzip
+    /// </summary>
+    int32_t st_codec = 3;
+
     /// <summary>
     /// Whether a playing movie will loop upon ending
     /// </summary>
@@ -229,7 +253,16 @@ struct core_cfg
     /// <summary>
     /// The maximum amount of warp modify savestates to keep in memory
     /// </summary>
-    int32_t seek_savestate_max_count = 20;
+    int32_t seek_savestate_max_count = 200;
+
+    /// <summary>
+    /// Which seek savestate is evicted when the maximum amount is exceeded
+    /// <para/>
+    /// 0 - The oldest one
+    /// 1 - The least recently used one
+    /// 2 - Thin out savestates far from the current frame
+    /// </summary>
+    int32_t seek_savestate_eviction = 0;
 
     /// <summary>
     /// The movie frame to automatically pause at
@@ -258,6 +291,15 @@ struct core_cfg
     /// </summary>
     int32_t vcr_write_extended_format = 1;
 
+    /// <summary>
+    /// When writes to the recorded movie are synced to the storage device.
+    /// <para/>
+    /// 0 - Never
+    /// 1 - When the recording stops
+    /// 2 - After every write
+    /// </summary>
+    int32_t vcr_sync = 1;
+
     /// <summary>
     /// Makes the emulator wait at the last frame of a movie.
     /// </summary>
@@ -700,6 +742,27 @@ typedef enum
     task_playback
 } core_vcr_task;
 
+typedef enum
+{
+    // Movie writes are left to the operating system's write-back.
+    core_vcr_sync_never,
+    // The movie file is synced to the storage device when a recording stops.
+    core_vcr_sync_on_stop,
+    // The movie file is synced to the storage device after every write.
+    core_vcr_sync_always,
+} core_vcr_sync;
+
+typedef enum
+{
+    // The seek savestate with the lowest frame is evicted.
+    core_seek_savestate_eviction_oldest,
+    // The seek savestate which was created or loaded the longest time ago is evicted.
+    core_seek_savestate_eviction_lru,
+    // Seek savestates are thinned out so their spacing grows with the distance to the current frame, keeping recent
+    // frames densely covered while still reaching far back.
+    core_seek_savestate_eviction_thinning,
+} core_seek_savestate_eviction;
+
 /**
  * \brief Represents information about a seek operation.
  */
@@ -726,14 +789,92 @@ struct core_vcr_seek_info
 // #pragma region Debugger
 // ==========================================
 
+typedef enum
+{
+    // Reads from the watched range.
+    core_dbg_watch_read = 1 << 0,
+    // Writes to the watched range.
+    core_dbg_watch_write = 1 << 1,
+    // Reads from and writes to the watched range.
+    core_dbg_watch_access = core_dbg_watch_read | core_dbg_watch_write,
+} core_dbg_watch_kind;
+
+typedef struct
+{
+    // The virtual address of the watched range's first byte.
+    uint32_t address;
+    // The watched range's length in bytes.
+    uint32_t size;
+    // The accesses which pause execution, as a combination of core_dbg_watch_kind flags.
+    uint32_t kind;
+} core_dbg_watchpoint;
+
 typedef struct
 {
     uint32_t opcode;
     uint32_t address;
+    // The address of the memory access which hit a watchpoint, or 0 if execution didn't stop at one.
+    uint32_t watch_address;
+    // The kind of the memory access which hit a watchpoint.
+    core_dbg_watch_kind watch_kind;
 } core_dbg_cpu_state;
 
 #pragma endregion
 
+// #pragma region Tracelog
+// ==========================================
+
+typedef enum
+{
+    // Loads, including FPU loads.
+    core_tl_class_load = 1 << 0,
+    // Stores, including FPU stores.
+    core_tl_class_store = 1 << 1,
+    // Conditional branches, including COP1 branches.
+    core_tl_class_branch = 1 << 2,
+    // Jumps, including jumps through registers.
+    core_tl_class_jump = 1 << 3,
+    // Integer arithmetic, logic, shifts and moves.
+    core_tl_class_alu = 1 << 4,
+    // Moves to and from COP0.
+    core_tl_class_cop0 = 1 << 5,
+    // FPU arithmetic, conversions, compares and moves to and from COP1.
+    core_tl_class_fpu = 1 << 6,
+    // Everything else, e.g. traps, syscalls, cache and TLB operations.
+    core_tl_class_other = 1 << 7,
+    // All of the above.
+    core_tl_class_all = (1 << 8) - 1,
+} core_tl_class;
+
+typedef struct
+{
+    // The range's first address.
+    uint32_t first;
+    // The range's last address, inclusive.
+    uint32_t last;
+} core_tl_range;
+
+/**
+ * \brief Restricts which instructions are trace logged.
+ */
+struct core_tl_filter
+{
+    // The address ranges of the logged instructions. Empty to log instructions at any address.
+    std::vector<core_tl_range> pc_ranges{};
+
+    // The logged instructions, as a combination of core_tl_class flags.
+    uint32_t classes = core_tl_class_all;
+
+    // The VIs instructions are logged in, counted from the start of the trace.
+    uint32_t first_vi = 0;
+    uint32_t last_vi = UINT32_MAX;
+
+    // The address ranges stores must write to in order to be logged. When not empty, only stores are logged.
+    std::vector<core_tl_range> write_ranges{};
+};
+
+#pragma endregion
+
 // #pragma region Cheats
 // ==========================================
 
@@ -766,9 +907,24 @@ typedef enum
     // A save operation
     core_st_job_save,
     // A load operation
-    core_st_job_load
+    core_st_job_load,
+    // A save operation which only rewrites the parts of the previous incremental savestate that changed since it was
+    // generated. Produces the same buffer as a regular save.
+    core_st_job_save_incremental,
 } core_st_job;
 
+typedef enum
+{
+    // The savestate is stored uncompressed.
+    core_st_codec_store,
+    // LZ4, which is the fastest to compress and decompress but produces the largest files.
+    core_st_codec_lz4,
+    // zstd, which balances speed and size.
+    core_st_codec_zstd,
+    // gzip, which is the slowest but compatible with older versions.
+    core_st_codec_gzip,
+} core_st_codec;
+
 typedef enum
 {
     // The target medium is a file with a path.
@@ -777,6 +933,26 @@ typedef enum
     core_st_medium_memory,
 } core_st_medium;
 
+typedef enum
+{
+    // RDRAM.
+    core_st_hash_rdram = 1 << 0,
+    // The CPU's general-purpose registers, hi, lo, llbit and the program counter.
+    core_st_hash_cpu = 1 << 1,
+    // The COP0 registers and the TLB entries.
+    core_st_hash_cop0 = 1 << 2,
+    // The COP1 registers and control registers.
+    core_st_hash_cop1 = 1 << 3,
+    // The RSP's DMEM and IMEM.
+    core_st_hash_rsp = 1 << 4,
+    // The memory-mapped registers and PIF RAM.
+    core_st_hash_mmio = 1 << 5,
+    // The interrupt event queue.
+    core_st_hash_events = 1 << 6,
+    // All of the above.
+    core_st_hash_all = (1 << 7) - 1,
+} core_st_hash_region;
+
 struct core_st_job_params
 {
     /// The path to the savestate file.
@@ -9,6 +9,7 @@
 #include "flashram.h"
 #include "memory.h"
 #include "pif.h"
+#include "savedata.h"
 #include "savestates.h"
 #include "summercart.h"
 #include <Core.h>
@@ -19,6 +20,107 @@
 #include <r4300/r4300.h>
 #include <r4300/rom.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DMA_SSE2
+#endif
+
+/**
+ * Builds words from a source whose big-endian byte stream is shifted by the specified amount of bytes relative to the
+ * destination words. Each destination word takes the low bytes of one source word and the high bytes of the next one.
+ */
+static void copy_words_shifted(uint32_t *dst, const uint32_t *src, const uint32_t count, const uint32_t shift)
+{
+    const uint32_t lshift = shift * 8;
+    const uint32_t rshift = 32 - lshift;
+    uint32_t i = 0;
+
+#if defined(__AVX2__)
+    const __m128i lcount = _mm_cvtsi32_si128(lshift);
+    const __m128i rcount = _mm_cvtsi32_si128(rshift);
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i lo = _mm256_loadu_si256((const __m256i *)(src + i));
+        const __m256i hi = _mm256_loadu_si256((const __m256i *)(src + i + 1));
+        const __m256i word = _mm256_or_si256(_mm256_sll_epi32(lo, lcount), _mm256_srl_epi32(hi, rcount));
+        _mm256_storeu_si256((__m256i *)(dst + i), word);
+    }
+#elif defined(DMA_SSE2)
+    const __m128i lcount = _mm_cvtsi32_si128(lshift);
+    const __m128i rcount = _mm_cvtsi32_si128(rshift);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i lo = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i hi = _mm_loadu_si128((const __m128i *)(src + i + 1));
+        const __m128i word = _mm_or_si128(_mm_sll_epi32(lo, lcount), _mm_srl_epi32(hi, rcount));
+        _mm_storeu_si128((__m128i *)(dst + i), word);
+    }
+#endif
+
+    for (; i < count; i++) dst[i] = (src[i] << lshift) | (src[i + 1] >> rshift);
+}
+
+void dma_copy_swizzled(uint8_t *dst, uint32_t dst_off, const uint8_t *src, uint32_t src_off, uint32_t len)
+{
+    // Bytes up to the next destination word boundary
+    for (; len && (dst_off & 3); len--) dst[(dst_off++) ^ S8] = src[(src_off++) ^ S8];
+
+    // Since both buffers store words the same way, whole destination words can be built from source words directly.
+    // A shifted copy reads the source word after the last one it uses bytes from, which can lie past the end of the
+    // source, e.g. of a PI DMA ending at the end of the ROM. It builds one word less, which the tail then copies.
+    const uint32_t shift = src_off & 3;
+    uint32_t words = len / 4;
+    if (shift != 0 && words != 0) words--;
+    if (shift == 0)
+        memcpy(dst + dst_off, src + src_off, words * 4);
+    else
+        copy_words_shifted((uint32_t *)(dst + dst_off), (const uint32_t *)(src + src_off - shift), words, shift);
+    dst_off += words * 4;
+    src_off += words * 4;
+    len -= words * 4;
+
+    for (; len; len--) dst[(dst_off++) ^ S8] = src[(src_off++) ^ S8];
+}
+
+void dma_fill_swizzled(uint8_t *dst, uint32_t dst_off, const uint8_t value, uint32_t len)
+{
+    for (; len && (dst_off & 3); len--) dst[(dst_off++) ^ S8] = value;
+
+    const uint32_t words = len / 4;
+    memset(dst + dst_off, value, words * 4);
+    dst_off += words * 4;
+    len -= words * 4;
+
+    for (; len; len--) dst[(dst_off++) ^ S8] = value;
+}
+
+/**
+ * Invalidates the compiled code in a range of a virtual address space mirror of RDRAM. Each touched page is only looked
+ * at once.
+ */
+static void invalidate_code(const uint32_t addr, const uint32_t len)
+{
+    if (len == 0) return;
+
+    for (uint32_t page = addr >> 12; page <= (addr + len - 1) >> 12; page++)
+    {
+        if (invalid_code[page]) continue;
+
+        const uint32_t start = std::max(addr, page << 12) & ~3;
+        const uint32_t end = std::min(addr + len, (page + 1) << 12);
+        for (uint32_t i = start; i < end; i += 4)
+        {
+            if (blocks[page]->block[(i & 0xFFF) / 4].ops != NOTCOMPILED)
+            {
+                invalid_code[page] = 1;
+                break;
+            }
+        }
+    }
+}
+
 static bool validate_dma()
 {
     if (si_register.si_pif_addr_wr64b != 0x1FC007C0)
@@ -39,15 +141,13 @@ void dma_pi_read()
     {
         if (use_flashram != 1)
         {
-            fseek(g_sram_file, 0, SEEK_SET);
-            fread(sram, 1, 0x8000, g_sram_file);
+            savedata_read(savedata_sram, sram, 0x8000);
 
             for (i = 0; i < (pi_register.pi_rd_len_reg & 0xFFFFFF) + 1; i++)
                 sram[((pi_register.pi_cart_addr_reg - 0x08000000) + i) ^ S8] =
                     ((unsigned char *)rdram)[(pi_register.pi_dram_addr_reg + i) ^ S8];
 
-            fseek(g_sram_file, 0, SEEK_SET);
-            fwrite(sram, 1, 0x8000, g_sram_file);
+            savedata_write(savedata_sram, sram, 0x8000);
             use_flashram = -1;
         }
         else
@@ -101,12 +201,12 @@ void dma_pi_write()
         {
             if (use_flashram != 1)
             {
-                fseek(g_sram_file, 0, SEEK_SET);
-                fread(sram, 1, 0x8000, g_sram_file);
+                savedata_read(savedata_sram, sram, 0x8000);
 
                 for (i = 0; i < (pi_register.pi_wr_len_reg & 0xFFFFFF) + 1; i++)
                     ((unsigned char *)rdram)[(pi_register.pi_dram_addr_reg + i) ^ S8] =
                         sram[(((pi_register.pi_cart_addr_reg - 0x08000000) & 0xFFFF) + i) ^ S8];
+                rdram_mark_dirty(pi_register.pi_dram_addr_reg, (pi_register.pi_wr_len_reg & 0xFFFFFF) + 1);
                 use_flashram = -1;
             }
             else
@@ -137,6 +237,7 @@ void dma_pi_write()
             if (dram > 0x7FFFFF || cart > 0x1FFF) break;
             ((char *)rdram)[dram ^ S8] = summercart.buffer[cart ^ S8];
         }
+        rdram_mark_dirty(pi_register.pi_dram_addr_reg, longueur);
         pi_register.read_pi_status_reg |= 1;
         update_count();
         add_interrupt_event(PI_INT, longueur / 8);
@@ -164,38 +265,19 @@ void dma_pi_write()
         return;
     }
 
+    if (g_ctx.dbg_get_dma_read_enabled())
+        dma_copy_swizzled(rdramb, pi_register.pi_dram_addr_reg, rom, i, longueur);
+    else
+        dma_fill_swizzled(rdramb, pi_register.pi_dram_addr_reg, 0xFF, longueur);
+
     if (!interpcore)
     {
-        for (i = 0; i < longueur; i++)
-        {
-            uint32_t rdram_address1 = pi_register.pi_dram_addr_reg + i + 0x80000000;
-            uint32_t rdram_address2 = pi_register.pi_dram_addr_reg + i + 0xa0000000;
-
-            ((unsigned char *)rdram)[(pi_register.pi_dram_addr_reg + i) ^ S8] =
-                !g_ctx.dbg_get_dma_read_enabled()
-                    ? 0xFF
-                    : rom[(((pi_register.pi_cart_addr_reg - 0x10000000) & 0x3FFFFFF) + i) ^ S8];
-
-            if (!invalid_code[rdram_address1 >> 12])
-                if (blocks[rdram_address1 >> 12]->block[(rdram_address1 & 0xFFF) / 4].ops != NOTCOMPILED)
-                    invalid_code[rdram_address1 >> 12] = 1;
-
-            if (!invalid_code[rdram_address2 >> 12])
-                if (blocks[rdram_address2 >> 12]->block[(rdram_address2 & 0xFFF) / 4].ops != NOTCOMPILED)
-                    invalid_code[rdram_address2 >> 12] = 1;
-        }
-    }
-    else
-    {
-        for (i = 0; i < longueur; i++)
-        {
-            ((unsigned char *)rdram)[(pi_register.pi_dram_addr_reg + i) ^ S8] =
-                !g_ctx.dbg_get_dma_read_enabled()
-                    ? 0xFF
-                    : rom[(((pi_register.pi_cart_addr_reg - 0x10000000) & 0x3FFFFFF) + i) ^ S8];
-        }
+        invalidate_code(pi_register.pi_dram_addr_reg + 0x80000000, longueur);
+        invalidate_code(pi_register.pi_dram_addr_reg + 0xa0000000, longueur);
     }
 
+    rdram_mark_dirty(pi_register.pi_dram_addr_reg, longueur);
+
     /*for (i=0; i<=((longueur+0x800)>>12); i++)
       invalid_code[(((pi_register.pi_dram_addr_reg&0xFFFFFF)|0x80000000)>>12)+i] = 1;*/
 
@@ -208,9 +290,11 @@ void dma_pi_write()
         case 3:
         case 6:
             rdram[0x318 / 4] = 0x800000;
+            rdram_mark_dirty(0x318, 4);
             break;
         case 5:
             rdram[0x3F0 / 4] = 0x800000;
+            rdram_mark_dirty(0x3F0, 4);
             break;
         }
     }
@@ -223,36 +307,17 @@ void dma_pi_write()
 
 void dma_sp_write()
 {
-    int32_t i;
-    if ((sp_register.sp_mem_addr_reg & 0x1000) > 0)
-    {
-        for (i = 0; i < ((sp_register.sp_rd_len_reg & 0xFFF) + 1); i++)
-            ((unsigned char *)(SP_IMEM))[((sp_register.sp_mem_addr_reg & 0xFFF) + i) ^ S8] =
-                ((unsigned char *)(rdram))[((sp_register.sp_dram_addr_reg & 0xFFFFFF) + i) ^ S8];
-    }
-    else
-    {
-        for (i = 0; i < ((sp_register.sp_rd_len_reg & 0xFFF) + 1); i++)
-            ((unsigned char *)(SP_DMEM))[((sp_register.sp_mem_addr_reg & 0xFFF) + i) ^ S8] =
-                ((unsigned char *)(rdram))[((sp_register.sp_dram_addr_reg & 0xFFFFFF) + i) ^ S8];
-    }
+    uint8_t *mem = (sp_register.sp_mem_addr_reg & 0x1000) > 0 ? (uint8_t *)SP_IMEM : (uint8_t *)SP_DMEM;
+    dma_copy_swizzled(mem, sp_register.sp_mem_addr_reg & 0xFFF, rdramb, sp_register.sp_dram_addr_reg & 0xFFFFFF,
+                      (sp_register.sp_rd_len_reg & 0xFFF) + 1);
 }
 
 void dma_sp_read()
 {
-    int32_t i;
-    if ((sp_register.sp_mem_addr_reg & 0x1000) > 0)
-    {
-        for (i = 0; i < ((sp_register.sp_wr_len_reg & 0xFFF) + 1); i++)
-            ((unsigned char *)(rdram))[((sp_register.sp_dram_addr_reg & 0xFFFFFF) + i) ^ S8] =
-                ((unsigned char *)(SP_IMEM))[((sp_register.sp_mem_addr_reg & 0xFFF) + i) ^ S8];
-    }
-    else
-    {
-        for (i = 0; i < ((sp_register.sp_wr_len_reg & 0xFFF) + 1); i++)
-            ((unsigned char *)(rdram))[((sp_register.sp_dram_addr_reg & 0xFFFFFF) + i) ^ S8] =
-                ((unsigned char *)(SP_DMEM))[((sp_register.sp_mem_addr_reg & 0xFFF) + i) ^ S8];
-    }
+    rdram_mark_dirty(sp_register.sp_dram_addr_reg & 0xFFFFFF, (sp_register.sp_wr_len_reg & 0xFFF) + 1);
+    const uint8_t *mem = (sp_register.sp_mem_addr_reg & 0x1000) > 0 ? (uint8_t *)SP_IMEM : (uint8_t *)SP_DMEM;
+    dma_copy_swizzled(rdramb, sp_register.sp_dram_addr_reg & 0xFFFFFF, mem, sp_register.sp_mem_addr_reg & 0xFFF,
+                      (sp_register.sp_wr_len_reg & 0xFFF) + 1);
 }
 
 void dma_si_write()
@@ -288,6 +353,7 @@ void dma_si_read()
     }
 
     for (int32_t i = 0; i < (64 / 4); i++) rdram[si_register.si_dram_addr / 4 + i] = std::byteswap(PIF_RAM[i]);
+    rdram_mark_dirty(si_register.si_dram_addr, 64);
 
     if (!g_st_skip_dma) // st already did this, see savestates.cpp, we still copy pif ram tho because it has new inputs
     {
@@ -12,3 +12,23 @@ void dma_si_write();
 void dma_si_read();
 void dma_sp_write();
 void dma_sp_read();
+
+/**
+ * \brief Copies bytes between two buffers holding big-endian data stored as native 32-bit words, such as RDRAM, the ROM
+ * and the RSP memories. Equivalent to <c>dst[(dst_off + i) ^ S8] = src[(src_off + i) ^ S8]</c> for every byte.
+ * \param dst The destination buffer.
+ * \param dst_off The byte offset into the destination buffer.
+ * \param src The source buffer. Mustn't overlap the destination range.
+ * \param src_off The byte offset into the source buffer.
+ * \param len The amount of bytes to copy.
+ */
+void dma_copy_swizzled(uint8_t *dst, uint32_t dst_off, const uint8_t *src, uint32_t src_off, uint32_t len);
+
+/**
+ * \brief Fills a range of a buffer holding big-endian data stored as native 32-bit words.
+ * \param dst The destination buffer.
+ * \param dst_off The byte offset into the destination buffer.
+ * \param value The value to fill the range with.
+ * \param len The amount of bytes to fill.
+ */
+void dma_fill_swizzled(uint8_t *dst, uint32_t dst_off, uint8_t value, uint32_t len);
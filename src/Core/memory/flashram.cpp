@@ -6,6 +6,7 @@
 
 #include <CommonPCH.h>
 #include "memory.h"
+#include "savedata.h"
 #include <Core.h>
 #include <r4300/r4300.h>
 
@@ -97,25 +98,23 @@ void flashram_command(uint32_t command)
         {
         case NOPES_MODE:
             break;
+        // Erases and writes have always gone to the SRAM file while DMA reads come from the FlashRAM file. Existing
+        // movies depend on this, so it's kept.
         case ERASE_MODE: {
-            fseek(g_sram_file, 0, SEEK_SET);
-            fread(flashram, 1, 0x20000, g_sram_file);
+            savedata_read(savedata_sram, flashram, 0x20000);
 
             for (int32_t i = erase_offset; i < (erase_offset + 128); i++) flashram[i ^ S8] = 0xff;
 
-            fseek(g_sram_file, 0, SEEK_SET);
-            fwrite(flashram, 1, 0x20000, g_sram_file);
+            savedata_write(savedata_sram, flashram, 0x20000);
         }
         break;
         case WRITE_MODE: {
-            fseek(g_sram_file, 0, SEEK_SET);
-            fread(flashram, 1, 0x20000, g_sram_file);
+            savedata_read(savedata_sram, flashram, 0x20000);
 
             for (int32_t i = 0; i < 128; i++)
                 flashram[(erase_offset + i) ^ S8] = ((unsigned char *)rdram)[(write_pointer + i) ^ S8];
 
-            fseek(g_sram_file, 0, SEEK_SET);
-            fwrite(flashram, 1, 0x20000, g_sram_file);
+            savedata_write(savedata_sram, flashram, 0x20000);
         }
         break;
         case STATUS_MODE:
@@ -148,14 +147,15 @@ void dma_read_flashram()
     case STATUS_MODE:
         rdram[pi_register.pi_dram_addr_reg / 4] = (uint32_t)(status >> 32);
         rdram[pi_register.pi_dram_addr_reg / 4 + 1] = (uint32_t)(status);
+        rdram_mark_dirty(pi_register.pi_dram_addr_reg, 8);
         break;
     case READ_MODE: {
-        fseek(g_fram_file, 0, SEEK_SET);
-        fread(flashram, 1, 0x20000, g_fram_file);
+        savedata_read(savedata_flashram, flashram, 0x20000);
 
         for (i = 0; i < (pi_register.pi_wr_len_reg & 0x0FFFFFF) + 1; i++)
             ((unsigned char *)rdram)[(pi_register.pi_dram_addr_reg + i) ^ S8] =
                 flashram[(((pi_register.pi_cart_addr_reg - 0x08000000) & 0xFFFF) * 2 + i) ^ S8];
+        rdram_mark_dirty(pi_register.pi_dram_addr_reg, (pi_register.pi_wr_len_reg & 0x0FFFFFF) + 1);
         break;
     }
     default:
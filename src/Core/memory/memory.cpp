@@ -11,6 +11,7 @@
 #include "pif.h"
 #include "summercart.h"
 #include <Core.h>
+#include <r4300/debugger.h>
 #include <r4300/interrupt.h>
 #include <r4300/macros.h>
 #include <r4300/ops.h>
@@ -39,6 +40,7 @@ uint8_t flashram[0x20000];
 uint8_t eeprom[0x800];
 uint8_t mempack[4][0x8000];
 uint8_t *rdramb = (uint8_t *)rdram;
+uint8_t rdram_dirty_pages[0x800000 >> 12];
 uint32_t SP_DMEM[0x1000 / 4 * 2];
 uint32_t *SP_IMEM = SP_DMEM + 0x1000 / 4;
 unsigned char *SP_DMEMb = (unsigned char *)(SP_DMEM);
@@ -116,6 +118,7 @@ int32_t init_memory()
 
     // init RDRAM
     for (i = 0; i < (0x800000 / 4); i++) rdram[i] = 0;
+    rdram_mark_all_dirty();
     for (i = 0; i < /*0x40*/ 0x80; i++)
     {
         readmem[(0x8000 + i)] = read_rdram;
@@ -994,6 +997,8 @@ int32_t init_memory()
     fast_memory = 1;
     firstFrameBufferSetting = 1;
 
+    Debugger::on_memory_tables_changed();
+
     g_core->log_info("memory initialized");
     return 0;
 }
@@ -1205,6 +1210,8 @@ void update_SP()
                     }
                 }
             }
+
+            Debugger::on_memory_tables_changed();
         }
         else if (SP_DMEM[0xFC0 / 4] == 2)
         {
@@ -1372,6 +1379,23 @@ void write_nomemd()
     write_dword_in_memory();
 }
 
+bool read_handler(void (*handler)(), const uint32_t addr, uint64_t &value, uint32_t *paddr)
+{
+    address = addr;
+    rdword = &value;
+    handler();
+    if (paddr) *paddr = address;
+    return address != 0;
+}
+
+bool write_handler(void (*handler)(), const uint32_t addr, uint32_t *paddr)
+{
+    address = addr;
+    handler();
+    if (paddr) *paddr = address;
+    return address != 0;
+}
+
 void read_rdram()
 {
     ;
@@ -1474,23 +1498,49 @@ void read_rdramFBd()
     read_rdramd();
 }
 
+void rdram_mark_dirty(const uint32_t addr, const uint32_t len)
+{
+    if (len == 0)
+    {
+        return;
+    }
+    const uint32_t first = (addr & ADDR_MASK) >> 12;
+    const uint32_t last = std::min<uint32_t>(((addr & ADDR_MASK) + len - 1) >> 12, sizeof(rdram_dirty_pages) - 1);
+    memset(rdram_dirty_pages + first, 1, last - first + 1);
+}
+
+void rdram_reset_dirty_pages(uint8_t *dirty)
+{
+    memcpy(dirty, rdram_dirty_pages, sizeof(rdram_dirty_pages));
+    memset(rdram_dirty_pages, 0, sizeof(rdram_dirty_pages));
+}
+
+void rdram_mark_all_dirty()
+{
+    memset(rdram_dirty_pages, 1, sizeof(rdram_dirty_pages));
+}
+
 void write_rdram()
 {
+    rdram_dirty_pages[(address & ADDR_MASK) >> 12] = 1;
     *((uint32_t *)(rdramb + (address & 0xFFFFFF))) = word;
 }
 
 void write_rdramb()
 {
+    rdram_dirty_pages[(address & ADDR_MASK) >> 12] = 1;
     *((rdramb + ((address & 0xFFFFFF) ^ S8))) = g_byte;
 }
 
 void write_rdramh()
 {
+    rdram_dirty_pages[(address & ADDR_MASK) >> 12] = 1;
     *(uint16_t *)((rdramb + ((address & 0xFFFFFF) ^ S16))) = hword;
 }
 
 void write_rdramd()
 {
+    rdram_dirty_pages[(address & ADDR_MASK) >> 12] = 1;
     *((uint32_t *)(rdramb + (address & 0xFFFFFF))) = dword >> 32;
     *((uint32_t *)(rdramb + (address & 0xFFFFFF) + 4)) = dword & 0xFFFFFFFF;
 }
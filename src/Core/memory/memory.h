@@ -13,15 +13,25 @@
 #define Sh16 1
 
 int32_t init_memory();
+
+/**
+ * \brief Marks the RDRAM pages spanned by a write as dirty.
+ * \param addr The physical or virtual address of the write.
+ * \param len The write length in bytes.
+ */
+void rdram_mark_dirty(uint32_t addr, uint32_t len);
+
+/**
+ * \brief Clears the dirty page bitmap.
+ * \param dirty Receives the bitmap as it was before clearing.
+ */
+void rdram_reset_dirty_pages(uint8_t *dirty);
+
+/**
+ * \brief Marks all RDRAM pages dirty, e.g. after RDRAM was overwritten as a whole.
+ */
+void rdram_mark_all_dirty();
 constexpr uint32_t ADDR_MASK = 0x7FFFFF;
-#define read_word_in_memory() readmem[address >> 16]()
-#define read_byte_in_memory() readmemb[address >> 16]()
-#define read_hword_in_memory() readmemh[address >> 16]()
-#define read_dword_in_memory() readmemd[address >> 16]()
-#define write_word_in_memory() writemem[address >> 16]()
-#define write_byte_in_memory() writememb[address >> 16]()
-#define write_hword_in_memory() writememh[address >> 16]()
-#define write_dword_in_memory() writememd[address >> 16]()
 extern uint32_t SP_DMEM[0x1000 / 4 * 2];
 extern unsigned char *SP_DMEMb;
 extern uint32_t *SP_IMEM;
@@ -29,6 +39,14 @@ extern uint32_t PIF_RAM[0x40 / 4];
 extern unsigned char *PIF_RAMb;
 extern uint32_t rdram[0x800000 / 4];
 extern uint8_t *rdramb;
+
+/**
+ * Holds one entry per 4 KiB RDRAM page, which is set when the page is written to by the CPU or by DMA.
+ * Cleared by incremental savestate generation.
+ * \remarks Plugins, the dynarec and the frontend write to RDRAM directly, so a clear entry doesn't guarantee that the
+ * page is unchanged.
+ */
+extern uint8_t rdram_dirty_pages[0x800000 >> 12];
 extern uint8_t sram[0x8000];
 extern uint8_t flashram[0x20000];
 extern uint8_t eeprom[0x800];
@@ -222,6 +240,233 @@ void write_sc_regb();
 void write_sc_regh();
 void write_sc_regd();
 
+// Accesses to plain RDRAM are done inline, skipping the indirect call into the handler tables. The table entry is still
+// compared against the RDRAM handler, so regions hooked for framebuffer emulation keep going through their handlers.
+
+inline void read_word_in_memory()
+{
+    const auto handler = readmem[address >> 16];
+    if (handler == read_rdram)
+    {
+        *rdword = *(uint32_t *)(rdramb + (address & 0xFFFFFF));
+        return;
+    }
+    handler();
+}
+
+inline void read_byte_in_memory()
+{
+    const auto handler = readmemb[address >> 16];
+    if (handler == read_rdramb)
+    {
+        *rdword = *(rdramb + ((address & 0xFFFFFF) ^ S8));
+        return;
+    }
+    handler();
+}
+
+inline void read_hword_in_memory()
+{
+    const auto handler = readmemh[address >> 16];
+    if (handler == read_rdramh)
+    {
+        *rdword = *(uint16_t *)(rdramb + ((address & 0xFFFFFF) ^ S16));
+        return;
+    }
+    handler();
+}
+
+inline void read_dword_in_memory()
+{
+    const auto handler = readmemd[address >> 16];
+    if (handler == read_rdramd)
+    {
+        *rdword = ((uint64_t)(*(uint32_t *)(rdramb + (address & 0xFFFFFF))) << 32) |
+                  ((*(uint32_t *)(rdramb + (address & 0xFFFFFF) + 4)));
+        return;
+    }
+    handler();
+}
+
+inline void write_word_in_memory()
+{
+    const auto handler = writemem[address >> 16];
+    if (handler == write_rdram)
+    {
+        rdram_dirty_pages[(address & ADDR_MASK) >> 12] = 1;
+        *(uint32_t *)(rdramb + (address & 0xFFFFFF)) = word;
+        return;
+    }
+    handler();
+}
+
+inline void write_byte_in_memory()
+{
+    const auto handler = writememb[address >> 16];
+    if (handler == write_rdramb)
+    {
+        rdram_dirty_pages[(address & ADDR_MASK) >> 12] = 1;
+        *(rdramb + ((address & 0xFFFFFF) ^ S8)) = g_byte;
+        return;
+    }
+    handler();
+}
+
+inline void write_hword_in_memory()
+{
+    const auto handler = writememh[address >> 16];
+    if (handler == write_rdramh)
+    {
+        rdram_dirty_pages[(address & ADDR_MASK) >> 12] = 1;
+        *(uint16_t *)(rdramb + ((address & 0xFFFFFF) ^ S16)) = hword;
+        return;
+    }
+    handler();
+}
+
+inline void write_dword_in_memory()
+{
+    const auto handler = writememd[address >> 16];
+    if (handler == write_rdramd)
+    {
+        rdram_dirty_pages[(address & ADDR_MASK) >> 12] = 1;
+        *(uint32_t *)(rdramb + (address & 0xFFFFFF)) = dword >> 32;
+        *(uint32_t *)(rdramb + (address & 0xFFFFFF) + 4) = dword & 0xFFFFFFFF;
+        return;
+    }
+    handler();
+}
+
+/*
+ * Typed accessors for the CPU's address space, used by the interpreters.
+ *
+ * Plain RDRAM is accessed inline. Other regions go through the handler tables, whose handlers still communicate through
+ * the address, word, g_byte, hword, dword and rdword globals. Those globals only remain for the handlers themselves and
+ * for the code generated by the dynarec.
+ *
+ * The accessors return false if the access raised a TLB exception. Reads leave the value untouched if they fail or if
+ * the handler doesn't provide a value. If paddr is provided, it receives the address the access was performed at after
+ * TLB translation, or 0 if the access failed.
+ */
+
+bool read_handler(void (*handler)(), uint32_t addr, uint64_t &value, uint32_t *paddr);
+bool write_handler(void (*handler)(), uint32_t addr, uint32_t *paddr);
+
+inline bool read8(const uint32_t addr, uint8_t &value, uint32_t *paddr = nullptr)
+{
+    const auto handler = readmemb[addr >> 16];
+    if (handler == read_rdramb)
+    {
+        value = *(rdramb + ((addr & 0xFFFFFF) ^ S8));
+        if (paddr) *paddr = addr;
+        return true;
+    }
+    uint64_t v = value;
+    if (!read_handler(handler, addr, v, paddr)) return false;
+    value = (uint8_t)v;
+    return true;
+}
+
+inline bool read16(const uint32_t addr, uint16_t &value, uint32_t *paddr = nullptr)
+{
+    const auto handler = readmemh[addr >> 16];
+    if (handler == read_rdramh)
+    {
+        value = *(uint16_t *)(rdramb + ((addr & 0xFFFFFF) ^ S16));
+        if (paddr) *paddr = addr;
+        return true;
+    }
+    uint64_t v = value;
+    if (!read_handler(handler, addr, v, paddr)) return false;
+    value = (uint16_t)v;
+    return true;
+}
+
+inline bool read32(const uint32_t addr, uint32_t &value, uint32_t *paddr = nullptr)
+{
+    const auto handler = readmem[addr >> 16];
+    if (handler == read_rdram)
+    {
+        value = *(uint32_t *)(rdramb + (addr & 0xFFFFFF));
+        if (paddr) *paddr = addr;
+        return true;
+    }
+    uint64_t v = value;
+    if (!read_handler(handler, addr, v, paddr)) return false;
+    value = (uint32_t)v;
+    return true;
+}
+
+inline bool read64(const uint32_t addr, uint64_t &value, uint32_t *paddr = nullptr)
+{
+    const auto handler = readmemd[addr >> 16];
+    if (handler == read_rdramd)
+    {
+        value = ((uint64_t)(*(uint32_t *)(rdramb + (addr & 0xFFFFFF))) << 32) |
+                ((*(uint32_t *)(rdramb + (addr & 0xFFFFFF) + 4)));
+        if (paddr) *paddr = addr;
+        return true;
+    }
+    return read_handler(handler, addr, value, paddr);
+}
+
+inline bool write8(const uint32_t addr, const uint8_t value, uint32_t *paddr = nullptr)
+{
+    const auto handler = writememb[addr >> 16];
+    if (handler == write_rdramb)
+    {
+        rdram_dirty_pages[(addr & ADDR_MASK) >> 12] = 1;
+        *(rdramb + ((addr & 0xFFFFFF) ^ S8)) = value;
+        if (paddr) *paddr = addr;
+        return true;
+    }
+    g_byte = value;
+    return write_handler(handler, addr, paddr);
+}
+
+inline bool write16(const uint32_t addr, const uint16_t value, uint32_t *paddr = nullptr)
+{
+    const auto handler = writememh[addr >> 16];
+    if (handler == write_rdramh)
+    {
+        rdram_dirty_pages[(addr & ADDR_MASK) >> 12] = 1;
+        *(uint16_t *)(rdramb + ((addr & 0xFFFFFF) ^ S16)) = value;
+        if (paddr) *paddr = addr;
+        return true;
+    }
+    hword = value;
+    return write_handler(handler, addr, paddr);
+}
+
+inline bool write32(const uint32_t addr, const uint32_t value, uint32_t *paddr = nullptr)
+{
+    const auto handler = writemem[addr >> 16];
+    if (handler == write_rdram)
+    {
+        rdram_dirty_pages[(addr & ADDR_MASK) >> 12] = 1;
+        *(uint32_t *)(rdramb + (addr & 0xFFFFFF)) = value;
+        if (paddr) *paddr = addr;
+        return true;
+    }
+    word = value;
+    return write_handler(handler, addr, paddr);
+}
+
+inline bool write64(const uint32_t addr, const uint64_t value, uint32_t *paddr = nullptr)
+{
+    const auto handler = writememd[addr >> 16];
+    if (handler == write_rdramd)
+    {
+        rdram_dirty_pages[(addr & ADDR_MASK) >> 12] = 1;
+        *(uint32_t *)(rdramb + (addr & 0xFFFFFF)) = value >> 32;
+        *(uint32_t *)(rdramb + (addr & 0xFFFFFF) + 4) = value & 0xFFFFFFFF;
+        if (paddr) *paddr = addr;
+        return true;
+    }
+    dword = value;
+    return write_handler(handler, addr, paddr);
+}
+
 void update_SP();
 void update_DPC();
 
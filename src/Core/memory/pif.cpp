@@ -9,6 +9,7 @@
 #include <memory/memory.h>
 #include <memory/pif.h>
 #include <memory/pif_lut.h>
+#include <memory/savedata.h>
 #include <memory/savestates.h>
 #include <cheats.h>
 #include <r4300/r4300.h>
@@ -53,19 +54,15 @@ void EepromCommand(uint8_t *Command)
         break;
     case 4: // read
     {
-        fseek(g_eeprom_file, 0, SEEK_SET);
-        fread(eeprom, 1, 0x800, g_eeprom_file);
+        savedata_read(savedata_eeprom, eeprom, 0x800);
         memcpy(&Command[4], eeprom + Command[3] * 8, 8);
     }
     break;
     case 5: // write
     {
-        fseek(g_eeprom_file, 0, SEEK_SET);
-        fread(eeprom, 1, 0x800, g_eeprom_file);
+        savedata_read(savedata_eeprom, eeprom, 0x800);
         memcpy(eeprom + Command[3] * 8, &Command[4], 8);
-
-        fseek(g_eeprom_file, 0, SEEK_SET);
-        fwrite(eeprom, 1, 0x800, g_eeprom_file);
+        savedata_write(savedata_eeprom, eeprom, 0x800);
     }
     break;
     default:
@@ -195,11 +192,7 @@ void internal_ControllerCommand(int32_t Control, uint8_t *Command)
                     address &= 0xFFE0;
                     if (address <= 0x7FE0)
                     {
-                        fseek(g_mpak_file, 0, SEEK_SET);
-                        fread(mempack[0], 1, 0x8000, g_mpak_file);
-                        fread(mempack[1], 1, 0x8000, g_mpak_file);
-                        fread(mempack[2], 1, 0x8000, g_mpak_file);
-                        fread(mempack[3], 1, 0x8000, g_mpak_file);
+                        savedata_read(savedata_mempak, mempack, sizeof(mempack));
 
                         memcpy(&Command[5], &mempack[Control][address], 0x20);
                     }
@@ -236,19 +229,11 @@ void internal_ControllerCommand(int32_t Control, uint8_t *Command)
                     address &= 0xFFE0;
                     if (address <= 0x7FE0)
                     {
-                        fseek(g_mpak_file, 0, SEEK_SET);
-                        fread(mempack[0], 1, 0x8000, g_mpak_file);
-                        fread(mempack[1], 1, 0x8000, g_mpak_file);
-                        fread(mempack[2], 1, 0x8000, g_mpak_file);
-                        fread(mempack[3], 1, 0x8000, g_mpak_file);
+                        savedata_read(savedata_mempak, mempack, sizeof(mempack));
 
                         memcpy(&mempack[Control][address], &Command[5], 0x20);
 
-                        fseek(g_mpak_file, 0, SEEK_SET);
-                        fwrite(mempack[0], 1, 0x8000, g_mpak_file);
-                        fwrite(mempack[1], 1, 0x8000, g_mpak_file);
-                        fwrite(mempack[2], 1, 0x8000, g_mpak_file);
-                        fwrite(mempack[3], 1, 0x8000, g_mpak_file);
+                        savedata_write(savedata_mempak, mempack, sizeof(mempack));
                     }
                     Command[0x25] = mempack_crc(&Command[5]);
                 }
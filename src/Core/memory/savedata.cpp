@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <Core.h>
+#include <memory/savedata.h>
+#include <r4300/r4300.h>
+
+/// Represents the in-memory contents of a save data file.
+struct t_savedata_image
+{
+    /// The file's path.
+    std::filesystem::path path;
+
+    /// The file's contents.
+    std::vector<uint8_t> data;
+
+    /// Whether the contents were modified since they were last written back.
+    bool dirty;
+
+    /// Whether the last write-back failed, which is only reported to the user once until a write-back succeeds.
+    bool write_failed;
+};
+
+/// Represents a save data file write which is performed off the emulation thread.
+struct t_savedata_write
+{
+    /// The file being written.
+    savedata_file file;
+
+    /// The path to write to.
+    std::filesystem::path path;
+
+    /// The file's contents.
+    std::vector<uint8_t> data;
+};
+
+// The minimum interval between periodic write-backs.
+constexpr auto FLUSH_INTERVAL = std::chrono::seconds(1);
+
+static t_savedata_image g_images[savedata_count];
+
+// The time of the last write-back.
+static std::chrono::steady_clock::time_point g_last_flush;
+
+// The write queue mutex. Locked when accessing the write queue or the write worker state.
+static std::mutex g_write_mutex;
+
+// Signalled whenever a save data write finishes.
+static std::condition_variable g_write_cv;
+
+// The write queue, which contains save data writes in the order they were requested. The front write is the one being
+// processed by the write worker.
+static std::deque<t_savedata_write> g_writes;
+
+// Whether a write worker is currently draining the write queue.
+static bool g_write_worker_running{};
+
+// The results of the writes which finished since they were last collected on the emulation thread.
+static std::vector<std::pair<savedata_file, bool>> g_write_results;
+
+/**
+ * Writes a file by writing a temporary file next to it and moving it over the original one.
+ */
+static bool write_file_atomic(const std::filesystem::path &path, std::vector<uint8_t> &data)
+{
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+
+    if (!IOUtils::write_entire_file(tmp_path, data))
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    return !ec;
+}
+
+/**
+ * Writes the save data files in the write queue to disk until the queue is empty.
+ */
+static void savedata_write_worker()
+{
+    while (true)
+    {
+        t_savedata_write *write;
+        {
+            std::scoped_lock lock(g_write_mutex);
+            if (g_writes.empty())
+            {
+                g_write_worker_running = false;
+                return;
+            }
+            // Elements of a deque aren't moved by pushing to its back.
+            write = &g_writes.front();
+        }
+
+        const bool written = write_file_atomic(write->path, write->data);
+
+        {
+            std::scoped_lock lock(g_write_mutex);
+            g_write_results.emplace_back(write->file, written);
+            g_writes.pop_front();
+        }
+        g_write_cv.notify_all();
+    }
+}
+
+/**
+ * Applies the results of the finished writes. Files whose write failed are marked dirty again, so that the next flush
+ * retries them, and the first failure of a file is reported to the user.
+ * \warning This function must only be called from the emulation thread.
+ */
+static void savedata_collect_write_results()
+{
+    std::vector<std::pair<savedata_file, bool>> results;
+    {
+        std::scoped_lock lock(g_write_mutex);
+        results.swap(g_write_results);
+    }
+
+    for (const auto &[file, written] : results)
+    {
+        auto &image = g_images[file];
+        if (written)
+        {
+            image.write_failed = false;
+            continue;
+        }
+
+        g_core->log_error(std::format("[Core] Failed to write save data to {}", image.path.string()));
+        image.dirty = true;
+        if (!image.write_failed)
+        {
+            image.write_failed = true;
+            const auto message = std::format("Failed to write save data to {}. Retrying...", image.path.string());
+            g_core->show_dialog(message.c_str(), "Core", fsvc_error);
+        }
+    }
+}
+
+/**
+ * Blocks until the write queue is empty.
+ */
+static void savedata_wait_for_writes()
+{
+    std::unique_lock lock(g_write_mutex);
+    g_write_cv.wait(lock, [] { return g_writes.empty(); });
+}
+
+bool savedata_open()
+{
+    const std::filesystem::path paths[savedata_count] = {get_eeprom_path(), get_sram_path(), get_flashram_path(),
+                                                          get_mempak_path()};
+
+    for (int32_t i = 0; i < savedata_count; ++i)
+    {
+        g_core->log_info(std::format("[Core] Loading save data from {}...", paths[i].string()));
+
+        if (!std::filesystem::exists(paths[i]) && !IOUtils::write_entire_file(paths[i], {}))
+        {
+            return false;
+        }
+
+        g_images[i] = t_savedata_image{.path = paths[i], .data = IOUtils::read_entire_file(paths[i])};
+    }
+
+    g_last_flush = std::chrono::steady_clock::now();
+    return true;
+}
+
+void savedata_close()
+{
+    // Failed writes are retried once before giving up, as the images are discarded afterwards.
+    for (int32_t attempt = 0; attempt < 2; ++attempt)
+    {
+        savedata_flush();
+        savedata_wait_for_writes();
+        savedata_collect_write_results();
+    }
+
+    for (auto &image : g_images)
+    {
+        if (image.dirty)
+        {
+            const auto message = std::format("Save data couldn't be written to {} and is lost.", image.path.string());
+            g_core->show_dialog(message.c_str(), "Core", fsvc_error);
+            image.dirty = false;
+        }
+    }
+}
+
+void savedata_read(const savedata_file file, void *buf, const size_t len)
+{
+    const auto &data = g_images[file].data;
+    memcpy(buf, data.data(), std::min(len, data.size()));
+}
+
+void savedata_write(const savedata_file file, const void *buf, const size_t len)
+{
+    auto &image = g_images[file];
+
+    if (image.data.size() < len)
+    {
+        image.data.resize(len);
+        image.dirty = true;
+    }
+
+    // Games often rewrite unchanged data, which doesn't need to reach the disk.
+    if (memcmp(image.data.data(), buf, len) == 0)
+    {
+        return;
+    }
+
+    memcpy(image.data.data(), buf, len);
+    image.dirty = true;
+}
+
+void savedata_flush()
+{
+    savedata_collect_write_results();
+
+    std::scoped_lock lock(g_write_mutex);
+
+    for (int32_t i = 0; i < savedata_count; ++i)
+    {
+        auto &image = g_images[i];
+        if (!image.dirty)
+        {
+            continue;
+        }
+        // A failed write marks the image dirty again, so it isn't lost.
+        image.dirty = false;
+        g_writes.push_back(t_savedata_write{.file = (savedata_file)i, .path = image.path, .data = image.data});
+    }
+
+    g_last_flush = std::chrono::steady_clock::now();
+
+    if (!g_writes.empty() && !g_write_worker_running)
+    {
+        g_write_worker_running = true;
+        g_core->submit_task(savedata_write_worker);
+    }
+}
+
+void savedata_on_vi()
+{
+    savedata_collect_write_results();
+
+    const bool dirty = std::ranges::any_of(g_images, [](const auto &image) { return image.dirty; });
+
+    if (dirty && std::chrono::steady_clock::now() - g_last_flush >= FLUSH_INTERVAL)
+    {
+        savedata_flush();
+    }
+}
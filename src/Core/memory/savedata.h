@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+/*
+ * Save data files (EEPROM, SRAM, FlashRAM and mempaks).
+ *
+ * The files are loaded into memory when the ROM starts and all accesses made by the emulated hardware are served from
+ * those images. Reads and writes behave like the fread and fwrite calls at offset 0 they replace, so the contents seen
+ * by the game are unchanged. Modified images are written back off the emulation thread periodically, when a savestate
+ * is saved to a file and when the ROM closes. Each write goes to a temporary file which then replaces the save file, so
+ * a crash never leaves a partially written save behind. A failed write leaves the image modified, so it's retried by
+ * the next write-back, and is reported to the user.
+ */
+
+/**
+ * \brief A save data file.
+ */
+typedef enum
+{
+    savedata_eeprom,
+    savedata_sram,
+    savedata_flashram,
+    savedata_mempak,
+    savedata_count,
+} savedata_file;
+
+/**
+ * \brief Loads the current ROM's save data files into memory. Missing files are created empty.
+ * \return Whether all files could be opened.
+ */
+bool savedata_open();
+
+/**
+ * \brief Writes back all modified save data files and waits for the writes to complete. Failed writes are retried once
+ * and reported to the user if they fail again.
+ */
+void savedata_close();
+
+/**
+ * \brief Copies the start of a save data file into a buffer.
+ * \param file The save data file.
+ * \param buf The buffer. If the file is shorter than the buffer, the bytes past its end are left untouched.
+ * \param len The amount of bytes to copy.
+ */
+void savedata_read(savedata_file file, void *buf, size_t len);
+
+/**
+ * \brief Overwrites the start of a save data file with a buffer, extending the file if needed.
+ * \param file The save data file.
+ * \param buf The buffer.
+ * \param len The amount of bytes to write.
+ */
+void savedata_write(savedata_file file, const void *buf, size_t len);
+
+/**
+ * \brief Starts writing back all modified save data files.
+ */
+void savedata_flush();
+
+/**
+ * \brief Notifies the save data system about a vertical interrupt. Writes back modified files at most once per second.
+ */
+void savedata_on_vi();
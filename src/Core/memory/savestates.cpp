@@ -7,11 +7,12 @@
 #include <CommonPCH.h>
 #include <Core.h>
 // #include <PlatformService.h>
-#include <libdeflate.h>
 #include <include/core_api.h>
 #include <memory/flashram.h>
 #include <memory/memory.h>
+#include <memory/savedata.h>
 #include <memory/savestates.h>
+#include <memory/st_codec.h>
 #include <memory/summercart.h>
 #include <r4300/interrupt.h>
 #include <r4300/r4300.h>
@@ -20,6 +21,47 @@
 
 constexpr auto RDRAM_DEVICE_MANUF_NEW_FIX_BIT = (1 << 31);
 
+// Offset of the flashram info in the first block, and its size.
+constexpr size_t ST_FLASHRAM_OFFSET = 0x8021F0 - 0x20;
+constexpr size_t ST_FLASHRAM_SIZE = 24;
+
+// Offset of the TLB LUTs in the first block, and the amount of bytes stored for each LUT.
+constexpr size_t ST_TLB_LUT_OFFSET = 0x802208 - 0x20;
+constexpr size_t ST_TLB_LUT_SIZE = 0x100000;
+
+// Identifies a version marker in the flashram info slot.
+constexpr uint32_t ST_VERSION_MAGIC = 0x56545353;
+
+// The flashram offsets in a version marker. They lie far outside of flashram and RDRAM.
+constexpr uint32_t ST_VERSION_MARKER_FLASHRAM_OFFSET = 0x40000000;
+
+// Savestate format versions. Savestates without a version marker are ST_VERSION_LEGACY.
+enum : uint32_t
+{
+    // The TLB LUTs are stored as raw arrays.
+    ST_VERSION_LEGACY = 0,
+    // The TLB LUTs are stored as lists of non-zero entries, and the flashram info follows them.
+    ST_VERSION_SPARSE_TLB = 1,
+};
+
+// The version written by this build. Savestates with a higher version are rejected.
+constexpr uint32_t ST_VERSION = ST_VERSION_SPARSE_TLB;
+
+/**
+ * Takes the place of the flashram info in versioned savestates.
+ * Its flashram offsets are out of range, so versions which predate the marker reject the savestate as invalid
+ * instead of misreading everything past it.
+ */
+struct t_st_version_marker
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t reserved[2];
+    uint32_t erase_offset;
+    uint32_t write_pointer;
+};
+static_assert(sizeof(t_st_version_marker) == ST_FLASHRAM_SIZE);
+
 // st that comes from no delay fix mupen, it has some differences compared to new st:
 // - one frame of input is "embedded", that is the pif ram holds already fetched controller info.
 // - execution continues at exception handler (after input poll) at 0x80000180.
@@ -65,6 +107,43 @@ uint8_t g_first_block[0xA02BB4 - 32]{};
 
 // The undo savestate buffer.
 std::vector<uint8_t> g_undo_savestate;
+
+// The buffer of the last incremental savestate, which the next incremental savestate is generated on top of.
+std::vector<uint8_t> g_incremental_savestate;
+
+/// Represents a savestate file write which is performed off the emulation thread.
+struct t_savestate_write
+{
+    /// The save task which generated the savestate.
+    t_savestate_task task;
+
+    /// The uncompressed savestate buffer.
+    std::vector<uint8_t> st;
+
+    /// The codec to compress the savestate with.
+    core_st_codec codec;
+
+    /// The write's result, which is set by the write worker.
+    core_result result = Res_Ok;
+};
+
+// The write queue mutex. Locked when accessing the write queue or the write worker state.
+std::mutex g_write_mutex;
+
+// Signalled whenever a savestate write finishes.
+std::condition_variable g_write_cv;
+
+// The write queue, which contains savestate writes in the order they were requested. The front write is the one being
+// processed by the write worker.
+std::deque<t_savestate_write> g_writes;
+
+// Whether a write worker is currently draining the write queue.
+bool g_write_worker_running{};
+
+// The writes which have finished since they were last reported to their callbacks on the emulation thread.
+std::vector<t_savestate_write> g_finished_writes;
+
+
 void get_paths_for_task(const t_savestate_task &task, std::filesystem::path &st_path, std::filesystem::path &sd_path)
 {
     sd_path = g_core->get_saves_directory() / (const char *)ROM_HEADER.nom;
@@ -90,12 +169,13 @@ void load_memory_from_buffer(uint8_t *p)
     MiscHelpers::memread(&p, &dpc_register, sizeof(core_dpc_reg));
     MiscHelpers::memread(&p, &dps_register, sizeof(core_dps_reg));
     MiscHelpers::memread(&p, rdram, 0x800000);
+    rdram_mark_all_dirty();
     MiscHelpers::memread(&p, SP_DMEM, 0x1000);
     MiscHelpers::memread(&p, SP_IMEM, 0x1000);
     MiscHelpers::memread(&p, PIF_RAM, 0x40);
 
     char buf[4 * 32];
-    MiscHelpers::memread(&p, buf, 24);
+    MiscHelpers::memread(&p, buf, ST_FLASHRAM_SIZE);
     load_flashram_infos(buf);
 
     MiscHelpers::memread(&p, tlb_LUT_r, 0x100000);
@@ -129,11 +209,84 @@ void load_memory_from_buffer(uint8_t *p)
     MiscHelpers::memread(&p, &vi_field, 4);
 }
 
-std::vector<uint8_t> generate_savestate()
+/**
+ * \brief Copies RDRAM into a savestate buffer, skipping pages which are already up to date.
+ * \param dst The RDRAM section of the savestate buffer, holding RDRAM as it was when the dirty pages were last cleared.
+ */
+static void write_rdram_incremental(uint8_t *dst)
+{
+    // The bitmap is reset before copying, so writes which happen in between mark their page dirty again.
+    uint8_t dirty[sizeof(rdram_dirty_pages)];
+    rdram_reset_dirty_pages(dirty);
+
+    for (size_t page = 0; page < sizeof(dirty); ++page)
+    {
+        const size_t offset = page << 12;
+
+        // Dirty pages are copied without comparing. Clean pages can still have been written to by plugins, the dynarec
+        // or the frontend, so they're compared instead of skipped.
+        if (dirty[page] || memcmp(dst + offset, rdramb + offset, 0x1000))
+        {
+            memcpy(dst + offset, rdramb + offset, 0x1000);
+        }
+    }
+}
+
+/**
+ * \brief Reads a sparse TLB LUT section.
+ * \param ptr The read pointer, which is advanced past the section.
+ * \param end The end of the savestate buffer.
+ * \param lut The LUT to fill. Must hold <c>ST_TLB_LUT_SIZE</c> bytes.
+ * \return Whether the section was valid.
+ */
+static bool read_tlb_lut_sparse(uint8_t **ptr, const uint8_t *end, uint32_t *lut)
 {
-    std::vector<uint8_t> b;
+    memset(lut, 0, ST_TLB_LUT_SIZE);
+
+    uint32_t count;
+    if (end - *ptr < (ptrdiff_t)sizeof(count))
+    {
+        return false;
+    }
+    MiscHelpers::memread(ptr, &count, sizeof(count));
 
-    b.reserve(0xB624F0);
+    if (count > ST_TLB_LUT_SIZE / sizeof(uint32_t) || end - *ptr < (ptrdiff_t)(count * 2 * sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t index;
+        uint32_t value;
+        MiscHelpers::memread(ptr, &index, sizeof(index));
+        MiscHelpers::memread(ptr, &value, sizeof(value));
+        if (index >= ST_TLB_LUT_SIZE / sizeof(uint32_t))
+        {
+            return false;
+        }
+        lut[index] = value;
+    }
+    return true;
+}
+
+void generate_savestate(std::vector<uint8_t> &b, const bool incremental)
+{
+    size_t pos = 0;
+    const auto write = [&](const void *data, const size_t len) {
+        if (pos + len > b.size())
+        {
+            b.resize(pos + len);
+        }
+        memcpy(b.data() + pos, data, len);
+        pos += len;
+    };
+
+    if (!incremental)
+    {
+        b.clear();
+        b.reserve(0xB624F0);
+    }
 
     memset(g_flashram_buf, 0, sizeof(g_flashram_buf));
     memset(g_event_queue_buf, 0, sizeof(g_event_queue_buf));
@@ -148,6 +301,7 @@ std::vector<uint8_t> generate_savestate()
     {
         g_core->log_warn("[ST] Finishing up DMA...");
         for (size_t i = 0; i < 64 / 4; i++) rdram[si_register.si_dram_addr / 4 + i] = std::byteswap(PIF_RAM[i]);
+        rdram_mark_dirty(si_register.si_dram_addr, 64);
         update_count();
         add_interrupt_event(SI_INT, 0x900);
         g_st_skip_dma = true;
@@ -158,52 +312,90 @@ std::vector<uint8_t> generate_savestate()
     save_flashram_infos(g_flashram_buf);
     const int32_t event_queue_len = save_eventqueue_infos(g_event_queue_buf);
 
-    MiscHelpers::vecwrite(b, rom_md5, 32);
-    MiscHelpers::vecwrite(b, &rdram_register, sizeof(core_rdram_reg));
-    MiscHelpers::vecwrite(b, &MI_register, sizeof(core_mips_reg));
-    MiscHelpers::vecwrite(b, &pi_register, sizeof(core_pi_reg));
-    MiscHelpers::vecwrite(b, &sp_register, sizeof(core_sp_reg));
-    MiscHelpers::vecwrite(b, &rsp_register, sizeof(core_rsp_reg));
-    MiscHelpers::vecwrite(b, &si_register, sizeof(core_si_reg));
-    MiscHelpers::vecwrite(b, &vi_register, sizeof(core_vi_reg));
-    MiscHelpers::vecwrite(b, &ri_register, sizeof(core_ri_reg));
-    MiscHelpers::vecwrite(b, &ai_register, sizeof(core_ai_reg));
-    MiscHelpers::vecwrite(b, &dpc_register, sizeof(core_dpc_reg));
-    MiscHelpers::vecwrite(b, &dps_register, sizeof(core_dps_reg));
-    MiscHelpers::vecwrite(b, rdram, 0x800000);
-    MiscHelpers::vecwrite(b, SP_DMEM, 0x1000);
-    MiscHelpers::vecwrite(b, SP_IMEM, 0x1000);
-    MiscHelpers::vecwrite(b, PIF_RAM, 0x40);
-    MiscHelpers::vecwrite(b, g_flashram_buf, 24);
-    MiscHelpers::vecwrite(b, tlb_LUT_r, 0x100000);
-    MiscHelpers::vecwrite(b, tlb_LUT_w, 0x100000);
-    MiscHelpers::vecwrite(b, &llbit, 4);
-    MiscHelpers::vecwrite(b, reg, 32 * 8);
+    const auto write_tlb_lut_sparse = [&](const uint32_t *lut) {
+        const size_t count_pos = pos;
+        uint32_t count = 0;
+        write(&count, sizeof(count));
+        for (uint32_t i = 0; i < ST_TLB_LUT_SIZE / sizeof(uint32_t); ++i)
+        {
+            if (lut[i])
+            {
+                write(&i, sizeof(i));
+                write(&lut[i], sizeof(lut[i]));
+                ++count;
+            }
+        }
+        memcpy(b.data() + count_pos, &count, sizeof(count));
+    };
+
+    const t_st_version_marker version_marker = {
+        .magic = ST_VERSION_MAGIC,
+        .version = ST_VERSION,
+        .reserved = {},
+        .erase_offset = ST_VERSION_MARKER_FLASHRAM_OFFSET,
+        .write_pointer = ST_VERSION_MARKER_FLASHRAM_OFFSET,
+    };
+
+    write(rom_md5, 32);
+    write(&rdram_register, sizeof(core_rdram_reg));
+    write(&MI_register, sizeof(core_mips_reg));
+    write(&pi_register, sizeof(core_pi_reg));
+    write(&sp_register, sizeof(core_sp_reg));
+    write(&rsp_register, sizeof(core_rsp_reg));
+    write(&si_register, sizeof(core_si_reg));
+    write(&vi_register, sizeof(core_vi_reg));
+    write(&ri_register, sizeof(core_ri_reg));
+    write(&ai_register, sizeof(core_ai_reg));
+    write(&dpc_register, sizeof(core_dpc_reg));
+    write(&dps_register, sizeof(core_dps_reg));
+    if (incremental && b.size() >= pos + 0x800000)
+    {
+        write_rdram_incremental(b.data() + pos);
+        pos += 0x800000;
+    }
+    else
+    {
+        if (incremental)
+        {
+            uint8_t dirty[sizeof(rdram_dirty_pages)];
+            rdram_reset_dirty_pages(dirty);
+        }
+        write(rdram, 0x800000);
+    }
+    write(SP_DMEM, 0x1000);
+    write(SP_IMEM, 0x1000);
+    write(PIF_RAM, 0x40);
+    write(&version_marker, sizeof(version_marker));
+    write_tlb_lut_sparse(tlb_LUT_r);
+    write_tlb_lut_sparse(tlb_LUT_w);
+    write(g_flashram_buf, ST_FLASHRAM_SIZE);
+    write(&llbit, 4);
+    write(reg, 32 * 8);
     for (size_t i = 0; i < 32; i++)
-        MiscHelpers::vecwrite(b, reg_cop0 + i, 8); // *8 for compatibility with old versions purpose
-    MiscHelpers::vecwrite(b, &lo, 8);
-    MiscHelpers::vecwrite(b, &hi, 8);
-    MiscHelpers::vecwrite(b, reg_cop1_fgr_64, 32 * 8);
-    MiscHelpers::vecwrite(b, &FCR0, 4);
-    MiscHelpers::vecwrite(b, &FCR31, 4);
-    MiscHelpers::vecwrite(b, tlb_e, 32 * sizeof(tlb));
+        write(reg_cop0 + i, 8); // *8 for compatibility with old versions purpose
+    write(&lo, 8);
+    write(&hi, 8);
+    write(reg_cop1_fgr_64, 32 * 8);
+    write(&FCR0, 4);
+    write(&FCR31, 4);
+    write(tlb_e, 32 * sizeof(tlb));
     if (!dynacore && interpcore)
-        MiscHelpers::vecwrite(b, &interp_addr, 4);
+        write(&interp_addr, 4);
     else
-        MiscHelpers::vecwrite(b, &PC->addr, 4);
-    MiscHelpers::vecwrite(b, &next_interrupt, 4);
-    MiscHelpers::vecwrite(b, &next_vi, 4);
-    MiscHelpers::vecwrite(b, &vi_field, 4);
-    MiscHelpers::vecwrite(b, g_event_queue_buf, event_queue_len);
-    MiscHelpers::vecwrite(b, &movie_active, sizeof(movie_active));
+        write(&PC->addr, 4);
+    write(&next_interrupt, 4);
+    write(&next_vi, 4);
+    write(&vi_field, 4);
+    write(g_event_queue_buf, event_queue_len);
+    write(&movie_active, sizeof(movie_active));
     if (movie_active)
     {
-        MiscHelpers::vecwrite(b, &freeze.size, sizeof(freeze.size));
-        MiscHelpers::vecwrite(b, &freeze.uid, sizeof(freeze.uid));
-        MiscHelpers::vecwrite(b, &freeze.current_sample, sizeof(freeze.current_sample));
-        MiscHelpers::vecwrite(b, &freeze.current_vi, sizeof(freeze.current_vi));
-        MiscHelpers::vecwrite(b, &freeze.length_samples, sizeof(freeze.length_samples));
-        MiscHelpers::vecwrite(b, freeze.input_buffer.data(), freeze.input_buffer.size() * sizeof(core_buttons));
+        write(&freeze.size, sizeof(freeze.size));
+        write(&freeze.uid, sizeof(freeze.uid));
+        write(&freeze.current_sample, sizeof(freeze.current_sample));
+        write(&freeze.current_vi, sizeof(freeze.current_vi));
+        write(&freeze.length_samples, sizeof(freeze.length_samples));
+        write(freeze.input_buffer.data(), freeze.input_buffer.size() * sizeof(core_buttons));
     }
 
     if (g_core->mge_available() && g_core->cfg->st_screenshot)
@@ -216,51 +408,145 @@ std::vector<uint8_t> generate_savestate()
         void *video = malloc(width * height * 3);
         g_core->copy_video(video);
 
-        MiscHelpers::vecwrite(b, screen_section, sizeof(screen_section));
-        MiscHelpers::vecwrite(b, &width, sizeof(width));
-        MiscHelpers::vecwrite(b, &height, sizeof(height));
-        MiscHelpers::vecwrite(b, video, width * height * 3);
+        write(screen_section, sizeof(screen_section));
+        write(&width, sizeof(width));
+        write(&height, sizeof(height));
+        write(video, width * height * 3);
 
         free(video);
     }
 
-    return b;
+    b.resize(pos);
 }
 
-void savestates_save_immediate_impl(const t_savestate_task &task)
+/**
+ * Compresses and writes the savestates in the write queue to disk until the queue is empty.
+ * Only one worker runs at a time, so the writes complete in the order they were requested.
+ */
+void savestates_write_worker()
 {
-    // TODO: Reimplement timing
+    while (true)
+    {
+        t_savestate_write *write;
+        {
+            std::scoped_lock lock(g_write_mutex);
+            if (g_writes.empty())
+            {
+                g_write_worker_running = false;
+                return;
+            }
+            // Elements of a deque aren't moved by pushing to its back.
+            write = &g_writes.front();
+        }
 
-    const auto st = generate_savestate();
+        auto compressed_buffer = st_codec_compress(write->st, write->codec);
 
-    if (task.medium == core_st_medium_path)
+        // write compressed st to disk
+        const bool written =
+            !compressed_buffer.empty() && IOUtils::write_entire_file(write->task.params.path, compressed_buffer);
+
+        {
+            std::scoped_lock lock(g_write_mutex);
+            write->result = written ? Res_Ok : ST_FileWriteError;
+            g_finished_writes.push_back(std::move(*write));
+            g_writes.pop_front();
+        }
+        g_write_cv.notify_all();
+    }
+}
+
+/**
+ * Reports the savestate writes which finished since the last call to their tasks' callbacks.
+ * \warning This function must only be called from the emulation thread.
+ */
+void savestates_report_finished_writes()
+{
+    std::vector<t_savestate_write> finished_writes;
     {
-        // Always save summercart for some reason
-        std::filesystem::path new_st_path = task.params.path;
-        std::filesystem::path new_sd_path = "";
-        get_paths_for_task(task, new_st_path, new_sd_path);
-        if (g_core->cfg->use_summercart) save_summercart(new_sd_path);
+        std::scoped_lock lock(g_write_mutex);
+        finished_writes.swap(g_finished_writes);
+    }
 
-        // Generate compressed buffer
-        std::vector<uint8_t> compressed_buffer;
-        compressed_buffer.resize(st.size());
+    for (const auto &write : finished_writes)
+    {
+        const auto &task = write.task;
+        if (write.result != Res_Ok)
+        {
+            g_core->log_error(std::format("[ST] Failed to write savestate to {}", task.params.path.string()));
+        }
 
-        const auto compressor = libdeflate_alloc_compressor(6);
-        const size_t final_size = libdeflate_gzip_compress(compressor, st.data(), st.size(), compressed_buffer.data(),
-                                                           compressed_buffer.size());
-        libdeflate_free_compressor(compressor);
-        compressed_buffer.resize(final_size);
+        task.callback(core_st_callback_info{.result = write.result,
+                                            .job = task.job,
+                                            .medium = task.medium,
+                                            .params = task.params},
+                      write.st);
 
-        // write compressed st to disk
-        if (!IOUtils::write_entire_file(new_st_path, compressed_buffer))
+        if (write.result == Res_Ok)
         {
-            task.callback(
-                core_st_callback_info{
-                    .result = ST_FileWriteError, .job = task.job, .medium = task.medium, .params = task.params},
-                st);
-            return;
+            g_core->callbacks.save_state();
         }
     }
+}
+
+/**
+ * Blocks until the write queue holds fewer than the specified amount of writes.
+ */
+void savestates_wait_for_writes(const size_t max_pending)
+{
+    std::unique_lock lock(g_write_mutex);
+    g_write_cv.wait(lock, [=] { return g_writes.size() < max_pending; });
+}
+
+/**
+ * Queues a generated savestate to be compressed and written to the task's path by the write worker. The task's callback
+ * is called from st_do_work once the write has finished.
+ * \warning This function must only be called from the emulation thread.
+ */
+void savestates_enqueue_write(const t_savestate_task &task, const std::vector<uint8_t> &st)
+{
+    // Always save summercart for some reason
+    std::filesystem::path new_st_path = task.params.path;
+    std::filesystem::path new_sd_path = "";
+    get_paths_for_task(task, new_st_path, new_sd_path);
+    if (g_core->cfg->use_summercart) save_summercart(new_sd_path);
+
+    // Bring the save files up to date with the savestate
+    savedata_flush();
+
+    savestates_wait_for_writes(MAX_PENDING_WRITES);
+
+    std::scoped_lock lock(g_write_mutex);
+    g_writes.push_back(t_savestate_write{.task = task, .st = st, .codec = (core_st_codec)g_core->cfg->st_codec});
+    g_writes.back().task.params.path = new_st_path;
+
+    if (!g_write_worker_running)
+    {
+        g_write_worker_running = true;
+        g_core->submit_task(savestates_write_worker);
+    }
+}
+
+void savestates_save_immediate_impl(const t_savestate_task &task)
+{
+    // TODO: Reimplement timing
+
+    std::vector<uint8_t> full_st;
+    if (task.job == core_st_job_save_incremental)
+    {
+        generate_savestate(g_incremental_savestate, true);
+    }
+    else
+    {
+        generate_savestate(full_st, false);
+    }
+    const auto &st = task.job == core_st_job_save_incremental ? g_incremental_savestate : full_st;
+
+    if (task.medium == core_st_medium_path)
+    {
+        // Compression and the disk write are handed off to the write worker, which reports back once they're done.
+        savestates_enqueue_write(task, st);
+        return;
+    }
 
     task.callback(
         core_st_callback_info{.result = Res_Ok, .job = task.job, .medium = task.medium, .params = task.params}, st);
@@ -288,6 +574,8 @@ void savestates_load_immediate_impl(const t_savestate_task &task)
     switch (task.medium)
     {
     case core_st_medium_path:
+        // The savestate might still be waiting to be written
+        savestates_wait_for_writes(1);
         st_buf = IOUtils::read_entire_file(new_st_path);
         break;
     case core_st_medium_memory:
@@ -305,7 +593,7 @@ void savestates_load_immediate_impl(const t_savestate_task &task)
         return;
     }
 
-    std::vector<uint8_t> decompressed_buf = MiscHelpers::auto_decompress(st_buf, 0xB624F0);
+    std::vector<uint8_t> decompressed_buf = st_codec_decompress(st_buf);
     if (decompressed_buf.empty())
     {
         task.callback(
@@ -344,10 +632,49 @@ void savestates_load_immediate_impl(const t_savestate_task &task)
     }
 
     // new version does one bigass gzread for first part of .st (static size)
-    MiscHelpers::memread(&ptr, g_first_block, sizeof(g_first_block));
+    // versioned savestates put a marker where the flashram info used to be, followed by the sparse tlb luts and the
+    // flashram info itself
+    MiscHelpers::memread(&ptr, g_first_block, ST_TLB_LUT_OFFSET);
+
+    t_st_version_marker version_marker;
+    memcpy(&version_marker, &g_first_block[ST_FLASHRAM_OFFSET], sizeof(version_marker));
+    const uint32_t version = version_marker.magic == ST_VERSION_MAGIC ? version_marker.version : ST_VERSION_LEGACY;
+
+    if (version > ST_VERSION)
+    {
+        g_core->log_error(std::format("[ST] Savestate version {} is newer than the supported version {}", version,
+                                      ST_VERSION));
+        task.callback(
+            core_st_callback_info{
+                .result = ST_UnsupportedVersion, .job = task.job, .medium = task.medium, .params = task.params},
+            {});
+        return;
+    }
+
+    if (version >= ST_VERSION_SPARSE_TLB)
+    {
+        const auto end = decompressed_buf.data() + decompressed_buf.size();
+        if (!read_tlb_lut_sparse(&ptr, end, (uint32_t *)&g_first_block[ST_TLB_LUT_OFFSET]) ||
+            !read_tlb_lut_sparse(&ptr, end, (uint32_t *)&g_first_block[ST_TLB_LUT_OFFSET + ST_TLB_LUT_SIZE]) ||
+            end - ptr < (ptrdiff_t)ST_FLASHRAM_SIZE)
+        {
+            task.callback(
+                core_st_callback_info{
+                    .result = ST_InvalidRegisters, .job = task.job, .medium = task.medium, .params = task.params},
+                {});
+            return;
+        }
+        MiscHelpers::memread(&ptr, &g_first_block[ST_FLASHRAM_OFFSET], ST_FLASHRAM_SIZE);
+    }
+    else
+    {
+        MiscHelpers::memread(&ptr, &g_first_block[ST_TLB_LUT_OFFSET], ST_TLB_LUT_SIZE * 2);
+    }
+    MiscHelpers::memread(&ptr, &g_first_block[ST_TLB_LUT_OFFSET + ST_TLB_LUT_SIZE * 2],
+                         sizeof(g_first_block) - ST_TLB_LUT_OFFSET - ST_TLB_LUT_SIZE * 2);
 
     const auto si_reg = (core_si_reg *)&g_first_block[0xDC - 0x20];
-    if (!check_register_validity(si_reg) || !check_flashram_infos(&g_first_block[0x8021F0 - 0x20]))
+    if (!check_register_validity(si_reg) || !check_flashram_infos(&g_first_block[ST_FLASHRAM_OFFSET]))
     {
         task.callback(
             core_st_callback_info{
@@ -561,7 +888,7 @@ void savestates_warn_if_load_after_save()
     bool encountered_load = false;
     for (const auto &task : g_tasks)
     {
-        if (task.job == core_st_job_save && encountered_load)
+        if (task.job != core_st_job_load && encountered_load)
         {
             // tood
             g_core->log_warn("[ST] A savestate save task is scheduled after a load task. This may cause "
@@ -586,7 +913,22 @@ void savestates_log_tasks()
     savestates_warn_if_load_after_save();
     for (const auto &task : g_tasks)
     {
-        std::string job_str = (task.job == core_st_job_save) ? "Save" : "Load";
+        std::string job_str;
+        switch (task.job)
+        {
+        case core_st_job_save:
+            job_str = "Save";
+            break;
+        case core_st_job_load:
+            job_str = "Load";
+            break;
+        case core_st_job_save_incremental:
+            job_str = "Incremental save";
+            break;
+        default:
+            job_str = "Unknown";
+            break;
+        }
         std::string medium_str;
         switch (task.medium)
         {
@@ -654,6 +996,8 @@ void st_do_work()
 {
     std::scoped_lock lock(g_task_mutex);
 
+    savestates_report_finished_writes();
+
     if (g_tasks.empty())
     {
         return;
@@ -666,9 +1010,9 @@ void st_do_work()
 
     for (const auto &task : g_tasks)
     {
-        g_core->log_info(std::format("---------- Savestate {}:", (task.job == core_st_job_save) ? "save" : "load"));
+        g_core->log_info(std::format("---------- Savestate {}:", (task.job != core_st_job_load) ? "save" : "load"));
 
-        if (task.job == core_st_job_save)
+        if (task.job != core_st_job_load)
         {
             savestates_save_immediate_impl(task);
         }
@@ -689,6 +1033,10 @@ void st_on_core_stop()
     std::scoped_lock lock(g_task_mutex);
     g_tasks.clear();
     g_undo_savestate.clear();
+    g_incremental_savestate.clear();
+    rdram_mark_all_dirty();
+    savestates_wait_for_writes(1);
+    savestates_report_finished_writes();
 }
 
 /**
@@ -776,6 +1124,29 @@ bool st_do_memory(const std::vector<uint8_t> &buffer, const core_st_job job, con
     return true;
 }
 
+void st_write_file(const std::filesystem::path &path, const std::vector<uint8_t> &st, const core_st_callback &callback)
+{
+    std::scoped_lock lock(g_task_mutex);
+
+    auto internal_callback_wrapper = [=](const core_st_callback_info &info, const std::vector<uint8_t> &buffer) {
+        g_core->st_pre_callback(info, buffer);
+        if (callback)
+        {
+            callback(info, buffer);
+        }
+    };
+
+    const t_savestate_task task = {
+        .job = core_st_job_save,
+        .medium = core_st_medium_path,
+        .callback = internal_callback_wrapper,
+        .params = {.path = path},
+        .ignore_warnings = true,
+    };
+
+    savestates_enqueue_write(task, st);
+}
+
 void st_get_undo_savestate(std::vector<uint8_t> &buffer)
 {
     std::scoped_lock lock(g_task_mutex);
@@ -11,6 +11,9 @@
 extern bool g_st_skip_dma;
 extern bool g_st_old;
 
+// The maximum amount of pending savestate file writes. Once reached, saving blocks until a write finishes.
+constexpr size_t MAX_PENDING_WRITES = 4;
+
 /**
  * \brief Does the pending savestate work.
  * \warning This function must only be called from the emulation thread. Other callers must use the
@@ -23,8 +26,28 @@ void st_do_work();
  */
 void st_on_core_stop();
 
+/**
+ * \brief Generates a savestate.
+ * \param b The buffer to write the savestate to.
+ * \param incremental Whether <c>b</c> holds the previous incremental savestate, which is then patched in place instead
+ * of being rewritten.
+ * \remarks The savestate stores the TLB LUTs sparsely and is marked with a format version. Versions which predate the
+ * marker can't load it and reject it as having invalid registers.
+ */
+void generate_savestate(std::vector<uint8_t> &b, bool incremental);
+
 bool st_do_file(const std::filesystem::path &path, core_st_job job, const core_st_callback &callback,
                 bool ignore_warnings);
 bool st_do_memory(const std::vector<uint8_t> &buffer, core_st_job job, const core_st_callback &callback,
                   bool ignore_warnings);
+
+/**
+ * \brief Writes an already generated savestate to a file in the background, like a path save does.
+ * \param path The savestate's path.
+ * \param st The uncompressed savestate.
+ * \param callback Called from st_do_work on the emulation thread once the write has finished.
+ * \warning This function must only be called from the emulation thread.
+ */
+void st_write_file(const std::filesystem::path &path, const std::vector<uint8_t> &st, const core_st_callback &callback);
+
 void st_get_undo_savestate(std::vector<uint8_t> &buffer);
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <memory/st_codec.h>
+#include <libdeflate.h>
+#include <lz4.h>
+#include <zstd.h>
+
+// Stored and gzip savestates are written without a header, so they stay loadable by older versions. The gzip trailer
+// already holds the uncompressed size.
+//
+// Header layout for the other codecs:
+//  u32 magic
+//  u8 codec
+//  u8[3] reserved
+//  u64 size of the uncompressed savestate
+//  compressed data
+
+constexpr uint32_t ST_CODEC_MAGIC = 0x4353544D;
+constexpr size_t ST_CODEC_HEADER_SIZE = 16;
+
+// Upper bound for the uncompressed size in the header, which protects against allocating absurd amounts of memory for
+// corrupted savestates.
+constexpr uint64_t ST_CODEC_MAX_SIZE = 0x4000000;
+
+constexpr int32_t ST_CODEC_GZIP_LEVEL = 6;
+constexpr int32_t ST_CODEC_ZSTD_LEVEL = 3;
+
+static void write_header(std::vector<uint8_t> &out, const core_st_codec codec, const uint64_t size)
+{
+    const uint8_t codec_byte = codec;
+    const uint8_t reserved[3]{};
+    MiscHelpers::vecwrite(out, &ST_CODEC_MAGIC, sizeof(ST_CODEC_MAGIC));
+    MiscHelpers::vecwrite(out, &codec_byte, sizeof(codec_byte));
+    MiscHelpers::vecwrite(out, reserved, sizeof(reserved));
+    MiscHelpers::vecwrite(out, &size, sizeof(size));
+}
+
+/**
+ * Decompresses a gzip savestate into a buffer sized from the gzip trailer, falling back to a growing buffer if the
+ * trailer doesn't hold the real size (e.g. multi-member streams).
+ */
+static std::vector<uint8_t> gzip_decompress(const std::vector<uint8_t> &buf)
+{
+    uint32_t size;
+    memcpy(&size, buf.data() + buf.size() - sizeof(size), sizeof(size));
+
+    if (size <= ST_CODEC_MAX_SIZE)
+    {
+        std::vector<uint8_t> out;
+        out.resize(size);
+
+        const auto decompressor = libdeflate_alloc_decompressor();
+        const auto result =
+            libdeflate_gzip_decompress(decompressor, buf.data(), buf.size(), out.data(), out.size(), nullptr);
+        libdeflate_free_decompressor(decompressor);
+
+        if (result == LIBDEFLATE_SUCCESS)
+        {
+            return out;
+        }
+    }
+
+    return MiscHelpers::auto_decompress(buf, 0xB624F0);
+}
+
+std::vector<uint8_t> st_codec_compress(std::span<const uint8_t> st, const core_st_codec codec)
+{
+    std::vector<uint8_t> out;
+    size_t compressed_size = 0;
+
+    switch (codec)
+    {
+    case core_st_codec_store:
+        out.assign(st.begin(), st.end());
+        return out;
+    case core_st_codec_gzip: {
+        const auto compressor = libdeflate_alloc_compressor(ST_CODEC_GZIP_LEVEL);
+        out.resize(libdeflate_gzip_compress_bound(compressor, st.size()));
+        compressed_size = libdeflate_gzip_compress(compressor, st.data(), st.size(), out.data(), out.size());
+        libdeflate_free_compressor(compressor);
+        if (compressed_size == 0)
+        {
+            return {};
+        }
+        out.resize(compressed_size);
+        return out;
+    }
+    default:
+        break;
+    }
+
+    write_header(out, codec, st.size());
+
+    switch (codec)
+    {
+    case core_st_codec_lz4: {
+        if (st.size() > INT32_MAX)
+        {
+            return {};
+        }
+        out.resize(ST_CODEC_HEADER_SIZE + LZ4_compressBound((int)st.size()));
+        compressed_size = LZ4_compress_default((const char *)st.data(), (char *)out.data() + ST_CODEC_HEADER_SIZE,
+                                               (int)st.size(), (int)(out.size() - ST_CODEC_HEADER_SIZE));
+        break;
+    }
+    case core_st_codec_zstd: {
+        out.resize(ST_CODEC_HEADER_SIZE + ZSTD_compressBound(st.size()));
+        compressed_size = ZSTD_compress(out.data() + ST_CODEC_HEADER_SIZE, out.size() - ST_CODEC_HEADER_SIZE,
+                                        st.data(), st.size(), ST_CODEC_ZSTD_LEVEL);
+        if (ZSTD_isError(compressed_size))
+        {
+            return {};
+        }
+        break;
+    }
+    default:
+        return {};
+    }
+
+    if (compressed_size == 0 && !st.empty())
+    {
+        return {};
+    }
+
+    out.resize(ST_CODEC_HEADER_SIZE + compressed_size);
+    return out;
+}
+
+std::vector<uint8_t> st_codec_decompress(const std::vector<uint8_t> &buf)
+{
+    uint32_t magic = 0;
+    if (buf.size() >= ST_CODEC_HEADER_SIZE)
+    {
+        memcpy(&magic, buf.data(), sizeof(magic));
+    }
+
+    if (magic != ST_CODEC_MAGIC)
+    {
+        if (buf.size() >= 18 && buf[0] == 0x1F && buf[1] == 0x8B)
+        {
+            return gzip_decompress(buf);
+        }
+        // Stored savestate
+        return buf;
+    }
+
+    const uint8_t codec = buf[4];
+    uint64_t size;
+    memcpy(&size, buf.data() + 8, sizeof(size));
+    if (size > ST_CODEC_MAX_SIZE)
+    {
+        return {};
+    }
+
+    const auto src = buf.data() + ST_CODEC_HEADER_SIZE;
+    const size_t src_size = buf.size() - ST_CODEC_HEADER_SIZE;
+
+    std::vector<uint8_t> out;
+    out.resize(size);
+
+    switch (codec)
+    {
+    case core_st_codec_lz4: {
+        if (src_size > INT32_MAX)
+        {
+            return {};
+        }
+        const int result = LZ4_decompress_safe((const char *)src, (char *)out.data(), (int)src_size, (int)size);
+        if (result < 0 || (uint64_t)result != size)
+        {
+            return {};
+        }
+        return out;
+    }
+    case core_st_codec_zstd: {
+        const size_t result = ZSTD_decompress(out.data(), out.size(), src, src_size);
+        if (ZSTD_isError(result) || result != size)
+        {
+            return {};
+        }
+        return out;
+    }
+    default:
+        return {};
+    }
+}
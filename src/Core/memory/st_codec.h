@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <include/core_types.h>
+
+/*
+ * Savestate file compression.
+ *
+ * LZ4 and zstd savestates start with a small header holding the codec and the uncompressed size, which lets loading
+ * decompress them in one pass into a preallocated buffer. Stored and gzip savestates keep the headerless format older
+ * versions understand, with gzip's uncompressed size taken from its trailer.
+ */
+
+/**
+ * \brief Compresses a savestate buffer.
+ * \param st The uncompressed savestate buffer.
+ * \param codec The codec to compress with.
+ * \return The compressed buffer, or an empty buffer if compression failed.
+ */
+std::vector<uint8_t> st_codec_compress(std::span<const uint8_t> st, core_st_codec codec);
+
+/**
+ * \brief Decompresses a savestate buffer produced by <c>st_codec_compress</c> with any codec.
+ * \param buf The savestate file contents.
+ * \return The uncompressed savestate buffer, or an empty buffer if decompression failed.
+ */
+std::vector<uint8_t> st_codec_decompress(const std::vector<uint8_t> &buf);
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <memory/st_delta.h>
+
+// Delta layout:
+//  u32 magic
+//  u64 size of the decoded buffer
+//  for every changed page:
+//      u32 page index
+//      runs of (u16 unchanged byte count, u16 changed byte count, changed bytes XORed with the keyframe) which add up
+//      to the page length
+//  u32 terminator (ST_DELTA_END)
+
+constexpr uint32_t ST_DELTA_MAGIC = 0x4C445453;
+constexpr uint32_t ST_DELTA_END = UINT32_MAX;
+
+// Minimum amount of unchanged bytes which end a run of changed bytes. Shorter gaps are cheaper to store inline.
+constexpr size_t ST_DELTA_MIN_GAP = 4;
+
+static uint8_t base_byte_at(std::span<const uint8_t> base, const size_t i)
+{
+    return i < base.size() ? base[i] : 0;
+}
+
+static bool page_equals(std::span<const uint8_t> base, std::span<const uint8_t> st, const size_t start, const size_t len)
+{
+    if (start + len <= base.size())
+    {
+        return memcmp(base.data() + start, st.data() + start, len) == 0;
+    }
+
+    for (size_t i = start; i < start + len; ++i)
+    {
+        if (base_byte_at(base, i) != st[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> st_delta_encode(std::span<const uint8_t> base, std::span<const uint8_t> st)
+{
+    std::vector<uint8_t> out;
+    out.reserve(st.size() / 16);
+
+    const uint64_t raw_size = st.size();
+    MiscHelpers::vecwrite(out, &ST_DELTA_MAGIC, sizeof(ST_DELTA_MAGIC));
+    MiscHelpers::vecwrite(out, &raw_size, sizeof(raw_size));
+
+    const size_t page_count = (st.size() + ST_DELTA_PAGE_SIZE - 1) / ST_DELTA_PAGE_SIZE;
+    for (size_t page = 0; page < page_count; ++page)
+    {
+        const size_t start = page * ST_DELTA_PAGE_SIZE;
+        const size_t len = std::min(ST_DELTA_PAGE_SIZE, st.size() - start);
+
+        if (page_equals(base, st, start, len))
+        {
+            continue;
+        }
+
+        const auto page_index = static_cast<uint32_t>(page);
+        MiscHelpers::vecwrite(out, &page_index, sizeof(page_index));
+
+        size_t i = 0;
+        while (i < len)
+        {
+            const size_t gap_start = i;
+            while (i < len && base_byte_at(base, start + i) == st[start + i]) ++i;
+
+            // A changed run is extended until enough unchanged bytes follow it or the page ends.
+            const size_t literal_start = i;
+            size_t literal_end = i;
+            size_t unchanged = 0;
+            while (i < len)
+            {
+                if (base_byte_at(base, start + i) == st[start + i])
+                {
+                    if (++unchanged == ST_DELTA_MIN_GAP) break;
+                }
+                else
+                {
+                    unchanged = 0;
+                    literal_end = i + 1;
+                }
+                ++i;
+            }
+            i = literal_end;
+
+            const auto gap = static_cast<uint16_t>(literal_start - gap_start);
+            const auto literal = static_cast<uint16_t>(literal_end - literal_start);
+            MiscHelpers::vecwrite(out, &gap, sizeof(gap));
+            MiscHelpers::vecwrite(out, &literal, sizeof(literal));
+
+            const size_t offset = out.size();
+            out.resize(offset + literal);
+            for (size_t j = 0; j < literal; ++j)
+            {
+                out[offset + j] = st[start + literal_start + j] ^ base_byte_at(base, start + literal_start + j);
+            }
+        }
+    }
+
+    MiscHelpers::vecwrite(out, &ST_DELTA_END, sizeof(ST_DELTA_END));
+    return out;
+}
+
+bool st_delta_decode(std::span<const uint8_t> base, std::span<const uint8_t> delta, std::vector<uint8_t> &out)
+{
+    size_t pos = 0;
+    const auto read = [&](void *dest, const size_t len) {
+        if (pos + len > delta.size())
+        {
+            return false;
+        }
+        memcpy(dest, delta.data() + pos, len);
+        pos += len;
+        return true;
+    };
+
+    uint32_t magic = 0;
+    uint64_t raw_size = 0;
+    if (!read(&magic, sizeof(magic)) || magic != ST_DELTA_MAGIC || !read(&raw_size, sizeof(raw_size)))
+    {
+        return false;
+    }
+
+    out.resize(raw_size);
+    const size_t common = std::min<size_t>(raw_size, base.size());
+    if (common != 0)
+    {
+        memcpy(out.data(), base.data(), common);
+    }
+    memset(out.data() + common, 0, raw_size - common);
+
+    while (true)
+    {
+        uint32_t page_index = 0;
+        if (!read(&page_index, sizeof(page_index)))
+        {
+            return false;
+        }
+
+        if (page_index == ST_DELTA_END)
+        {
+            return true;
+        }
+
+        const size_t start = static_cast<size_t>(page_index) * ST_DELTA_PAGE_SIZE;
+        if (start >= raw_size)
+        {
+            return false;
+        }
+        const size_t len = std::min<size_t>(ST_DELTA_PAGE_SIZE, raw_size - start);
+
+        size_t i = 0;
+        while (i < len)
+        {
+            uint16_t gap = 0;
+            uint16_t literal = 0;
+            if (!read(&gap, sizeof(gap)) || !read(&literal, sizeof(literal)))
+            {
+                return false;
+            }
+
+            i += gap;
+            if (i + literal > len || pos + literal > delta.size())
+            {
+                return false;
+            }
+
+            for (size_t j = 0; j < literal; ++j)
+            {
+                out[start + i + j] ^= delta[pos + j];
+            }
+            pos += literal;
+            i += literal;
+        }
+
+        if (i != len)
+        {
+            return false;
+        }
+    }
+}
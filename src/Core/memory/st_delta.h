@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+/*
+ * Page-level delta encoding of savestate buffers against a keyframe.
+ *
+ * The buffers are split into 4 KiB pages. Pages which are identical to the keyframe are omitted, while changed pages
+ * are stored as a run-length encoded XOR against the keyframe page. Consecutive savestates only touch a small part of
+ * RDRAM and the TLB LUTs, so the resulting deltas are a fraction of the raw savestate size.
+ */
+
+constexpr size_t ST_DELTA_PAGE_SIZE = 0x1000;
+
+/**
+ * \brief Encodes a savestate buffer as a delta against a keyframe.
+ * \param base The keyframe buffer. May be smaller or larger than the encoded buffer.
+ * \param st The savestate buffer to encode.
+ * \return The delta buffer.
+ */
+std::vector<uint8_t> st_delta_encode(std::span<const uint8_t> base, std::span<const uint8_t> st);
+
+/**
+ * \brief Decodes a delta buffer produced by <c>st_delta_encode</c> into a savestate buffer.
+ * \param base The keyframe buffer which the delta was encoded against.
+ * \param delta The delta buffer.
+ * \param out The decoded savestate buffer.
+ * \return Whether the delta was valid. If false, <c>out</c> is left in an unspecified state.
+ */
+bool st_delta_decode(std::span<const uint8_t> base, std::span<const uint8_t> delta, std::vector<uint8_t> &out);
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <Core.h>
+#include <memory/memory.h>
+#include <memory/st_hash.h>
+#include <r4300/interrupt.h>
+#include <r4300/r4300.h>
+
+// xxh64::hash recurses once per 32 bytes, so large buffers are hashed in chunks to bound the stack depth.
+constexpr size_t HASH_CHUNK_SIZE = 0x1000;
+
+static uint64_t hash(const void *data, const size_t len, uint64_t seed)
+{
+    const auto p = (const char *)data;
+    for (size_t offset = 0; offset < len; offset += HASH_CHUNK_SIZE)
+    {
+        seed = xxh64::hash(p + offset, std::min(HASH_CHUNK_SIZE, len - offset), seed);
+    }
+    return seed;
+}
+
+uint64_t st_hash(const uint32_t regions)
+{
+    uint64_t h = 0;
+
+    if (regions & core_st_hash_rdram)
+    {
+        h = hash(rdram, sizeof(rdram), h);
+    }
+
+    if (regions & core_st_hash_cpu)
+    {
+        const uint32_t pc = !dynacore && interpcore ? interp_addr : PC ? PC->addr : 0;
+        h = hash(reg, sizeof(reg), h);
+        h = hash(&hi, sizeof(hi), h);
+        h = hash(&lo, sizeof(lo), h);
+        h = hash(&llbit, sizeof(llbit), h);
+        h = hash(&pc, sizeof(pc), h);
+    }
+
+    if (regions & core_st_hash_cop0)
+    {
+        h = hash(reg_cop0, sizeof(reg_cop0), h);
+        h = hash(tlb_e, sizeof(tlb_e), h);
+    }
+
+    if (regions & core_st_hash_cop1)
+    {
+        h = hash(reg_cop1_fgr_64, sizeof(reg_cop1_fgr_64), h);
+        h = hash(&FCR0, sizeof(FCR0), h);
+        h = hash(&FCR31, sizeof(FCR31), h);
+    }
+
+    if (regions & core_st_hash_rsp)
+    {
+        // IMEM directly follows DMEM in the same array.
+        h = hash(SP_DMEM, sizeof(SP_DMEM), h);
+    }
+
+    if (regions & core_st_hash_mmio)
+    {
+        h = hash(&rdram_register, sizeof(rdram_register), h);
+        h = hash(&MI_register, sizeof(MI_register), h);
+        h = hash(&pi_register, sizeof(pi_register), h);
+        h = hash(&sp_register, sizeof(sp_register), h);
+        h = hash(&rsp_register, sizeof(rsp_register), h);
+        h = hash(&si_register, sizeof(si_register), h);
+        h = hash(&vi_register, sizeof(vi_register), h);
+        h = hash(&ri_register, sizeof(ri_register), h);
+        h = hash(&ai_register, sizeof(ai_register), h);
+        h = hash(&dpc_register, sizeof(dpc_register), h);
+        h = hash(&dps_register, sizeof(dps_register), h);
+        h = hash(PIF_RAM, sizeof(PIF_RAM), h);
+    }
+
+    if (regions & core_st_hash_events)
+    {
+        h = hash_event_queue(h);
+        h = hash(&next_interrupt, sizeof(next_interrupt), h);
+        h = hash(&next_vi, sizeof(next_vi), h);
+        h = hash(&vi_field, sizeof(vi_field), h);
+    }
+
+    return h;
+}
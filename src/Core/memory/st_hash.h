@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+/**
+ * \brief Computes a 64-bit hash of the emulator state.
+ * \param regions The state regions to hash, as a combination of <c>core_st_hash_region</c> flags.
+ * \return The hash. Each region is hashed with the previous region's hash as its seed, so the result depends on both
+ * the contents and the selection of regions.
+ * \remarks The hashed state mirrors what savestates contain, minus the VCR and flashram state.
+ * \warning Must be called from the emu thread or while the emulator is paused.
+ */
+uint64_t st_hash(uint32_t regions);
@@ -12,6 +12,7 @@
 #include <r4300/ops.h>
 #include <r4300/r4300.h>
 
+template <bool FLOAT_EXCEPTIONS>
 void ADD_D()
 {
     if (check_cop1_unusable()) return;
@@ -22,6 +23,7 @@ void ADD_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void SUB_D()
 {
     if (check_cop1_unusable()) return;
@@ -32,6 +34,7 @@ void SUB_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void MUL_D()
 {
     if (check_cop1_unusable()) return;
@@ -42,6 +45,7 @@ void MUL_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void DIV_D()
 {
     if (check_cop1_unusable()) return;
@@ -52,6 +56,7 @@ void DIV_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void SQRT_D()
 {
     if (check_cop1_unusable()) return;
@@ -61,6 +66,7 @@ void SQRT_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void ABS_D()
 {
     if (check_cop1_unusable()) return;
@@ -78,6 +84,7 @@ void MOV_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void NEG_D()
 {
     if (check_cop1_unusable()) return;
@@ -87,6 +94,7 @@ void NEG_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void ROUND_L_D()
 {
     if (check_cop1_unusable()) return;
@@ -98,6 +106,7 @@ void ROUND_L_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void TRUNC_L_D()
 {
     if (check_cop1_unusable()) return;
@@ -109,6 +118,7 @@ void TRUNC_L_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void CEIL_L_D()
 {
     if (check_cop1_unusable()) return;
@@ -120,6 +130,7 @@ void CEIL_L_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void FLOOR_L_D()
 {
     if (check_cop1_unusable()) return;
@@ -131,6 +142,7 @@ void FLOOR_L_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void ROUND_W_D()
 {
     if (check_cop1_unusable()) return;
@@ -142,6 +154,7 @@ void ROUND_W_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void TRUNC_W_D()
 {
     if (check_cop1_unusable()) return;
@@ -153,6 +166,7 @@ void TRUNC_W_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void CEIL_W_D()
 {
     if (check_cop1_unusable()) return;
@@ -164,6 +178,7 @@ void CEIL_W_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void FLOOR_W_D()
 {
     if (check_cop1_unusable()) return;
@@ -175,6 +190,7 @@ void FLOOR_W_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void CVT_S_D()
 {
     if (check_cop1_unusable()) return;
@@ -192,6 +208,7 @@ void CVT_S_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void CVT_W_D()
 {
     if (check_cop1_unusable()) return;
@@ -201,6 +218,7 @@ void CVT_W_D()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void CVT_L_D()
 {
     if (check_cop1_unusable()) return;
@@ -394,3 +412,22 @@ void C_NGT_D()
         FCR31 &= ~0x800000;
     PC++;
 }
+
+COP1_INSTANTIATE(ADD_D);
+COP1_INSTANTIATE(SUB_D);
+COP1_INSTANTIATE(MUL_D);
+COP1_INSTANTIATE(DIV_D);
+COP1_INSTANTIATE(SQRT_D);
+COP1_INSTANTIATE(ABS_D);
+COP1_INSTANTIATE(NEG_D);
+COP1_INSTANTIATE(ROUND_L_D);
+COP1_INSTANTIATE(TRUNC_L_D);
+COP1_INSTANTIATE(CEIL_L_D);
+COP1_INSTANTIATE(FLOOR_L_D);
+COP1_INSTANTIATE(ROUND_W_D);
+COP1_INSTANTIATE(TRUNC_W_D);
+COP1_INSTANTIATE(CEIL_W_D);
+COP1_INSTANTIATE(FLOOR_W_D);
+COP1_INSTANTIATE(CVT_S_D);
+COP1_INSTANTIATE(CVT_W_D);
+COP1_INSTANTIATE(CVT_L_D);
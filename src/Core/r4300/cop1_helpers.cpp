@@ -9,10 +9,13 @@
 #include <r4300/r4300.h>
 #include <r4300/exception.h>
 #include <r4300/cop1_helpers.h>
+#include <r4300/recomp.h>
 
 float largest_denormal_float = 1.1754942106924411e-38f;  // (1U << 23) - 1
 double largest_denormal_double = 2.225073858507201e-308; // (1ULL << 52) - 1
 
+bool g_float_exceptions = false;
+
 constexpr auto FLOAT_EXCEPTION_MSG = "A floating point exception has occured in the core. This error is likely "
                                      "unrecoverable.\n\n{} (PC = {:#06x})\n\nHow would you like to proceed?";
 
@@ -50,3 +53,21 @@ void fail_float_convert()
 {
     fail_float("Out-of-range float conversion");
 }
+
+void cop1_sync_float_exception_mode()
+{
+    const bool enabled = g_core->cfg->float_exception_emulation;
+    if (enabled == g_float_exceptions)
+    {
+        return;
+    }
+
+    g_core->log_info(std::format("[COP1] Float exception emulation {}", enabled ? "enabled" : "disabled"));
+    g_float_exceptions = enabled;
+
+    // The cached interpreters and the dynarec bake the handlers into their blocks, so they need to be rebuilt.
+    if (!interpcore)
+    {
+        vr_recompile(UINT32_MAX);
+    }
+}
@@ -11,6 +11,19 @@
 extern float largest_denormal_float;
 extern double largest_denormal_double;
 
+/**
+ * \brief Whether the active COP1 handlers emulate float exceptions.
+ * \remarks Follows <c>core_cfg::float_exception_emulation</c> via <c>cop1_sync_float_exception_mode</c>.
+ */
+extern bool g_float_exceptions;
+
+/**
+ * \brief Switches the COP1 handlers to the specialization matching the float exception emulation setting if it changed
+ * since the last call. Blocks which were compiled with the other specialization are recompiled.
+ * \remarks Called on every VI, so setting changes take effect within a frame.
+ */
+void cop1_sync_float_exception_mode();
+
 void fail_float_input();
 void fail_float_input_arg(double x);
 void fail_float_output();
@@ -18,10 +31,25 @@ void fail_float_convert();
 
 #define LARGEST_DENORMAL(x) (sizeof(x) == 4 ? largest_denormal_float : largest_denormal_double)
 
+/**
+ * Selects the specialization of a COP1 handler matching the active float exception emulation mode.
+ */
+#define COP1_OP(op) (g_float_exceptions ? op<true> : op<false>)
+
+/**
+ * Instantiates both specializations of a COP1 handler.
+ */
+#define COP1_INSTANTIATE(op)                                                                                           \
+    template void op<false>();                                                                                         \
+    template void op<true>()
+
+// The CHECK_ macros must be used in handlers templated on <c>bool FLOAT_EXCEPTIONS</c>, so the checks compile away
+// when float exception emulation is off.
+
 #define CHECK_INPUT(x)                                                                                                 \
     do                                                                                                                 \
     {                                                                                                                  \
-        if (g_core->cfg->float_exception_emulation && !(fabs(x) > LARGEST_DENORMAL(x)) && x != 0)                      \
+        if (FLOAT_EXCEPTIONS && !(fabs(x) > LARGEST_DENORMAL(x)) && x != 0)                                            \
         {                                                                                                              \
             fail_float_input_arg(x);                                                                                   \
             return;                                                                                                    \
@@ -31,7 +59,7 @@ void fail_float_convert();
 #define CHECK_OUTPUT(x)                                                                                                \
     do                                                                                                                 \
     {                                                                                                                  \
-        if (g_core->cfg->float_exception_emulation && !(fabs(x) > LARGEST_DENORMAL(x)))                                \
+        if (FLOAT_EXCEPTIONS && !(fabs(x) > LARGEST_DENORMAL(x)))                                                      \
         {                                                                                                              \
             if (std::isnan(x))                                                                                         \
             {                                                                                                          \
@@ -53,7 +81,7 @@ void fail_float_convert();
 #define CHECK_CONVERT_EXCEPTIONS()                                                                                     \
     do                                                                                                                 \
     {                                                                                                                  \
-        if (g_core->cfg->float_exception_emulation)                                                                    \
+        if (FLOAT_EXCEPTIONS)                                                                                          \
         {                                                                                                              \
             if (fetestexcept(FE_ALL_EXCEPT & (~FE_INEXACT)))                                                           \
             {                                                                                                          \
@@ -66,7 +94,7 @@ void fail_float_convert();
 #define CHECK_CONVERT_EXCEPTIONS()                                                                                     \
     do                                                                                                                 \
     {                                                                                                                  \
-        if (g_core->cfg->float_exception_emulation)                                                                    \
+        if (FLOAT_EXCEPTIONS)                                                                                          \
         {                                                                                                              \
             int16_t x87_status_word = read_x87_status_word();                                                          \
             if (x87_status_word & 1)                                                                                   \
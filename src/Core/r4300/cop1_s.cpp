@@ -11,6 +11,7 @@
 #include <r4300/macros.h>
 #include <r4300/cop1_helpers.h>
 
+template <bool FLOAT_EXCEPTIONS>
 void ADD_S()
 {
     if (check_cop1_unusable()) return;
@@ -21,6 +22,7 @@ void ADD_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void SUB_S()
 {
     if (check_cop1_unusable()) return;
@@ -31,6 +33,7 @@ void SUB_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void MUL_S()
 {
     if (check_cop1_unusable()) return;
@@ -41,6 +44,7 @@ void MUL_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void DIV_S()
 {
     if (check_cop1_unusable()) return;
@@ -51,6 +55,7 @@ void DIV_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void SQRT_S()
 {
     if (check_cop1_unusable()) return;
@@ -60,6 +65,7 @@ void SQRT_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void ABS_S()
 {
     if (check_cop1_unusable()) return;
@@ -77,6 +83,7 @@ void MOV_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void NEG_S()
 {
     if (check_cop1_unusable()) return;
@@ -86,6 +93,7 @@ void NEG_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void ROUND_L_S()
 {
     if (check_cop1_unusable()) return;
@@ -98,6 +106,7 @@ void ROUND_L_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void TRUNC_L_S()
 {
     if (check_cop1_unusable()) return;
@@ -110,6 +119,7 @@ void TRUNC_L_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void CEIL_L_S()
 {
     if (check_cop1_unusable()) return;
@@ -122,6 +132,7 @@ void CEIL_L_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void FLOOR_L_S()
 {
     if (check_cop1_unusable()) return;
@@ -134,6 +145,7 @@ void FLOOR_L_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void ROUND_W_S()
 {
     if (check_cop1_unusable()) return;
@@ -146,6 +158,7 @@ void ROUND_W_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void TRUNC_W_S()
 {
     if (check_cop1_unusable()) return;
@@ -158,6 +171,7 @@ void TRUNC_W_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void CEIL_W_S()
 {
     if (check_cop1_unusable()) return;
@@ -170,6 +184,7 @@ void CEIL_W_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void FLOOR_W_S()
 {
     if (check_cop1_unusable()) return;
@@ -182,6 +197,7 @@ void FLOOR_W_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void CVT_D_S()
 {
     if (check_cop1_unusable()) return;
@@ -190,6 +206,7 @@ void CVT_D_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void CVT_W_S()
 {
     if (check_cop1_unusable()) return;
@@ -200,6 +217,7 @@ void CVT_W_S()
     PC++;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 void CVT_L_S()
 {
     if (check_cop1_unusable()) return;
@@ -398,3 +416,22 @@ void C_NGT_S()
         FCR31 &= ~0x800000;
     PC++;
 }
+
+COP1_INSTANTIATE(ADD_S);
+COP1_INSTANTIATE(SUB_S);
+COP1_INSTANTIATE(MUL_S);
+COP1_INSTANTIATE(DIV_S);
+COP1_INSTANTIATE(SQRT_S);
+COP1_INSTANTIATE(ABS_S);
+COP1_INSTANTIATE(NEG_S);
+COP1_INSTANTIATE(ROUND_L_S);
+COP1_INSTANTIATE(TRUNC_L_S);
+COP1_INSTANTIATE(CEIL_L_S);
+COP1_INSTANTIATE(FLOOR_L_S);
+COP1_INSTANTIATE(ROUND_W_S);
+COP1_INSTANTIATE(TRUNC_W_S);
+COP1_INSTANTIATE(CEIL_W_S);
+COP1_INSTANTIATE(FLOOR_W_S);
+COP1_INSTANTIATE(CVT_D_S);
+COP1_INSTANTIATE(CVT_W_S);
+COP1_INSTANTIATE(CVT_L_S);
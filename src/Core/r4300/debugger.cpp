@@ -5,13 +5,57 @@
  */
 
 #include <CommonPCH.h>
+#include <set>
 #include <r4300/debugger.h>
 #include <Core.h>
+#include <memory/memory.h>
+#include <r4300/r4300.h>
 
 bool g_resumed = true;
 bool g_instruction_advancing = false;
 bool g_dma_read_enabled = true;
 core_dbg_cpu_state g_cpu_state{};
+std::atomic<bool> g_dbg_armed = false;
+
+std::mutex g_breakpoint_mtx;
+std::set<uint32_t> g_breakpoints;
+
+// One bit per 4 KiB page of the address space, set while the page contains a breakpoint. Lets the per-instruction
+// check skip the lock and the set lookup for almost every instruction.
+std::atomic<uint64_t> g_breakpoint_pages[(0x100000000 >> 12) / 64];
+
+/**
+ * \brief A memory handler table and the accesses which go through it.
+ */
+struct t_handler_table
+{
+    void (**table)();
+    uint32_t size;
+    core_dbg_watch_kind kind;
+};
+
+static constexpr t_handler_table HANDLER_TABLES[] = {
+    {readmemb, 1, core_dbg_watch_read},   {readmemh, 2, core_dbg_watch_read},   {readmem, 4, core_dbg_watch_read},
+    {readmemd, 8, core_dbg_watch_read},   {writememb, 1, core_dbg_watch_write}, {writememh, 2, core_dbg_watch_write},
+    {writemem, 4, core_dbg_watch_write},  {writememd, 8, core_dbg_watch_write},
+};
+static constexpr size_t HANDLER_TABLE_COUNT = std::size(HANDLER_TABLES);
+
+// The handler tables have 0xFFFF entries, so the last 64 KiB page of the address space has none.
+static constexpr uint32_t HANDLER_TABLE_PAGES = 0xFFFF;
+
+/**
+ * \brief A 64 KiB page whose handler table entries were swapped for traps.
+ */
+struct t_trapped_page
+{
+    // The handlers the traps forward to, indexed like HANDLER_TABLES. Null for tables which aren't trapped.
+    void (*originals[HANDLER_TABLE_COUNT])();
+};
+
+std::mutex g_watch_mtx;
+std::map<uint32_t, core_dbg_watchpoint> g_watchpoints;
+std::map<uint32_t, t_trapped_page> g_trapped_pages;
 
 DORSPCYCLES g_original_do_rsp_cycles;
 
@@ -20,6 +64,168 @@ static uint32_t dummy_doRspCycles(uint32_t cycles)
     return cycles;
 }
 
+static void update_armed()
+{
+    std::scoped_lock lock(g_breakpoint_mtx);
+    g_dbg_armed = !g_resumed || g_instruction_advancing || !g_breakpoints.empty();
+}
+
+static bool is_breakpoint_page(const uint32_t address)
+{
+    const uint32_t page = address >> 12;
+    return g_breakpoint_pages[page / 64].load(std::memory_order_relaxed) & (1ULL << (page % 64));
+}
+
+/**
+ * \brief Pauses execution with the specified CPU state and waits until it's resumed.
+ */
+static void pause_at(const core_dbg_cpu_state &state)
+{
+    g_cpu_state = state;
+    g_resumed = false;
+    update_armed();
+    g_core->callbacks.debugger_cpu_state_changed(&g_cpu_state);
+    g_core->callbacks.debugger_resumed_changed(g_resumed);
+
+    while (!g_resumed)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+static bool is_watched(const uint32_t addr, const uint32_t size, const core_dbg_watch_kind kind)
+{
+    for (const auto &[_, watchpoint] : g_watchpoints)
+    {
+        if ((watchpoint.kind & kind) && (uint64_t)addr + size > watchpoint.address &&
+            addr < (uint64_t)watchpoint.address + watchpoint.size)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \brief Stands in for a watched page's handler, pausing execution if the access hits a watchpoint.
+ * \tparam T The index of the handler table in HANDLER_TABLES.
+ */
+template <size_t T> static void trap_access()
+{
+    const auto &table = HANDLER_TABLES[T];
+    const uint32_t addr = address;
+
+    void (*original)() = nullptr;
+    bool hit;
+    {
+        std::scoped_lock lock(g_watch_mtx);
+        if (const auto it = g_trapped_pages.find(addr >> 16); it != g_trapped_pages.end())
+        {
+            original = it->second.originals[T];
+        }
+        hit = is_watched(addr, table.size, table.kind);
+    }
+
+    // The page was untrapped in the meantime, so the table holds the original handler again.
+    if (!original)
+    {
+        original = table.table[addr >> 16];
+    }
+
+    if (hit)
+    {
+        // The frontend might access memory through the handlers while we're paused, which clobbers the access globals.
+        const auto saved_rdword = rdword;
+        const auto saved_word = word;
+        const auto saved_hword = hword;
+        const auto saved_byte = g_byte;
+        const auto saved_dword = dword;
+
+        pause_at({
+            .opcode = interpcore ? vr_op : 0,
+            .address = interpcore ? interp_addr : PC->addr,
+            .watch_address = addr,
+            .watch_kind = table.kind,
+        });
+
+        address = addr;
+        rdword = saved_rdword;
+        word = saved_word;
+        hword = saved_hword;
+        g_byte = saved_byte;
+        dword = saved_dword;
+    }
+
+    original();
+}
+
+static constexpr void (*TRAPS[])() = {
+    trap_access<0>, trap_access<1>, trap_access<2>, trap_access<3>,
+    trap_access<4>, trap_access<5>, trap_access<6>, trap_access<7>,
+};
+static_assert(std::size(TRAPS) == HANDLER_TABLE_COUNT);
+
+/**
+ * \brief Swaps the handler table entries of pages with watchpoints for traps, and restores those of pages without.
+ * \remarks Must be called with g_watch_mtx held.
+ */
+static void trap_watched_pages()
+{
+    // The kinds of accesses to trap on each page.
+    std::map<uint32_t, uint32_t> pages;
+    for (const auto &[_, watchpoint] : g_watchpoints)
+    {
+        const uint32_t last_page = ((uint64_t)watchpoint.address + watchpoint.size - 1) >> 16;
+        for (uint32_t page = watchpoint.address >> 16; page <= last_page && page < HANDLER_TABLE_PAGES; ++page)
+        {
+            pages[page] |= watchpoint.kind;
+        }
+    }
+
+    for (auto it = g_trapped_pages.begin(); it != g_trapped_pages.end();)
+    {
+        const uint32_t page = it->first;
+        const auto kinds = pages.contains(page) ? pages.at(page) : 0;
+
+        bool any_trapped = false;
+        for (size_t i = 0; i < HANDLER_TABLE_COUNT; ++i)
+        {
+            auto &original = it->second.originals[i];
+            if (!original)
+            {
+                continue;
+            }
+            if (kinds & HANDLER_TABLES[i].kind)
+            {
+                any_trapped = true;
+                continue;
+            }
+            // The entry might have been rewritten since it was trapped, in which case the original is outdated.
+            if (HANDLER_TABLES[i].table[page] == TRAPS[i])
+            {
+                HANDLER_TABLES[i].table[page] = original;
+            }
+            original = nullptr;
+        }
+
+        it = any_trapped ? std::next(it) : g_trapped_pages.erase(it);
+    }
+
+    for (const auto &[page, kinds] : pages)
+    {
+        auto &trapped = g_trapped_pages[page];
+        for (size_t i = 0; i < HANDLER_TABLE_COUNT; ++i)
+        {
+            auto &entry = HANDLER_TABLES[i].table[page];
+            if ((kinds & HANDLER_TABLES[i].kind) && entry != TRAPS[i])
+            {
+                trapped.originals[i] = entry;
+                entry = TRAPS[i];
+            }
+        }
+    }
+}
+
 bool dbg_get_resumed()
 {
     return g_resumed;
@@ -32,6 +238,7 @@ void dbg_set_is_resumed(bool value)
         g_instruction_advancing = false;
     }
     g_resumed = value;
+    update_armed();
     g_core->callbacks.debugger_resumed_changed(g_resumed);
 }
 
@@ -39,6 +246,7 @@ void dbg_step()
 {
     g_instruction_advancing = true;
     g_resumed = true;
+    update_armed();
 }
 
 bool dbg_get_dma_read_enabled()
@@ -72,6 +280,98 @@ void dbg_set_rsp_enabled(bool value)
         g_core->rsp_do_rsp_cycles = dummy_doRspCycles;
 }
 
+void dbg_add_breakpoint(const uint32_t address)
+{
+    {
+        std::scoped_lock lock(g_breakpoint_mtx);
+        g_breakpoints.insert(address);
+        const uint32_t page = address >> 12;
+        g_breakpoint_pages[page / 64].fetch_or(1ULL << (page % 64), std::memory_order_relaxed);
+    }
+    update_armed();
+}
+
+void dbg_remove_breakpoint(const uint32_t address)
+{
+    {
+        std::scoped_lock lock(g_breakpoint_mtx);
+        g_breakpoints.erase(address);
+
+        // The page bit stays set while other breakpoints share the page.
+        const uint32_t page = address >> 12;
+        const auto it = g_breakpoints.lower_bound(page << 12);
+        if (it == g_breakpoints.end() || *it >> 12 != page)
+        {
+            g_breakpoint_pages[page / 64].fetch_and(~(1ULL << (page % 64)), std::memory_order_relaxed);
+        }
+    }
+    update_armed();
+}
+
+std::vector<uint32_t> dbg_get_breakpoints()
+{
+    std::scoped_lock lock(g_breakpoint_mtx);
+    return {g_breakpoints.begin(), g_breakpoints.end()};
+}
+
+void dbg_add_watchpoint(const core_dbg_watchpoint &watchpoint)
+{
+    if (watchpoint.size == 0 || !(watchpoint.kind & core_dbg_watch_access))
+    {
+        return;
+    }
+    std::scoped_lock lock(g_watch_mtx);
+    g_watchpoints[watchpoint.address] = watchpoint;
+    trap_watched_pages();
+}
+
+void dbg_remove_watchpoint(const uint32_t address)
+{
+    std::scoped_lock lock(g_watch_mtx);
+    if (g_watchpoints.erase(address))
+    {
+        trap_watched_pages();
+    }
+}
+
+std::vector<core_dbg_watchpoint> dbg_get_watchpoints()
+{
+    std::scoped_lock lock(g_watch_mtx);
+    std::vector<core_dbg_watchpoint> watchpoints;
+    for (const auto &[_, watchpoint] : g_watchpoints)
+    {
+        watchpoints.push_back(watchpoint);
+    }
+    return watchpoints;
+}
+
+void Debugger::on_early_cycle(const uint32_t opcode, const uint32_t address)
+{
+    if (!is_breakpoint_page(address))
+    {
+        return;
+    }
+
+    {
+        std::scoped_lock lock(g_breakpoint_mtx);
+        if (!g_breakpoints.contains(address))
+        {
+            return;
+        }
+    }
+
+    pause_at({.opcode = opcode, .address = address});
+}
+
+void Debugger::on_memory_tables_changed()
+{
+    std::scoped_lock lock(g_watch_mtx);
+    if (!g_watchpoints.empty())
+    {
+        trap_watched_pages();
+    }
+}
+
 void Debugger::on_late_cycle(uint32_t opcode, uint32_t address)
 {
     g_cpu_state = {
@@ -83,6 +383,7 @@ void Debugger::on_late_cycle(uint32_t opcode, uint32_t address)
     {
         g_instruction_advancing = false;
         g_resumed = false;
+        update_armed();
         g_core->callbacks.debugger_cpu_state_changed(&g_cpu_state);
         g_core->callbacks.debugger_resumed_changed(g_resumed);
     }
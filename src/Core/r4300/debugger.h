@@ -6,10 +6,33 @@
 
 #pragma once
 
+#include <include/core_types.h>
+
+/**
+ * \brief Whether the debugger needs to see every instruction, which is the case while execution is paused or
+ * stepped, or while breakpoints are set.
+ * \remarks The pure interpreter runs a loop without any debugger hooks while this is false, and switches loops as soon
+ * as it changes.
+ */
+extern std::atomic<bool> g_dbg_armed;
+
 namespace Debugger
 {
 /**
- * \brief Notifies the debugger of a processor cycle ending
+ * \brief Notifies the debugger of a processor cycle starting. Blocks while execution is paused at a breakpoint.
+ * \param opcode The opcode about to be executed
+ * \param address The address of the opcode
+ */
+void on_early_cycle(uint32_t opcode, uint32_t address);
+
+/**
+ * \brief Notifies the debugger of the memory handler tables having been rewritten, so it can trap the watched pages
+ * again.
+ */
+void on_memory_tables_changed();
+
+/**
+ * \brief Notifies the debugger of a processor cycle ending. Blocks while execution is paused.
  * \param opcode The processor's opcode
  * \param address The processor's address
  */
@@ -23,3 +46,9 @@ bool dbg_get_dma_read_enabled();
 void dbg_set_dma_read_enabled(bool value);
 bool dbg_get_rsp_enabled();
 void dbg_set_rsp_enabled(bool value);
+void dbg_add_breakpoint(uint32_t address);
+void dbg_remove_breakpoint(uint32_t address);
+std::vector<uint32_t> dbg_get_breakpoints();
+void dbg_add_watchpoint(const core_dbg_watchpoint &watchpoint);
+void dbg_remove_watchpoint(uint32_t address);
+std::vector<core_dbg_watchpoint> dbg_get_watchpoints();
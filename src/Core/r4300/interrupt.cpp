@@ -16,6 +16,9 @@
 #include <r4300/vcr.h>
 #include <r4300/timers.h>
 #include <memory/pif.h>
+#include <r4300/cop1_helpers.h>
+#include <memory/savedata.h>
+#include <r4300/tracelog.h>
 
 typedef struct _interrupt_queue
 {
@@ -26,83 +29,60 @@ typedef struct _interrupt_queue
 
 static interrupt_queue *q = NULL;
 
-interrupt_queue g_pool[128]{};
-uint8_t g_pool_used[sizeof(g_pool)]{};
-size_t g_known_unused_index = SIZE_MAX;
+/**
+ * The queue's entries. The queue holds at most one event of each type besides CHECK_INT, so this is plenty.
+ */
+static interrupt_queue g_pool[128]{};
+
+/**
+ * Freed entries, linked through their next pointers.
+ */
+static interrupt_queue *g_pool_free = NULL;
+
+/**
+ * The number of entries at the start of the pool which have been handed out at least once since the last clear.
+ */
+static size_t g_pool_top = 0;
 
 /**
  * Allocates an item in the interrupt pool.
  */
-interrupt_queue *pool_alloc()
+static interrupt_queue *pool_alloc()
 {
-    size_t unused_index = SIZE_MAX;
-
-    // OPTIMIZATION: If we know that there is an unused index, use it
-    if (g_known_unused_index != SIZE_MAX)
+    if (g_pool_free != NULL)
     {
-        unused_index = g_known_unused_index;
+        interrupt_queue *item = g_pool_free;
+        g_pool_free = item->next;
+        return item;
     }
-    else
-    {
-        for (int32_t i = 0; i < sizeof(g_pool); ++i)
-        {
-            if (g_pool_used[i] == false)
-            {
-                unused_index = i;
-                break;
-            }
-        }
-        assert(unused_index != SIZE_MAX);
-    }
-
-    g_pool_used[unused_index] = true;
-    g_known_unused_index = SIZE_MAX;
 
-    return &g_pool[unused_index];
+    assert(g_pool_top < std::size(g_pool));
+    return &g_pool[g_pool_top++];
 }
 
 /**
  * Frees an interrupt from the pool, allowing it to be reused.
  */
-void pool_free(const interrupt_queue *ptr)
+static void pool_free(interrupt_queue *ptr)
 {
-    const auto index_in_pool = ptr - (interrupt_queue *)&g_pool;
+    assert(ptr >= g_pool && ptr < g_pool + g_pool_top);
 
-#ifdef _DEBUG
-    size_t index = SIZE_MAX;
-    for (int32_t i = 0; i < sizeof(g_pool); ++i)
-    {
-        if (&g_pool[i] == ptr)
-        {
-            index = i;
-            break;
-        }
-    }
-
-    assert(index != SIZE_MAX);
-    assert(index == index_in_pool);
-#endif
-
-    g_pool_used[index_in_pool] = false;
-    g_known_unused_index = index_in_pool;
+    ptr->next = g_pool_free;
+    g_pool_free = ptr;
 }
 
 /**
  * Clears the pool.
  */
-void pool_clear()
+static void pool_clear()
 {
-    memset(g_pool_used, 0, std::size(g_pool_used));
-    g_known_unused_index = SIZE_MAX;
+    g_pool_free = NULL;
+    g_pool_top = 0;
 }
 
 void clear_queue()
 {
-    while (q != NULL)
-    {
-        interrupt_queue *aux = q->next;
-        q = aux;
-    }
+    q = NULL;
     pool_clear();
 }
 
@@ -380,6 +360,16 @@ int32_t save_eventqueue_infos(char *buf)
     return len + 4;
 }
 
+uint64_t hash_event_queue(uint64_t seed)
+{
+    for (const interrupt_queue *aux = q; aux != NULL; aux = aux->next)
+    {
+        const uint32_t event[2] = {(uint32_t)aux->type, aux->count};
+        seed = xxh64::hash((const char *)event, sizeof(event), seed);
+    }
+    return seed;
+}
+
 void load_eventqueue_infos(char *buf)
 {
     int32_t len = 0;
@@ -497,6 +487,12 @@ void gen_interrupt()
 
         timer_new_vi();
 
+        savedata_on_vi();
+
+        tracelog_on_vi();
+
+        cop1_sync_float_exception_mode();
+
         if (vi_register.vi_v_sync == 0)
             vi_register.vi_delay = 500000;
         else
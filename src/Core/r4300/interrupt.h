@@ -22,6 +22,12 @@ uint32_t get_event(int32_t type);
 int32_t save_eventqueue_infos(char *buf);
 void load_eventqueue_infos(char *buf);
 
+/**
+ * \brief Hashes the types and counts of the queued events in queue order.
+ * \param seed The hash seed.
+ */
+uint64_t hash_event_queue(uint64_t seed);
+
 #define VI_INT 0x001
 #define COMPARE_INT 0x002
 #define CHECK_INT 0x004
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <Core.h>
+#include <r4300/movie_inputs.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+std::shared_ptr<const t_mapped_file> t_mapped_file::open(const std::filesystem::path &path)
+{
+    const auto copy = [&]() -> std::shared_ptr<const t_mapped_file> {
+        auto contents = IOUtils::read_entire_file(path);
+        if (contents.empty())
+        {
+            return nullptr;
+        }
+        return std::shared_ptr<const t_mapped_file>(new t_mapped_file(std::move(contents)));
+    };
+
+#ifdef _WIN32
+    // Other processes may still read the file, but can't write to or delete it while it's mapped. If another handle
+    // already has write access to the file, it's copied instead.
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return GetLastError() == ERROR_SHARING_VIOLATION ? copy() : nullptr;
+    }
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+    {
+        return nullptr;
+    }
+
+    // The view keeps the mapping alive, and with it the file's sharing restrictions.
+    const auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data)
+    {
+        return nullptr;
+    }
+
+    return std::shared_ptr<const t_mapped_file>(new t_mapped_file((const uint8_t *)data, (size_t)size.QuadPart));
+#else
+    // Nothing keeps other processes from truncating the file, which would make reading from a mapping of it raise
+    // SIGBUS.
+    return copy();
+#endif
+}
+
+t_mapped_file::~t_mapped_file()
+{
+    if (!is_mapping())
+    {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#endif
+}
+
+t_movie_inputs t_movie_inputs::map(std::shared_ptr<const t_mapped_file> file, const size_t offset, const size_t count)
+{
+    assert(offset % sizeof(core_buttons) == 0);
+    assert(offset + count * sizeof(core_buttons) <= file->data().size());
+
+    t_movie_inputs inputs;
+    inputs.m_mapped = {reinterpret_cast<const core_buttons *>(file->data().data() + offset), count};
+    inputs.m_file = std::move(file);
+    return inputs;
+}
+
+std::vector<core_buttons> &t_movie_inputs::mut()
+{
+    if (m_file)
+    {
+        m_owned.assign(m_mapped.begin(), m_mapped.end());
+        m_mapped = {};
+        m_file = nullptr;
+    }
+    return m_owned;
+}
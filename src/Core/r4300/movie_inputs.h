@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <core_api.h>
+
+/**
+ * \brief A read-only view of an entire file's contents.
+ *
+ * The file is mapped into memory if it can be protected from modification for as long as the mapping lives, as
+ * truncating or rewriting a mapped file either fails or invalidates the mapping. Otherwise, its contents are copied.
+ */
+class t_mapped_file
+{
+  public:
+    /**
+     * \brief Opens a view of a file.
+     * \param path The file's path.
+     * \return The view, or nullptr if the file couldn't be read or is empty.
+     */
+    static std::shared_ptr<const t_mapped_file> open(const std::filesystem::path &path);
+
+    t_mapped_file(const t_mapped_file &) = delete;
+    t_mapped_file &operator=(const t_mapped_file &) = delete;
+    ~t_mapped_file();
+
+    /**
+     * \brief Gets the file's contents.
+     */
+    std::span<const uint8_t> data() const { return {m_data, m_size}; }
+
+    /**
+     * \brief Gets whether the contents are served from a mapping of the file rather than a copy.
+     */
+    bool is_mapping() const { return m_copy.empty(); }
+
+  private:
+    t_mapped_file(const uint8_t *data, size_t size) : m_data(data), m_size(size) {}
+    t_mapped_file(std::vector<uint8_t> copy) : m_data(copy.data()), m_size(copy.size()), m_copy(std::move(copy)) {}
+
+    const uint8_t *m_data;
+    size_t m_size;
+    std::vector<uint8_t> m_copy;
+};
+
+/**
+ * \brief A movie's input samples.
+ *
+ * Samples loaded from a movie file are served straight from a read-only view of it, which is a mapping where the
+ * platform allows one, so starting playback doesn't require reading the whole file. The samples are only copied into
+ * memory once they are modified, e.g. when a recording is resumed from the movie.
+ */
+class t_movie_inputs
+{
+  public:
+    t_movie_inputs() = default;
+    t_movie_inputs(std::vector<core_buttons> inputs) : m_owned(std::move(inputs)) {}
+    t_movie_inputs(std::initializer_list<core_buttons> inputs) : m_owned(inputs) {}
+
+    /**
+     * \brief Creates a collection which is backed by a movie file's mapping.
+     * \param file The movie file's mapping.
+     * \param offset The offset of the first sample in the file. Must be a multiple of the sample size.
+     * \param count The amount of samples, which must all lie within the file.
+     */
+    static t_movie_inputs map(std::shared_ptr<const t_mapped_file> file, size_t offset, size_t count);
+
+    /**
+     * \brief Gets whether the samples are still backed by a file mapping.
+     */
+    bool is_mapped() const { return m_file != nullptr; }
+
+    size_t size() const { return m_file ? m_mapped.size() : m_owned.size(); }
+    bool empty() const { return size() == 0; }
+    const core_buttons *data() const { return m_file ? m_mapped.data() : m_owned.data(); }
+    const core_buttons *begin() const { return data(); }
+    const core_buttons *end() const { return data() + size(); }
+    const core_buttons &operator[](const size_t i) const { return data()[i]; }
+    const core_buttons &back() const { return data()[size() - 1]; }
+    operator std::span<const core_buttons>() const { return {data(), size()}; }
+
+    /**
+     * \brief Gets the samples for modification, copying them out of the file mapping first if needed.
+     */
+    std::vector<core_buttons> &mut();
+
+    void push_back(const core_buttons input) { mut().push_back(input); }
+    void resize(const size_t count) { mut().resize(count); }
+
+  private:
+    std::shared_ptr<const t_mapped_file> m_file;
+    std::span<const core_buttons> m_mapped;
+    std::vector<core_buttons> m_owned;
+};
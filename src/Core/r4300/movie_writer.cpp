@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <Core.h>
+#include <r4300/movie_writer.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * Flushes a stream and syncs the underlying file to the storage device.
+ */
+static bool sync_file(FILE *f)
+{
+    if (fflush(f) != 0)
+    {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+/**
+ * Writes the header and the inputs starting at the specified sample to an open movie file.
+ */
+static bool write_range(FILE *f, const core_vcr_movie_header &hdr, const std::span<const core_buttons> inputs,
+                        const size_t first_sample, const bool sync)
+{
+    if (fseek(f, 0, SEEK_SET) != 0 || fwrite(&hdr, sizeof(core_vcr_movie_header), 1, f) != 1)
+    {
+        return false;
+    }
+
+    const auto count = inputs.size() - first_sample;
+    if (count != 0)
+    {
+        const auto offset = sizeof(core_vcr_movie_header) + sizeof(core_buttons) * first_sample;
+        if (fseek(f, (long)offset, SEEK_SET) != 0 ||
+            fwrite(inputs.data() + first_sample, sizeof(core_buttons), count, f) != count)
+        {
+            return false;
+        }
+    }
+
+    return sync ? sync_file(f) : fflush(f) == 0;
+}
+
+void movie_writer_reset(t_movie_writer &writer)
+{
+    writer = {};
+}
+
+void movie_writer_invalidate(t_movie_writer &writer, const size_t sample)
+{
+    writer.dirty_from = std::min(writer.dirty_from, sample);
+}
+
+bool movie_write_full(const std::filesystem::path &path, const core_vcr_movie_header &hdr,
+                      const std::span<const core_buttons> inputs, const bool sync)
+{
+    FILE *f = nullptr;
+    if (IOUtils::path_fopen_s(f, path, "wb") != 0)
+    {
+        return false;
+    }
+
+    const bool written = write_range(f, hdr, inputs, 0, sync);
+    return fclose(f) == 0 && written;
+}
+
+bool movie_writer_write(t_movie_writer &writer, const std::filesystem::path &path, const core_vcr_movie_header &hdr,
+                        const std::span<const core_buttons> inputs, const bool sync)
+{
+    const auto expected_size = sizeof(core_vcr_movie_header) + sizeof(core_buttons) * writer.length_samples;
+
+    std::error_code ec;
+    const bool incremental =
+        !writer.path.empty() && writer.path == path && std::filesystem::file_size(path, ec) == expected_size && !ec;
+
+    if (!incremental)
+    {
+        movie_writer_reset(writer);
+
+        if (!movie_write_full(path, hdr, inputs, sync))
+        {
+            return false;
+        }
+
+        writer.path = path;
+        writer.length_samples = inputs.size();
+        return true;
+    }
+
+    const auto first_sample = std::min({writer.dirty_from, writer.length_samples, inputs.size()});
+
+    // Samples which were removed, e.g. by a rerecord, are cut off the end of the file.
+    if (inputs.size() < writer.length_samples)
+    {
+        std::filesystem::resize_file(path, sizeof(core_vcr_movie_header) + sizeof(core_buttons) * inputs.size(), ec);
+        if (ec)
+        {
+            movie_writer_reset(writer);
+            return false;
+        }
+    }
+
+    FILE *f = nullptr;
+    if (IOUtils::path_fopen_s(f, path, "r+b") != 0)
+    {
+        movie_writer_reset(writer);
+        return false;
+    }
+
+    const bool written = write_range(f, hdr, inputs, first_sample, sync);
+    if (fclose(f) != 0 || !written)
+    {
+        movie_writer_reset(writer);
+        return false;
+    }
+
+    writer.length_samples = inputs.size();
+    writer.dirty_from = SIZE_MAX;
+    return true;
+}
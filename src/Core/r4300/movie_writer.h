@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <core_api.h>
+
+/*
+ * Incremental movie file writer.
+ *
+ * Rewriting a whole movie on every flush costs I/O proportional to its length, which adds up for movies with millions
+ * of samples. The writer instead remembers what it last wrote to the file, and on the next write only patches the
+ * header in place, rewrites the samples which were modified since then, appends new samples and truncates removed
+ * ones. The resulting file is identical to a full rewrite.
+ */
+
+/**
+ * \brief Tracks the contents of a movie file written by the writer.
+ */
+struct t_movie_writer
+{
+    /// The file's path. Empty if the next write has to rewrite the whole file.
+    std::filesystem::path path{};
+
+    /// The amount of samples in the file.
+    size_t length_samples{};
+
+    /// The first sample which was modified in memory since the last write. SIZE_MAX if none was.
+    size_t dirty_from = SIZE_MAX;
+};
+
+/**
+ * \brief Makes the next write rewrite the whole file.
+ * \param writer The writer.
+ */
+void movie_writer_reset(t_movie_writer &writer);
+
+/**
+ * \brief Notifies the writer that samples which were previously written have been modified in memory.
+ * \param writer The writer.
+ * \param sample The first modified sample. Samples after it are assumed to be modified too.
+ */
+void movie_writer_invalidate(t_movie_writer &writer, size_t sample);
+
+/**
+ * \brief Brings a movie file up to date with the specified header and inputs.
+ * \param writer The writer. If it last wrote to another path or the file was changed behind its back, the whole file
+ * is rewritten.
+ * \param path The movie file's path.
+ * \param hdr The movie header.
+ * \param inputs The movie inputs.
+ * \param sync Whether to sync the file to the storage device before returning.
+ * \return Whether the write succeeded. If it didn't, the next write rewrites the whole file.
+ */
+bool movie_writer_write(t_movie_writer &writer, const std::filesystem::path &path, const core_vcr_movie_header &hdr,
+                        std::span<const core_buttons> inputs, bool sync);
+
+/**
+ * \brief Writes a whole movie file without involving a writer.
+ * \param path The movie file's path.
+ * \param hdr The movie header.
+ * \param inputs The movie inputs.
+ * \param sync Whether to sync the file to the storage device before returning.
+ * \return Whether the write succeeded.
+ */
+bool movie_write_full(const std::filesystem::path &path, const core_vcr_movie_header &hdr,
+                      std::span<const core_buttons> inputs, bool sync);
@@ -69,12 +69,12 @@ void MULT();
 void LWC1();
 void MTC1();
 void CVT_S_W();
-void DIV_S();
-void MUL_S();
-void ADD_S();
-void CVT_D_S();
-void ADD_D();
-void TRUNC_W_D();
+template <bool FLOAT_EXCEPTIONS> void DIV_S();
+template <bool FLOAT_EXCEPTIONS> void MUL_S();
+template <bool FLOAT_EXCEPTIONS> void ADD_S();
+template <bool FLOAT_EXCEPTIONS> void CVT_D_S();
+template <bool FLOAT_EXCEPTIONS> void ADD_D();
+template <bool FLOAT_EXCEPTIONS> void TRUNC_W_D();
 void MFC1();
 void NOP();
 void RESERVED();
@@ -93,18 +93,18 @@ void LB();
 
 void SWC1();
 void CVT_D_W();
-void MUL_D();
-void DIV_D();
-void CVT_S_D();
+template <bool FLOAT_EXCEPTIONS> void MUL_D();
+template <bool FLOAT_EXCEPTIONS> void DIV_D();
+template <bool FLOAT_EXCEPTIONS> void CVT_S_D();
 void MOV_S();
 void C_LE_S();
 void BC1T();
-void TRUNC_W_S();
+template <bool FLOAT_EXCEPTIONS> void TRUNC_W_S();
 void C_LT_S();
 void BC1FL();
-void NEG_S();
+template <bool FLOAT_EXCEPTIONS> void NEG_S();
 void LDC1();
-void SUB_D();
+template <bool FLOAT_EXCEPTIONS> void SUB_D();
 void C_LE_D();
 void BC1TL();
 void BGEZAL_IDLE();
@@ -114,29 +114,29 @@ void BEQ_IDLE();
 
 void LH();
 void NOR();
-void NEG_D();
+template <bool FLOAT_EXCEPTIONS> void NEG_D();
 void MOV_D();
 void C_LT_D();
 void BC1F();
 
 void SUB();
 
-void CVT_W_S();
+template <bool FLOAT_EXCEPTIONS> void CVT_W_S();
 void DIVU();
 
 void JALR();
 void SDC1();
 void C_EQ_S();
-void SUB_S();
+template <bool FLOAT_EXCEPTIONS> void SUB_S();
 void BLTZL();
 
-void CVT_W_D();
-void SQRT_S();
+template <bool FLOAT_EXCEPTIONS> void CVT_W_D();
+template <bool FLOAT_EXCEPTIONS> void SQRT_S();
 void C_EQ_D();
 void FIN_BLOCK();
 void DDIV();
 void DADDIU();
-void ABS_S();
+template <bool FLOAT_EXCEPTIONS> void ABS_S();
 void BGTZL();
 void DSRAV();
 void DSLLV();
@@ -171,14 +171,14 @@ void BC1F_IDLE();
 void BC1T_IDLE();
 void BC1FL_IDLE();
 void BC1TL_IDLE();
-void ROUND_L_S();
-void TRUNC_L_S();
-void CEIL_L_S();
-void FLOOR_L_S();
-void ROUND_W_S();
-void CEIL_W_S();
-void FLOOR_W_S();
-void CVT_L_S();
+template <bool FLOAT_EXCEPTIONS> void ROUND_L_S();
+template <bool FLOAT_EXCEPTIONS> void TRUNC_L_S();
+template <bool FLOAT_EXCEPTIONS> void CEIL_L_S();
+template <bool FLOAT_EXCEPTIONS> void FLOOR_L_S();
+template <bool FLOAT_EXCEPTIONS> void ROUND_W_S();
+template <bool FLOAT_EXCEPTIONS> void CEIL_W_S();
+template <bool FLOAT_EXCEPTIONS> void FLOOR_W_S();
+template <bool FLOAT_EXCEPTIONS> void CVT_L_S();
 void C_F_S();
 void C_UN_S();
 void C_UEQ_S();
@@ -192,16 +192,16 @@ void C_SEQ_S();
 void C_NGL_S();
 void C_NGE_S();
 void C_NGT_S();
-void SQRT_D();
-void ABS_D();
-void ROUND_L_D();
-void TRUNC_L_D();
-void CEIL_L_D();
-void FLOOR_L_D();
-void ROUND_W_D();
-void CEIL_W_D();
-void FLOOR_W_D();
-void CVT_L_D();
+template <bool FLOAT_EXCEPTIONS> void SQRT_D();
+template <bool FLOAT_EXCEPTIONS> void ABS_D();
+template <bool FLOAT_EXCEPTIONS> void ROUND_L_D();
+template <bool FLOAT_EXCEPTIONS> void TRUNC_L_D();
+template <bool FLOAT_EXCEPTIONS> void CEIL_L_D();
+template <bool FLOAT_EXCEPTIONS> void FLOOR_L_D();
+template <bool FLOAT_EXCEPTIONS> void ROUND_W_D();
+template <bool FLOAT_EXCEPTIONS> void CEIL_W_D();
+template <bool FLOAT_EXCEPTIONS> void FLOOR_W_D();
+template <bool FLOAT_EXCEPTIONS> void CVT_L_D();
 void C_F_D();
 void C_UN_D();
 void C_UEQ_D();
@@ -1203,6 +1203,7 @@ static void BC1TL()
 
 static void (*interp_cop1_bc[4])(void) = {BC1F, BC1T, BC1FL, BC1TL};
 
+template <bool FLOAT_EXCEPTIONS>
 static void ADD_S()
 {
     set_rounding();
@@ -1213,6 +1214,7 @@ static void ADD_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void SUB_S()
 {
     set_rounding();
@@ -1223,6 +1225,7 @@ static void SUB_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void MUL_S()
 {
     set_rounding();
@@ -1233,6 +1236,7 @@ static void MUL_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void DIV_S()
 {
     if ((FCR31 & 0x400) && *reg_cop1_simple[core_cfft] == 0)
@@ -1247,6 +1251,7 @@ static void DIV_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void SQRT_S()
 {
     set_rounding();
@@ -1256,6 +1261,7 @@ static void SQRT_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void ABS_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1269,6 +1275,7 @@ static void MOV_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void NEG_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1276,6 +1283,7 @@ static void NEG_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void ROUND_L_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1287,6 +1295,7 @@ static void ROUND_L_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void TRUNC_L_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1298,6 +1307,7 @@ static void TRUNC_L_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void CEIL_L_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1309,6 +1319,7 @@ static void CEIL_L_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void FLOOR_L_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1320,6 +1331,7 @@ static void FLOOR_L_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void ROUND_W_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1331,6 +1343,7 @@ static void ROUND_W_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void TRUNC_W_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1342,6 +1355,7 @@ static void TRUNC_W_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void CEIL_W_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1353,6 +1367,7 @@ static void CEIL_W_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void FLOOR_W_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1364,6 +1379,7 @@ static void FLOOR_W_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void CVT_D_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1371,6 +1387,7 @@ static void CVT_D_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void CVT_W_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1381,6 +1398,7 @@ static void CVT_W_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void CVT_L_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1564,14 +1582,26 @@ static void C_NGT_S()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void (*interp_cop1_s[64])(void) = {
-    ADD_S,     SUB_S,     MUL_S,     DIV_S,    SQRT_S,    ABS_S,  MOV_S,   NEG_S,   ROUND_L_S, TRUNC_L_S, CEIL_L_S,
-    FLOOR_L_S, ROUND_W_S, TRUNC_W_S, CEIL_W_S, FLOOR_W_S, NI,     NI,      NI,      NI,        NI,        NI,
-    NI,        NI,        NI,        NI,       NI,        NI,     NI,      NI,      NI,        NI,        NI,
-    CVT_D_S,   NI,        NI,        CVT_W_S,  CVT_L_S,   NI,     NI,      NI,      NI,        NI,        NI,
-    NI,        NI,        NI,        NI,       C_F_S,     C_UN_S, C_EQ_S,  C_UEQ_S, C_OLT_S,   C_ULT_S,   C_OLE_S,
-    C_ULE_S,   C_SF_S,    C_NGLE_S,  C_SEQ_S,  C_NGL_S,   C_LT_S, C_NGE_S, C_LE_S,  C_NGT_S};
-
+    ADD_S<FLOAT_EXCEPTIONS>,     SUB_S<FLOAT_EXCEPTIONS>,     MUL_S<FLOAT_EXCEPTIONS>,    DIV_S<FLOAT_EXCEPTIONS>,
+    SQRT_S<FLOAT_EXCEPTIONS>,    ABS_S<FLOAT_EXCEPTIONS>,     MOV_S,                      NEG_S<FLOAT_EXCEPTIONS>,
+    ROUND_L_S<FLOAT_EXCEPTIONS>, TRUNC_L_S<FLOAT_EXCEPTIONS>, CEIL_L_S<FLOAT_EXCEPTIONS>, FLOOR_L_S<FLOAT_EXCEPTIONS>,
+    ROUND_W_S<FLOAT_EXCEPTIONS>, TRUNC_W_S<FLOAT_EXCEPTIONS>, CEIL_W_S<FLOAT_EXCEPTIONS>, FLOOR_W_S<FLOAT_EXCEPTIONS>,
+    NI,                          NI,                          NI,                         NI,
+    NI,                          NI,                          NI,                         NI,
+    NI,                          NI,                          NI,                         NI,
+    NI,                          NI,                          NI,                         NI,
+    NI,                          CVT_D_S<FLOAT_EXCEPTIONS>,   NI,                         NI,
+    CVT_W_S<FLOAT_EXCEPTIONS>,   CVT_L_S<FLOAT_EXCEPTIONS>,   NI,                         NI,
+    NI,                          NI,                          NI,                         NI,
+    NI,                          NI,                          NI,                         NI,
+    C_F_S,                       C_UN_S,                      C_EQ_S,                     C_UEQ_S,
+    C_OLT_S,                     C_ULT_S,                     C_OLE_S,                    C_ULE_S,
+    C_SF_S,                      C_NGLE_S,                    C_SEQ_S,                    C_NGL_S,
+    C_LT_S,                      C_NGE_S,                     C_LE_S,                     C_NGT_S};
+
+template <bool FLOAT_EXCEPTIONS>
 static void ADD_D()
 {
     set_rounding();
@@ -1582,6 +1612,7 @@ static void ADD_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void SUB_D()
 {
     set_rounding();
@@ -1592,6 +1623,7 @@ static void SUB_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void MUL_D()
 {
     set_rounding();
@@ -1602,6 +1634,7 @@ static void MUL_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void DIV_D()
 {
     if ((FCR31 & 0x400) && *reg_cop1_double[core_cfft] == 0)
@@ -1621,6 +1654,7 @@ static void DIV_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void SQRT_D()
 {
     set_rounding();
@@ -1630,6 +1664,7 @@ static void SQRT_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void ABS_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1643,6 +1678,7 @@ static void MOV_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void NEG_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1650,6 +1686,7 @@ static void NEG_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void ROUND_L_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1661,6 +1698,7 @@ static void ROUND_L_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void TRUNC_L_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1672,6 +1710,7 @@ static void TRUNC_L_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void CEIL_L_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1683,6 +1722,7 @@ static void CEIL_L_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void FLOOR_L_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1694,6 +1734,7 @@ static void FLOOR_L_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void ROUND_W_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1705,6 +1746,7 @@ static void ROUND_W_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void TRUNC_W_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1716,6 +1758,7 @@ static void TRUNC_W_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void CEIL_W_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1727,6 +1770,7 @@ static void CEIL_W_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void FLOOR_W_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1738,6 +1782,7 @@ static void FLOOR_W_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void CVT_S_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1755,6 +1800,7 @@ static void CVT_S_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void CVT_W_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1765,6 +1811,7 @@ static void CVT_W_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void CVT_L_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1948,13 +1995,24 @@ static void C_NGT_D()
     interp_addr += 4;
 }
 
+template <bool FLOAT_EXCEPTIONS>
 static void (*interp_cop1_d[64])(void) = {
-    ADD_D,     SUB_D,     MUL_D,     DIV_D,    SQRT_D,    ABS_D,  MOV_D,   NEG_D,   ROUND_L_D, TRUNC_L_D, CEIL_L_D,
-    FLOOR_L_D, ROUND_W_D, TRUNC_W_D, CEIL_W_D, FLOOR_W_D, NI,     NI,      NI,      NI,        NI,        NI,
-    NI,        NI,        NI,        NI,       NI,        NI,     NI,      NI,      NI,        NI,        CVT_S_D,
-    NI,        NI,        NI,        CVT_W_D,  CVT_L_D,   NI,     NI,      NI,      NI,        NI,        NI,
-    NI,        NI,        NI,        NI,       C_F_D,     C_UN_D, C_EQ_D,  C_UEQ_D, C_OLT_D,   C_ULT_D,   C_OLE_D,
-    C_ULE_D,   C_SF_D,    C_NGLE_D,  C_SEQ_D,  C_NGL_D,   C_LT_D, C_NGE_D, C_LE_D,  C_NGT_D};
+    ADD_D<FLOAT_EXCEPTIONS>,     SUB_D<FLOAT_EXCEPTIONS>,     MUL_D<FLOAT_EXCEPTIONS>,    DIV_D<FLOAT_EXCEPTIONS>,
+    SQRT_D<FLOAT_EXCEPTIONS>,    ABS_D<FLOAT_EXCEPTIONS>,     MOV_D,                      NEG_D<FLOAT_EXCEPTIONS>,
+    ROUND_L_D<FLOAT_EXCEPTIONS>, TRUNC_L_D<FLOAT_EXCEPTIONS>, CEIL_L_D<FLOAT_EXCEPTIONS>, FLOOR_L_D<FLOAT_EXCEPTIONS>,
+    ROUND_W_D<FLOAT_EXCEPTIONS>, TRUNC_W_D<FLOAT_EXCEPTIONS>, CEIL_W_D<FLOAT_EXCEPTIONS>, FLOOR_W_D<FLOAT_EXCEPTIONS>,
+    NI,                          NI,                          NI,                         NI,
+    NI,                          NI,                          NI,                         NI,
+    NI,                          NI,                          NI,                         NI,
+    NI,                          NI,                          NI,                         NI,
+    CVT_S_D<FLOAT_EXCEPTIONS>,   NI,                          NI,                         NI,
+    CVT_W_D<FLOAT_EXCEPTIONS>,   CVT_L_D<FLOAT_EXCEPTIONS>,   NI,                         NI,
+    NI,                          NI,                          NI,                         NI,
+    NI,                          NI,                          NI,                         NI,
+    C_F_D,                       C_UN_D,                      C_EQ_D,                     C_UEQ_D,
+    C_OLT_D,                     C_ULT_D,                     C_OLE_D,                    C_ULE_D,
+    C_SF_D,                      C_NGLE_D,                    C_SEQ_D,                    C_NGL_D,
+    C_LT_D,                      C_NGE_D,                     C_LE_D,                     C_NGT_D};
 
 static void CVT_S_W()
 {
@@ -2065,12 +2123,12 @@ static void BC()
 
 static void S()
 {
-    interp_cop1_s[(vr_op & 0x3F)]();
+    (g_float_exceptions ? interp_cop1_s<true> : interp_cop1_s<false>)[(vr_op & 0x3F)]();
 }
 
 static void D()
 {
-    interp_cop1_d[(vr_op & 0x3F)]();
+    (g_float_exceptions ? interp_cop1_d<true> : interp_cop1_d<false>)[(vr_op & 0x3F)]();
 }
 
 static void W()
@@ -2465,53 +2523,38 @@ static void LDL()
 {
     uint64_t word = 0;
     interp_addr += 4;
-    switch ((core_iimmediate + irs32) & 7)
+    const uint32_t addr = core_iimmediate + irs32;
+    switch (addr & 7)
     {
     case 0:
-        address = core_iimmediate + irs32;
-        rdword = (uint64_t *)&core_irt;
-        read_dword_in_memory();
+        read64(addr, *(uint64_t *)&core_irt);
         break;
     case 1:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFF) | (word << 8);
         break;
     case 2:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFF) | (word << 16);
         break;
     case 3:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFFFF) | (word << 24);
         break;
     case 4:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFFFFFF) | (word << 32);
         break;
     case 5:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFFFFFFFFLL) | (word << 40);
         break;
     case 6:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFFFFFFFFFFLL) | (word << 48);
         break;
     case 7:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFFFFFFFFFFFFLL) | (word << 56);
         break;
     }
@@ -2521,54 +2564,39 @@ static void LDR()
 {
     uint64_t word = 0;
     interp_addr += 4;
-    switch ((core_iimmediate + irs32) & 7)
+    const uint32_t addr = core_iimmediate + irs32;
+    switch (addr & 7)
     {
     case 0:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFFFFFFFFFFFF00LL) | (word >> 56);
         break;
     case 1:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFFFFFFFFFF0000LL) | (word >> 48);
         break;
     case 2:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFFFFFFFF000000LL) | (word >> 40);
         break;
     case 3:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFFFFFF00000000LL) | (word >> 32);
         break;
     case 4:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFFFF0000000000LL) | (word >> 24);
         break;
     case 5:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFFFF000000000000LL) | (word >> 16);
         break;
     case 6:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, word);
         core_irt = (core_irt & 0xFF00000000000000LL) | (word >> 8);
         break;
     case 7:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = (uint64_t *)&core_irt;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, *(uint64_t *)&core_irt);
         break;
     }
 }
@@ -2576,48 +2604,40 @@ static void LDR()
 static void LB()
 {
     interp_addr += 4;
-    address = core_iimmediate + irs32;
-    rdword = (uint64_t *)&core_irt;
-    read_byte_in_memory();
-    sign_extendedb(core_irt);
+    uint8_t value = (uint8_t)core_irt;
+    read8(core_iimmediate + irs32, value);
+    core_irt = (int8_t)value;
 }
 
 static void LH()
 {
     interp_addr += 4;
-    address = core_iimmediate + irs32;
-    rdword = (uint64_t *)&core_irt;
-    read_hword_in_memory();
-    sign_extendedh(core_irt);
+    uint16_t value = (uint16_t)core_irt;
+    read16(core_iimmediate + irs32, value);
+    core_irt = (int16_t)value;
 }
 
 static void LWL()
 {
-    uint64_t word = 0;
+    uint32_t word = 0;
     interp_addr += 4;
-    switch ((core_iimmediate + irs32) & 3)
+    const uint32_t addr = core_iimmediate + irs32;
+    switch (addr & 3)
     {
     case 0:
-        address = core_iimmediate + irs32;
-        rdword = (uint64_t *)&core_irt;
-        read_word_in_memory();
+        word = (uint32_t)core_irt;
+        if (read32(addr, word)) core_irt = word;
         break;
     case 1:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
+        read32(addr & 0xFFFFFFFC, word);
         core_irt = (core_irt & 0xFF) | (word << 8);
         break;
     case 2:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
+        read32(addr & 0xFFFFFFFC, word);
         core_irt = (core_irt & 0xFFFF) | (word << 16);
         break;
     case 3:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
+        read32(addr & 0xFFFFFFFC, word);
         core_irt = (core_irt & 0xFFFFFF) | (word << 24);
         break;
     }
@@ -2626,114 +2646,94 @@ static void LWL()
 
 static void LW()
 {
-    address = core_iimmediate + irs32;
-    rdword = (uint64_t *)&core_irt;
+    const uint32_t addr = core_iimmediate + irs32;
+    uint32_t value = (uint32_t)core_irt;
     interp_addr += 4;
-    read_word_in_memory();
-    sign_extended(core_irt);
+    read32(addr, value);
+    core_irt = (int32_t)value;
 }
 
 static void LBU()
 {
     interp_addr += 4;
-    address = core_iimmediate + irs32;
-    rdword = (uint64_t *)&core_irt;
-    read_byte_in_memory();
+    uint8_t value = (uint8_t)core_irt;
+    if (read8(core_iimmediate + irs32, value)) core_irt = value;
 }
 
 static void LHU()
 {
     interp_addr += 4;
-    address = core_iimmediate + irs32;
-    rdword = (uint64_t *)&core_irt;
-    read_hword_in_memory();
+    uint16_t value = (uint16_t)core_irt;
+    if (read16(core_iimmediate + irs32, value)) core_irt = value;
 }
 
 static void LWR()
 {
-    uint64_t word = 0;
+    uint32_t word = 0;
     interp_addr += 4;
-    switch ((core_iimmediate + irs32) & 3)
+    const uint32_t addr = core_iimmediate + irs32;
+    switch (addr & 3)
     {
     case 0:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
+        read32(addr & 0xFFFFFFFC, word);
         core_irt = (core_irt & 0xFFFFFFFFFFFFFF00LL) | ((word >> 24) & 0xFF);
         break;
     case 1:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
+        read32(addr & 0xFFFFFFFC, word);
         core_irt = (core_irt & 0xFFFFFFFFFFFF0000LL) | ((word >> 16) & 0xFFFF);
         break;
     case 2:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
+        read32(addr & 0xFFFFFFFC, word);
         core_irt = (core_irt & 0xFFFFFFFFFF000000LL) | ((word >> 8) & 0xFFFFFF);
         break;
     case 3:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = (uint64_t *)&core_irt;
-        read_word_in_memory();
-        sign_extended(core_irt);
+        word = (uint32_t)core_irt;
+        read32(addr & 0xFFFFFFFC, word);
+        core_irt = (int32_t)word;
     }
 }
 
 static void LWU()
 {
-    address = core_iimmediate + irs32;
-    rdword = (uint64_t *)&core_irt;
+    const uint32_t addr = core_iimmediate + irs32;
+    uint32_t value = (uint32_t)core_irt;
     interp_addr += 4;
-    read_word_in_memory();
+    if (read32(addr, value)) core_irt = value;
 }
 
 static void SB()
 {
     interp_addr += 4;
-    address = core_iimmediate + irs32;
-    g_byte = (unsigned char)(core_irt & 0xFF);
-    write_byte_in_memory();
+    write8(core_iimmediate + irs32, (uint8_t)(core_irt & 0xFF));
 }
 
 static void SH()
 {
     interp_addr += 4;
-    address = core_iimmediate + irs32;
-    hword = (uint16_t)(core_irt & 0xFFFF);
-    write_hword_in_memory();
+    write16(core_iimmediate + irs32, (uint16_t)(core_irt & 0xFFFF));
 }
 
 static void SWL()
 {
-    uint64_t old_word = 0;
+    uint32_t old_word = 0;
+    uint32_t paddr;
     interp_addr += 4;
-    switch ((core_iimmediate + irs32) & 3)
+    const uint32_t addr = core_iimmediate + irs32;
+    switch (addr & 3)
     {
     case 0:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        word = (uint32_t)core_irt;
-        write_word_in_memory();
+        write32(addr & 0xFFFFFFFC, (uint32_t)core_irt);
         break;
     case 1:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = &old_word;
-        read_word_in_memory();
-        word = ((uint32_t)core_irt >> 8) | (old_word & 0xFF000000);
-        write_word_in_memory();
+        read32(addr & 0xFFFFFFFC, old_word, &paddr);
+        write32(paddr, ((uint32_t)core_irt >> 8) | (old_word & 0xFF000000));
         break;
     case 2:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = &old_word;
-        read_word_in_memory();
-        word = ((uint32_t)core_irt >> 16) | (old_word & 0xFFFF0000);
-        write_word_in_memory();
+        read32(addr & 0xFFFFFFFC, old_word, &paddr);
+        write32(paddr, ((uint32_t)core_irt >> 16) | (old_word & 0xFFFF0000));
         break;
     case 3:
-        address = core_iimmediate + irs32;
-        g_byte = (unsigned char)(core_irt >> 24);
-        write_byte_in_memory();
+        write8(addr, (uint8_t)(core_irt >> 24));
         break;
     }
 }
@@ -2741,70 +2741,47 @@ static void SWL()
 static void SW()
 {
     interp_addr += 4;
-    address = core_iimmediate + irs32;
-    word = (uint32_t)(core_irt & 0xFFFFFFFF);
-    write_word_in_memory();
+    write32(core_iimmediate + irs32, (uint32_t)(core_irt & 0xFFFFFFFF));
 }
 
 static void SDL()
 {
     uint64_t old_word = 0;
+    uint32_t paddr;
     interp_addr += 4;
-    switch ((core_iimmediate + irs32) & 7)
+    const uint32_t addr = core_iimmediate + irs32;
+    switch (addr & 7)
     {
     case 0:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        dword = core_irt;
-        write_dword_in_memory();
+        write64(addr & 0xFFFFFFF8, core_irt);
         break;
     case 1:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = ((uint64_t)core_irt >> 8) | (old_word & 0xFF00000000000000LL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, ((uint64_t)core_irt >> 8) | (old_word & 0xFF00000000000000LL));
         break;
     case 2:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = ((uint64_t)core_irt >> 16) | (old_word & 0xFFFF000000000000LL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, ((uint64_t)core_irt >> 16) | (old_word & 0xFFFF000000000000LL));
         break;
     case 3:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = ((uint64_t)core_irt >> 24) | (old_word & 0xFFFFFF0000000000LL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, ((uint64_t)core_irt >> 24) | (old_word & 0xFFFFFF0000000000LL));
         break;
     case 4:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = ((uint64_t)core_irt >> 32) | (old_word & 0xFFFFFFFF00000000LL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, ((uint64_t)core_irt >> 32) | (old_word & 0xFFFFFFFF00000000LL));
         break;
     case 5:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = ((uint64_t)core_irt >> 40) | (old_word & 0xFFFFFFFFFF000000LL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, ((uint64_t)core_irt >> 40) | (old_word & 0xFFFFFFFFFF000000LL));
         break;
     case 6:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = ((uint64_t)core_irt >> 48) | (old_word & 0xFFFFFFFFFFFF0000LL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, ((uint64_t)core_irt >> 48) | (old_word & 0xFFFFFFFFFFFF0000LL));
         break;
     case 7:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = ((uint64_t)core_irt >> 56) | (old_word & 0xFFFFFFFFFFFFFF00LL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, ((uint64_t)core_irt >> 56) | (old_word & 0xFFFFFFFFFFFFFF00LL));
         break;
     }
 }
@@ -2812,97 +2789,67 @@ static void SDL()
 static void SDR()
 {
     uint64_t old_word = 0;
+    uint32_t paddr;
     interp_addr += 4;
-    switch ((core_iimmediate + irs32) & 7)
+    const uint32_t addr = core_iimmediate + irs32;
+    switch (addr & 7)
     {
     case 0:
-        address = core_iimmediate + irs32;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = (core_irt << 56) | (old_word & 0x00FFFFFFFFFFFFFFLL);
-        write_dword_in_memory();
+        read64(addr, old_word, &paddr);
+        write64(paddr, (core_irt << 56) | (old_word & 0x00FFFFFFFFFFFFFFLL));
         break;
     case 1:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = (core_irt << 48) | (old_word & 0x0000FFFFFFFFFFFFLL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, (core_irt << 48) | (old_word & 0x0000FFFFFFFFFFFFLL));
         break;
     case 2:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = (core_irt << 40) | (old_word & 0x000000FFFFFFFFFFLL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, (core_irt << 40) | (old_word & 0x000000FFFFFFFFFFLL));
         break;
     case 3:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = (core_irt << 32) | (old_word & 0x00000000FFFFFFFFLL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, (core_irt << 32) | (old_word & 0x00000000FFFFFFFFLL));
         break;
     case 4:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = (core_irt << 24) | (old_word & 0x0000000000FFFFFFLL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, (core_irt << 24) | (old_word & 0x0000000000FFFFFFLL));
         break;
     case 5:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = (core_irt << 16) | (old_word & 0x000000000000FFFFLL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, (core_irt << 16) | (old_word & 0x000000000000FFFFLL));
         break;
     case 6:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        dword = (core_irt << 8) | (old_word & 0x00000000000000FFLL);
-        write_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, old_word, &paddr);
+        write64(paddr, (core_irt << 8) | (old_word & 0x00000000000000FFLL));
         break;
     case 7:
-        address = (core_iimmediate + irs32) & 0xFFFFFFF8;
-        dword = core_irt;
-        write_dword_in_memory();
+        write64(addr & 0xFFFFFFF8, core_irt);
         break;
     }
 }
 
 static void SWR()
 {
-    uint64_t old_word = 0;
+    uint32_t old_word = 0;
+    uint32_t paddr;
     interp_addr += 4;
-    switch ((core_iimmediate + irs32) & 3)
+    const uint32_t addr = core_iimmediate + irs32;
+    switch (addr & 3)
     {
     case 0:
-        address = core_iimmediate + irs32;
-        rdword = &old_word;
-        read_word_in_memory();
-        word = ((uint32_t)core_irt << 24) | (old_word & 0x00FFFFFF);
-        write_word_in_memory();
+        read32(addr, old_word, &paddr);
+        write32(paddr, ((uint32_t)core_irt << 24) | (old_word & 0x00FFFFFF));
         break;
     case 1:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = &old_word;
-        read_word_in_memory();
-        word = ((uint32_t)core_irt << 16) | (old_word & 0x0000FFFF);
-        write_word_in_memory();
+        read32(addr & 0xFFFFFFFC, old_word, &paddr);
+        write32(paddr, ((uint32_t)core_irt << 16) | (old_word & 0x0000FFFF));
         break;
     case 2:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        rdword = &old_word;
-        read_word_in_memory();
-        word = ((uint32_t)core_irt << 8) | (old_word & 0x000000FF);
-        write_word_in_memory();
+        read32(addr & 0xFFFFFFFC, old_word, &paddr);
+        write32(paddr, ((uint32_t)core_irt << 8) | (old_word & 0x000000FF));
         break;
     case 3:
-        address = (core_iimmediate + irs32) & 0xFFFFFFFC;
-        word = (uint32_t)core_irt;
-        write_word_in_memory();
+        write32(addr & 0xFFFFFFFC, (uint32_t)core_irt);
         break;
     }
 }
@@ -2914,40 +2861,34 @@ static void CACHE()
 
 static void LL()
 {
-    address = core_iimmediate + irs32;
-    rdword = (uint64_t *)&core_irt;
+    const uint32_t addr = core_iimmediate + irs32;
+    uint32_t value = (uint32_t)core_irt;
     interp_addr += 4;
-    read_word_in_memory();
-    sign_extended(core_irt);
+    read32(addr, value);
+    core_irt = (int32_t)value;
     llbit = 1;
 }
 
 static void LWC1()
 {
-    uint64_t temp;
+    uint32_t temp = 0;
     if (check_cop1_unusable()) return;
     interp_addr += 4;
-    address = core_lfoffset + reg[core_lfbase];
-    rdword = &temp;
-    read_word_in_memory();
-    *((int32_t *)reg_cop1_simple[core_lfft]) = *rdword;
+    read32(core_lfoffset + reg[core_lfbase], temp);
+    *((int32_t *)reg_cop1_simple[core_lfft]) = temp;
 }
 
 static void LDC1()
 {
     if (check_cop1_unusable()) return;
     interp_addr += 4;
-    address = core_lfoffset + reg[core_lfbase];
-    rdword = (uint64_t *)reg_cop1_double[core_lfft];
-    read_dword_in_memory();
+    read64(core_lfoffset + reg[core_lfbase], *(uint64_t *)reg_cop1_double[core_lfft]);
 }
 
 static void LD()
 {
     interp_addr += 4;
-    address = core_iimmediate + irs32;
-    rdword = (uint64_t *)&core_irt;
-    read_dword_in_memory();
+    read64(core_iimmediate + irs32, *(uint64_t *)&core_irt);
 }
 
 static void SC()
@@ -2955,9 +2896,7 @@ static void SC()
     interp_addr += 4;
     if (llbit)
     {
-        address = core_iimmediate + irs32;
-        word = (uint32_t)(core_irt & 0xFFFFFFFF);
-        write_word_in_memory();
+        write32(core_iimmediate + irs32, (uint32_t)(core_irt & 0xFFFFFFFF));
         llbit = 0;
         core_irt = 1;
     }
@@ -2971,26 +2910,20 @@ static void SWC1()
 {
     if (check_cop1_unusable()) return;
     interp_addr += 4;
-    address = core_lfoffset + reg[core_lfbase];
-    word = *((int32_t *)reg_cop1_simple[core_lfft]);
-    write_word_in_memory();
+    write32(core_lfoffset + reg[core_lfbase], *((int32_t *)reg_cop1_simple[core_lfft]));
 }
 
 static void SDC1()
 {
     if (check_cop1_unusable()) return;
     interp_addr += 4;
-    address = core_lfoffset + reg[core_lfbase];
-    dword = *((uint64_t *)reg_cop1_double[core_lfft]);
-    write_dword_in_memory();
+    write64(core_lfoffset + reg[core_lfbase], *((uint64_t *)reg_cop1_double[core_lfft]));
 }
 
 static void SD()
 {
     interp_addr += 4;
-    address = core_iimmediate + irs32;
-    dword = core_irt;
-    write_dword_in_memory();
+    write64(core_iimmediate + irs32, core_irt);
 }
 
 void (*interp_ops[64])(void) = {SPECIAL, REGIMM, J,   JAL,  BEQ,  BNE,  BLEZ, BGTZ, ADDI,  ADDIU, SLTI,  SLTIU, ANDI,
@@ -3065,7 +2998,40 @@ void prefetch()
         interp_addr = addr;
         return;
     }
-    if (g_ctx.tl_active()) tracelog_log_pure();
+    if (tl_active()) tracelog_log_pure();
+}
+
+/**
+ * \brief Runs instructions until the emulator stops or the debugger is armed or disarmed.
+ * \tparam DEBUG Whether the debugger hooks run around every instruction. Must match <c>g_dbg_armed</c>.
+ */
+template <bool DEBUG> static void pure_interpreter_loop()
+{
+    if constexpr (DEBUG)
+    {
+        // The fast loop doesn't wait after its instructions, so a pause requested during the last one is honored here,
+        // before the next instruction is dispatched.
+        Debugger::on_late_cycle(vr_op, interp_addr);
+    }
+
+    while (!stop && g_dbg_armed.load(std::memory_order_relaxed) == DEBUG)
+    {
+        prefetch();
+        if constexpr (DEBUG)
+        {
+            Debugger::on_early_cycle(vr_op, interp_addr);
+        }
+        interp_ops[((vr_op >> 26) & 0x3F)]();
+        g_vr_beq_ignore_jmp = false;
+        if constexpr (DEBUG)
+        {
+            while (!g_ctx.dbg_get_resumed())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            Debugger::on_late_cycle(vr_op, interp_addr);
+        }
+    }
 }
 
 void pure_interpreter()
@@ -3079,15 +3045,14 @@ void pure_interpreter()
     g_core->log_info(std::format("core_executing: {}", (bool)core_executing));
     while (!stop)
     {
-        prefetch();
-        interp_ops[((vr_op >> 26) & 0x3F)]();
-        g_vr_beq_ignore_jmp = false;
-
-        while (!g_ctx.dbg_get_resumed())
+        if (g_dbg_armed)
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            pure_interpreter_loop<true>();
+        }
+        else
+        {
+            pure_interpreter_loop<false>();
         }
-        Debugger::on_late_cycle(vr_op, interp_addr);
     }
     PC->addr = interp_addr;
 }
@@ -3100,7 +3065,7 @@ void interprete_section(uint32_t addr)
     while (!stop && (addr >> 12) == (interp_addr >> 12))
     {
         prefetch();
-        if (g_ctx.tl_active()) tracelog_log_pure();
+        if (tl_active()) tracelog_log_pure();
         PC->addr = interp_addr;
         interp_ops[((vr_op >> 26) & 0x3F)]();
     }
@@ -10,7 +10,9 @@
 #include <format>
 #include <memory/memory.h>
 #include <memory/pif.h>
+#include <memory/savedata.h>
 #include <memory/savestates.h>
+#include <r4300/cop1_helpers.h>
 #include <r4300/exception.h>
 #include <r4300/interrupt.h>
 #include <r4300/macros.h>
@@ -75,18 +77,15 @@ bool g_vr_frame_skipped;
 core_system_type g_sys_type;
 std::atomic<int32_t> g_wait_counter = 0;
 
-FILE *g_eeprom_file;
-FILE *g_sram_file;
-FILE *g_fram_file;
-FILE *g_mpak_file;
-
 /*#define check_memory() \
    if (!invalid_code[address>>12]) \
        invalid_code[address>>12] = 1;*/
 
-#define check_memory()                                                                                                 \
-    if (!invalid_code[address >> 12])                                                                                  \
-        if (blocks[address >> 12]->block[(address & 0xFFF) / 4].ops != NOTCOMPILED) invalid_code[address >> 12] = 1;
+static void check_memory(const uint32_t paddr)
+{
+    if (!invalid_code[paddr >> 12])
+        if (blocks[paddr >> 12]->block[(paddr & 0xFFF) / 4].ops != NOTCOMPILED) invalid_code[paddr >> 12] = 1;
+}
 
 void vr_invalidate_visuals()
 {
@@ -828,54 +827,32 @@ void LDL()
 {
     uint64_t word = 0;
     PC++;
-    switch ((core_lsaddr) & 7)
+    const uint32_t addr = core_lsaddr;
+    switch (addr & 7)
     {
     case 0:
-        address = core_lsaddr;
-        rdword = (uint64_t *)&core_lsrt;
-        read_dword_in_memory();
+        read64(addr, *(uint64_t *)&core_lsrt);
         break;
     case 1:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFF) | (word << 8);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFF) | (word << 8);
         break;
     case 2:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFF) | (word << 16);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFF) | (word << 16);
         break;
     case 3:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFF) | (word << 24);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFFFF) | (word << 24);
         break;
     case 4:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFF) | (word << 32);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFFFFFF) | (word << 32);
         break;
     case 5:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFFFFLL) | (word << 40);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFFFFFFFFLL) | (word << 40);
         break;
     case 6:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFFLL) | (word << 48);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFFLL) | (word << 48);
         break;
     case 7:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFFFFLL) | (word << 56);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFFFFLL) | (word << 56);
         break;
     }
 }
@@ -884,54 +861,32 @@ void LDR()
 {
     uint64_t word = 0;
     PC++;
-    switch ((core_lsaddr) & 7)
+    const uint32_t addr = core_lsaddr;
+    switch (addr & 7)
     {
     case 0:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFFFF00LL) | (word >> 56);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFFFF00LL) | (word >> 56);
         break;
     case 1:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFF0000LL) | (word >> 48);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFF0000LL) | (word >> 48);
         break;
     case 2:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFFFF000000LL) | (word >> 40);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFFFFFFFF000000LL) | (word >> 40);
         break;
     case 3:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFF00000000LL) | (word >> 32);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFFFFFF00000000LL) | (word >> 32);
         break;
     case 4:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFF0000000000LL) | (word >> 24);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFFFF0000000000LL) | (word >> 24);
         break;
     case 5:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFF000000000000LL) | (word >> 16);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFFFF000000000000LL) | (word >> 16);
         break;
     case 6:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &word;
-        read_dword_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFF00000000000000LL) | (word >> 8);
+        if (read64(addr & 0xFFFFFFF8, word)) core_lsrt = (core_lsrt & 0xFF00000000000000LL) | (word >> 8);
         break;
     case 7:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = (uint64_t *)&core_lsrt;
-        read_dword_in_memory();
+        read64(addr & 0xFFFFFFF8, *(uint64_t *)&core_lsrt);
         break;
     }
 }
@@ -939,176 +894,141 @@ void LDR()
 void LB()
 {
     PC++;
-    address = core_lsaddr;
-    rdword = (uint64_t *)&core_lsrt;
-    read_byte_in_memory();
-    if (address) sign_extendedb(core_lsrt);
+    uint8_t value = (uint8_t)core_lsrt;
+    if (read8(core_lsaddr, value)) core_lsrt = (int8_t)value;
 }
 
 void LH()
 {
     PC++;
-    address = core_lsaddr;
-    rdword = (uint64_t *)&core_lsrt;
-    read_hword_in_memory();
-    if (address) sign_extendedh(core_lsrt);
+    uint16_t value = (uint16_t)core_lsrt;
+    if (read16(core_lsaddr, value)) core_lsrt = (int16_t)value;
 }
 
 void LWL()
 {
-    uint64_t word = 0;
+    uint32_t word = 0;
+    bool ok = false;
     PC++;
-    switch ((core_lsaddr) & 3)
+    const uint32_t addr = core_lsaddr;
+    switch (addr & 3)
     {
     case 0:
-        address = core_lsaddr;
-        rdword = (uint64_t *)&core_lsrt;
-        read_word_in_memory();
+        word = (uint32_t)core_lsrt;
+        ok = read32(addr, word);
+        if (ok) core_lsrt = word;
         break;
     case 1:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFF) | (word << 8);
+        ok = read32(addr & 0xFFFFFFFC, word);
+        if (ok) core_lsrt = (core_lsrt & 0xFF) | (word << 8);
         break;
     case 2:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFF) | (word << 16);
+        ok = read32(addr & 0xFFFFFFFC, word);
+        if (ok) core_lsrt = (core_lsrt & 0xFFFF) | (word << 16);
         break;
     case 3:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFF) | (word << 24);
+        ok = read32(addr & 0xFFFFFFFC, word);
+        if (ok) core_lsrt = (core_lsrt & 0xFFFFFF) | (word << 24);
         break;
     }
-    if (address) sign_extended(core_lsrt);
+    if (ok) sign_extended(core_lsrt);
 }
 
 void LW()
 {
     PC++;
-    address = core_lsaddr;
-    rdword = (uint64_t *)&core_lsrt;
-    read_word_in_memory();
-    if (address) sign_extended(core_lsrt);
+    uint32_t value = (uint32_t)core_lsrt;
+    if (read32(core_lsaddr, value)) core_lsrt = (int32_t)value;
 }
 
 void LBU()
 {
     PC++;
-    address = core_lsaddr;
-    rdword = (uint64_t *)&core_lsrt;
-    read_byte_in_memory();
+    uint8_t value = (uint8_t)core_lsrt;
+    if (read8(core_lsaddr, value)) core_lsrt = value;
 }
 
 void LHU()
 {
     PC++;
-    address = core_lsaddr;
-    rdword = (uint64_t *)&core_lsrt;
-    read_hword_in_memory();
+    uint16_t value = (uint16_t)core_lsrt;
+    if (read16(core_lsaddr, value)) core_lsrt = value;
 }
 
 void LWR()
 {
-    uint64_t word = 0;
+    uint32_t word = 0;
     PC++;
-    switch ((core_lsaddr) & 3)
+    const uint32_t addr = core_lsaddr;
+    switch (addr & 3)
     {
     case 0:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFFFF00LL) | ((word >> 24) & 0xFF);
+        if (read32(addr & 0xFFFFFFFC, word)) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFFFF00LL) | ((word >> 24) & 0xFF);
         break;
     case 1:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFF0000LL) | ((word >> 16) & 0xFFFF);
+        if (read32(addr & 0xFFFFFFFC, word)) core_lsrt = (core_lsrt & 0xFFFFFFFFFFFF0000LL) | ((word >> 16) & 0xFFFF);
         break;
     case 2:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = &word;
-        read_word_in_memory();
-        if (address) core_lsrt = (core_lsrt & 0xFFFFFFFFFF000000LL) | ((word >> 8) & 0XFFFFFF);
+        if (read32(addr & 0xFFFFFFFC, word)) core_lsrt = (core_lsrt & 0xFFFFFFFFFF000000LL) | ((word >> 8) & 0XFFFFFF);
         break;
     case 3:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = (uint64_t *)&core_lsrt;
-        read_word_in_memory();
-        if (address) sign_extended(core_lsrt);
+        word = (uint32_t)core_lsrt;
+        if (read32(addr & 0xFFFFFFFC, word)) core_lsrt = (int32_t)word;
     }
 }
 
 void LWU()
 {
     PC++;
-    address = core_lsaddr;
-    rdword = (uint64_t *)&core_lsrt;
-    read_word_in_memory();
+    uint32_t value = (uint32_t)core_lsrt;
+    if (read32(core_lsaddr, value)) core_lsrt = value;
 }
 
 void SB()
 {
     PC++;
-    address = core_lsaddr;
-    g_byte = (unsigned char)(core_lsrt & 0xFF);
-    write_byte_in_memory();
-    check_memory();
+    uint32_t paddr;
+    write8(core_lsaddr, (uint8_t)(core_lsrt & 0xFF), &paddr);
+    check_memory(paddr);
 }
 
 void SH()
 {
     PC++;
-    address = core_lsaddr;
-    hword = (uint16_t)(core_lsrt & 0xFFFF);
-    write_hword_in_memory();
-    check_memory();
+    uint32_t paddr;
+    write16(core_lsaddr, (uint16_t)(core_lsrt & 0xFFFF), &paddr);
+    check_memory(paddr);
 }
 
 void SWL()
 {
-    uint64_t old_word = 0;
+    uint32_t old_word = 0;
+    uint32_t paddr;
     PC++;
-    switch ((core_lsaddr) & 3)
+    const uint32_t addr = core_lsaddr;
+    switch (addr & 3)
     {
     case 0:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        word = (uint32_t)core_lsrt;
-        write_word_in_memory();
-        check_memory();
+        write32(addr & 0xFFFFFFFC, (uint32_t)core_lsrt, &paddr);
+        check_memory(paddr);
         break;
     case 1:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = &old_word;
-        read_word_in_memory();
-        if (address)
+        if (read32(addr & 0xFFFFFFFC, old_word, &paddr))
         {
-            word = ((uint32_t)core_lsrt >> 8) | (old_word & 0xFF000000);
-            write_word_in_memory();
-            check_memory();
+            write32(paddr, ((uint32_t)core_lsrt >> 8) | (old_word & 0xFF000000), &paddr);
+            check_memory(paddr);
         }
         break;
     case 2:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = &old_word;
-        read_word_in_memory();
-        if (address)
+        if (read32(addr & 0xFFFFFFFC, old_word, &paddr))
         {
-            word = ((uint32_t)core_lsrt >> 16) | (old_word & 0xFFFF0000);
-            write_word_in_memory();
-            check_memory();
+            write32(paddr, ((uint32_t)core_lsrt >> 16) | (old_word & 0xFFFF0000), &paddr);
+            check_memory(paddr);
         }
         break;
     case 3:
-        address = core_lsaddr;
-        g_byte = (unsigned char)(core_lsrt >> 24);
-        write_byte_in_memory();
-        check_memory();
+        write8(addr, (uint8_t)(core_lsrt >> 24), &paddr);
+        check_memory(paddr);
         break;
     }
 }
@@ -1116,99 +1036,70 @@ void SWL()
 void SW()
 {
     PC++;
-    address = core_lsaddr;
-    word = (uint32_t)(core_lsrt & 0xFFFFFFFF);
-    write_word_in_memory();
-    check_memory();
+    uint32_t paddr;
+    write32(core_lsaddr, (uint32_t)(core_lsrt & 0xFFFFFFFF), &paddr);
+    check_memory(paddr);
 }
 
 void SDL()
 {
     uint64_t old_word = 0;
+    uint32_t paddr;
     PC++;
-    switch ((core_lsaddr) & 7)
+    const uint32_t addr = core_lsaddr;
+    switch (addr & 7)
     {
     case 0:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        dword = core_lsrt;
-        write_dword_in_memory();
-        check_memory();
+        write64(addr & 0xFFFFFFF8, core_lsrt, &paddr);
+        check_memory(paddr);
         break;
     case 1:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = ((uint64_t)core_lsrt >> 8) | (old_word & 0xFF00000000000000LL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, ((uint64_t)core_lsrt >> 8) | (old_word & 0xFF00000000000000LL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 2:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = ((uint64_t)core_lsrt >> 16) | (old_word & 0xFFFF000000000000LL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, ((uint64_t)core_lsrt >> 16) | (old_word & 0xFFFF000000000000LL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 3:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = ((uint64_t)core_lsrt >> 24) | (old_word & 0xFFFFFF0000000000LL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, ((uint64_t)core_lsrt >> 24) | (old_word & 0xFFFFFF0000000000LL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 4:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = ((uint64_t)core_lsrt >> 32) | (old_word & 0xFFFFFFFF00000000LL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, ((uint64_t)core_lsrt >> 32) | (old_word & 0xFFFFFFFF00000000LL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 5:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = ((uint64_t)core_lsrt >> 40) | (old_word & 0xFFFFFFFFFF000000LL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, ((uint64_t)core_lsrt >> 40) | (old_word & 0xFFFFFFFFFF000000LL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 6:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = ((uint64_t)core_lsrt >> 48) | (old_word & 0xFFFFFFFFFFFF0000LL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, ((uint64_t)core_lsrt >> 48) | (old_word & 0xFFFFFFFFFFFF0000LL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 7:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = ((uint64_t)core_lsrt >> 56) | (old_word & 0xFFFFFFFFFFFFFF00LL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, ((uint64_t)core_lsrt >> 56) | (old_word & 0xFFFFFFFFFFFFFF00LL), &paddr);
+            check_memory(paddr);
         }
         break;
     }
@@ -1217,139 +1108,99 @@ void SDL()
 void SDR()
 {
     uint64_t old_word = 0;
+    uint32_t paddr;
     PC++;
-    switch ((core_lsaddr) & 7)
+    const uint32_t addr = core_lsaddr;
+    switch (addr & 7)
     {
     case 0:
-        address = core_lsaddr;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr, old_word, &paddr))
         {
-            dword = (core_lsrt << 56) | (old_word & 0x00FFFFFFFFFFFFFFLL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, (core_lsrt << 56) | (old_word & 0x00FFFFFFFFFFFFFFLL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 1:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = (core_lsrt << 48) | (old_word & 0x0000FFFFFFFFFFFFLL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, (core_lsrt << 48) | (old_word & 0x0000FFFFFFFFFFFFLL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 2:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = (core_lsrt << 40) | (old_word & 0x000000FFFFFFFFFFLL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, (core_lsrt << 40) | (old_word & 0x000000FFFFFFFFFFLL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 3:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = (core_lsrt << 32) | (old_word & 0x00000000FFFFFFFFLL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, (core_lsrt << 32) | (old_word & 0x00000000FFFFFFFFLL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 4:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = (core_lsrt << 24) | (old_word & 0x0000000000FFFFFFLL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, (core_lsrt << 24) | (old_word & 0x0000000000FFFFFFLL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 5:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = (core_lsrt << 16) | (old_word & 0x000000000000FFFFLL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, (core_lsrt << 16) | (old_word & 0x000000000000FFFFLL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 6:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        rdword = &old_word;
-        read_dword_in_memory();
-        if (address)
+        if (read64(addr & 0xFFFFFFF8, old_word, &paddr))
         {
-            dword = (core_lsrt << 8) | (old_word & 0x00000000000000FFLL);
-            write_dword_in_memory();
-            check_memory();
+            write64(paddr, (core_lsrt << 8) | (old_word & 0x00000000000000FFLL), &paddr);
+            check_memory(paddr);
         }
         break;
     case 7:
-        address = (core_lsaddr) & 0xFFFFFFF8;
-        dword = core_lsrt;
-        write_dword_in_memory();
-        check_memory();
+        write64(addr & 0xFFFFFFF8, core_lsrt, &paddr);
+        check_memory(paddr);
         break;
     }
 }
 
 void SWR()
 {
-    uint64_t old_word = 0;
+    uint32_t old_word = 0;
+    uint32_t paddr;
     PC++;
-    switch ((core_lsaddr) & 3)
+    const uint32_t addr = core_lsaddr;
+    switch (addr & 3)
     {
     case 0:
-        address = core_lsaddr;
-        rdword = &old_word;
-        read_word_in_memory();
-        if (address)
+        if (read32(addr, old_word, &paddr))
         {
-            word = ((uint32_t)core_lsrt << 24) | (old_word & 0x00FFFFFF);
-            write_word_in_memory();
-            check_memory();
+            write32(paddr, ((uint32_t)core_lsrt << 24) | (old_word & 0x00FFFFFF), &paddr);
+            check_memory(paddr);
         }
         break;
     case 1:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = &old_word;
-        read_word_in_memory();
-        if (address)
+        if (read32(addr & 0xFFFFFFFC, old_word, &paddr))
         {
-            word = ((uint32_t)core_lsrt << 16) | (old_word & 0x0000FFFF);
-            write_word_in_memory();
-            check_memory();
+            write32(paddr, ((uint32_t)core_lsrt << 16) | (old_word & 0x0000FFFF), &paddr);
+            check_memory(paddr);
         }
         break;
     case 2:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        rdword = &old_word;
-        read_word_in_memory();
-        if (address)
+        if (read32(addr & 0xFFFFFFFC, old_word, &paddr))
         {
-            word = ((uint32_t)core_lsrt << 8) | (old_word & 0x000000FF);
-            write_word_in_memory();
-            check_memory();
+            write32(paddr, ((uint32_t)core_lsrt << 8) | (old_word & 0x000000FF), &paddr);
+            check_memory(paddr);
         }
         break;
     case 3:
-        address = (core_lsaddr) & 0xFFFFFFFC;
-        word = (uint32_t)core_lsrt;
-        write_word_in_memory();
-        check_memory();
+        write32(addr & 0xFFFFFFFC, (uint32_t)core_lsrt, &paddr);
+        check_memory(paddr);
         break;
     }
 }
@@ -1362,42 +1213,33 @@ void CACHE()
 void LL()
 {
     PC++;
-    address = core_lsaddr;
-    rdword = (uint64_t *)&core_lsrt;
-    read_word_in_memory();
-    if (address)
+    uint32_t value = (uint32_t)core_lsrt;
+    if (read32(core_lsaddr, value))
     {
-        sign_extended(core_lsrt);
+        core_lsrt = (int32_t)value;
         llbit = 1;
     }
 }
 
 void LWC1()
 {
-    uint64_t temp;
+    uint32_t temp = 0;
     if (check_cop1_unusable()) return;
     PC++;
-    address = core_lslfaddr;
-    rdword = &temp;
-    read_word_in_memory();
-    if (address) *((int32_t *)reg_cop1_simple[core_lslfft]) = *rdword;
+    if (read32(core_lslfaddr, temp)) *((int32_t *)reg_cop1_simple[core_lslfft]) = temp;
 }
 
 void LDC1()
 {
     if (check_cop1_unusable()) return;
     PC++;
-    address = core_lslfaddr;
-    rdword = (uint64_t *)reg_cop1_double[core_lslfft];
-    read_dword_in_memory();
+    read64(core_lslfaddr, *(uint64_t *)reg_cop1_double[core_lslfft]);
 }
 
 void LD()
 {
     PC++;
-    address = core_lsaddr;
-    rdword = (uint64_t *)&core_lsrt;
-    read_dword_in_memory();
+    read64(core_lsaddr, *(uint64_t *)&core_lsrt);
 }
 
 void SC()
@@ -1414,10 +1256,9 @@ void SC()
     PC++;
     if (llbit)
     {
-        address = core_lsaddr;
-        word = (uint32_t)(core_lsrt & 0xFFFFFFFF);
-        write_word_in_memory();
-        check_memory();
+        uint32_t paddr;
+        write32(core_lsaddr, (uint32_t)(core_lsrt & 0xFFFFFFFF), &paddr);
+        check_memory(paddr);
         llbit = 0;
         core_lsrt = 1;
     }
@@ -1431,29 +1272,26 @@ void SWC1()
 {
     if (check_cop1_unusable()) return;
     PC++;
-    address = core_lslfaddr;
-    word = *((int32_t *)reg_cop1_simple[core_lslfft]);
-    write_word_in_memory();
-    check_memory();
+    uint32_t paddr;
+    write32(core_lslfaddr, *((int32_t *)reg_cop1_simple[core_lslfft]), &paddr);
+    check_memory(paddr);
 }
 
 void SDC1()
 {
     if (check_cop1_unusable()) return;
     PC++;
-    address = core_lslfaddr;
-    dword = *((uint64_t *)reg_cop1_double[core_lslfft]);
-    write_dword_in_memory();
-    check_memory();
+    uint32_t paddr;
+    write64(core_lslfaddr, *((uint64_t *)reg_cop1_double[core_lslfft]), &paddr);
+    check_memory(paddr);
 }
 
 void SD()
 {
     PC++;
-    address = core_lsaddr;
-    dword = core_lsrt;
-    write_dword_in_memory();
-    check_memory();
+    uint32_t paddr;
+    write64(core_lsaddr, core_lsrt, &paddr);
+    check_memory(paddr);
 }
 
 void NOTCOMPILED()
@@ -1551,6 +1389,8 @@ inline void jump_to_func()
             blocks[addr >> 12]->code = NULL;
             blocks[addr >> 12]->block = NULL;
             blocks[addr >> 12]->jumps_table = NULL;
+            blocks[addr >> 12]->threaded = NULL;
+            blocks[addr >> 12]->x64_entries = NULL;
         }
         blocks[addr >> 12]->start = addr & ~0xFFF;
         blocks[addr >> 12]->end = (addr & ~0xFFF) + 0x1000;
@@ -1607,6 +1447,8 @@ void init_blocks()
     blocks[0xa4000000 >> 12]->code = NULL;
     blocks[0xa4000000 >> 12]->block = NULL;
     blocks[0xa4000000 >> 12]->jumps_table = NULL;
+    blocks[0xa4000000 >> 12]->threaded = NULL;
+    blocks[0xa4000000 >> 12]->x64_entries = NULL;
     blocks[0xa4000000 >> 12]->start = 0xa4000000;
     blocks[0xa4000000 >> 12]->end = 0xa4001000;
     actual = blocks[0xa4000000 >> 12];
@@ -1614,6 +1456,52 @@ void init_blocks()
     PC = actual->block + (0x40 / 4);
 }
 
+void free_blocks()
+{
+    for (int32_t i = 0; i < 0x100000; i++)
+    {
+        if (blocks[i] != NULL)
+        {
+            if (blocks[i]->block)
+            {
+                free(blocks[i]->block);
+                blocks[i]->block = NULL;
+            }
+            if (blocks[i]->code)
+            {
+                free_exec(blocks[i]->code);
+                blocks[i]->code = NULL;
+            }
+            if (blocks[i]->jumps_table)
+            {
+                free(blocks[i]->jumps_table);
+                blocks[i]->jumps_table = NULL;
+            }
+            if (blocks[i]->threaded)
+            {
+                free(blocks[i]->threaded);
+                blocks[i]->threaded = NULL;
+            }
+            if (blocks[i]->x64_entries)
+            {
+                free(blocks[i]->x64_entries);
+                blocks[i]->x64_entries = NULL;
+            }
+            free(blocks[i]);
+            blocks[i] = NULL;
+        }
+    }
+}
+
+void cached_interpreter()
+{
+    while (!stop)
+    {
+        PC->ops();
+        g_vr_beq_ignore_jmp = false;
+    }
+}
+
 void print_stop_debug()
 {
     g_core->log_info(std::format("PC={:#08x}:{:#08x}", PC->addr, rdram[(PC->addr & 0xFFFFFF) / 4]));
@@ -1859,19 +1747,20 @@ void core_start()
     // next_interrupt = 624999; //this is later overwritten with different value so what's the point...
     init_interrupt();
     interpcore = 0;
+    cop1_sync_float_exception_mode();
 
     // set a default mode if one wasn't set
     // cached interpreter if dynarec disabled
     // dynarec if enabled
-    #if !defined(MUPEN64RR_ENABLE_DYNAREC)
-    if (dynacore > 2) dynacore = 0;
+    #if !defined(MUPEN64RR_ENABLE_DYNAREC) && !defined(MUPEN64RR_ENABLE_DYNAREC_X64)
+    if (dynacore > 3) dynacore = 0;
     #else
-    if (dynacore > 2) dynacore = 1;
+    if (dynacore > 3) dynacore = 1;
     #endif
 
     switch (dynacore)
     {
-    #if !defined(MUPEN64RR_ENABLE_DYNAREC)
+    #if !defined(MUPEN64RR_ENABLE_DYNAREC) && !defined(MUPEN64RR_ENABLE_DYNAREC_X64)
     case 1:
         g_core->log_info("dynarec is disabled, switching to cached interpreter");
     #endif
@@ -1883,11 +1772,7 @@ void core_start()
         core_executing = true;
         g_core->callbacks.core_executing_changed(core_executing);
         g_core->log_info(std::format("core_executing: {}", (bool)core_executing));
-        while (!stop)
-        {
-            PC->ops();
-            g_vr_beq_ignore_jmp = false;
-        }
+        cached_interpreter();
     }
     break;
     #if defined(MUPEN64RR_ENABLE_DYNAREC)
@@ -1903,6 +1788,19 @@ void core_start()
         PC++;
     }
     break;
+    #elif defined(MUPEN64RR_ENABLE_DYNAREC_X64)
+    case 1: {
+        // cached interpreter with the experimental x86-64 integer JIT
+        dynacore = 0;
+        g_core->log_info("interpreter with x86-64 integer JIT");
+        init_blocks();
+        last_addr = PC->addr;
+        core_executing = true;
+        g_core->callbacks.core_executing_changed(core_executing);
+        g_core->log_info(std::format("core_executing: {}", (bool)core_executing));
+        x64_dynarec();
+    }
+    break;
     #endif
     case 2: {
         // pure interpreter
@@ -1911,90 +1809,46 @@ void core_start()
         pure_interpreter();
     }
     break;
+    case 3: {
+        // threaded cached interpreter
+        dynacore = 0;
+        g_core->log_info("threaded interpreter");
+        init_blocks();
+        last_addr = PC->addr;
+        core_executing = true;
+        g_core->callbacks.core_executing_changed(core_executing);
+        g_core->log_info(std::format("core_executing: {}", (bool)core_executing));
+        threaded_interpreter();
+    }
+    break;
     default:
-        g_core->log_error("this should not happen (dynarec > 2).");
+        g_core->log_error("this should not happen (dynarec > 3).");
         abort();
     }
 
     debug_count += core_Count;
     print_stop_debug();
-    for (i = 0; i < 0x100000; i++)
-    {
-        if (blocks[i] != NULL)
-        {
-            if (blocks[i]->block)
-            {
-                free(blocks[i]->block);
-                blocks[i]->block = NULL;
-            }
-            if (blocks[i]->code)
-            {
-                free_exec(blocks[i]->code);
-                blocks[i]->code = NULL;
-            }
-            if (blocks[i]->jumps_table)
-            {
-                free(blocks[i]->jumps_table);
-                blocks[i]->jumps_table = NULL;
-            }
-            free(blocks[i]);
-            blocks[i] = NULL;
-        }
-    }
+    free_blocks();
     if (!dynacore && interpcore) free(PC);
     core_executing = false;
     g_core->callbacks.core_executing_changed(core_executing);
 }
 
-bool open_core_file_stream(const std::filesystem::path &path, FILE **file)
+void clear_save_data()
 {
-    g_core->log_info(std::format("[Core] Opening core stream from {}...", path.string()));
+    if (!savedata_open()) abort();
 
-    if (!exists(path))
-    {
-        FILE *f = nullptr;
-        if (IOUtils::path_fopen_s(f, path, "w"))
-        {
-            return false;
-        }
-        fflush(f);
-        fclose(f);
-    }
-    *file = IOUtils::path_fopen_shared(path, "rb+");
-    return *file != nullptr;
-}
+    memset(sram, 0, sizeof(sram));
+    savedata_write(savedata_sram, sram, 0x8000);
 
-void clear_save_data()
-{
-    // TODO: this assumes the files open.
-    if (!open_core_file_stream(get_eeprom_path(), &g_eeprom_file)) abort();
-    if (!open_core_file_stream(get_sram_path(), &g_sram_file)) abort();
-    if (!open_core_file_stream(get_flashram_path(), &g_fram_file)) abort();
-    if (!open_core_file_stream(get_mempak_path(), &g_mpak_file)) abort();
+    memset(eeprom, 0, sizeof(eeprom));
+    savedata_write(savedata_eeprom, eeprom, 0x800);
 
-    {
-        memset(sram, 0, sizeof(sram));
-        fseek(g_sram_file, 0, SEEK_SET);
-        fwrite(sram, 1, 0x8000, g_sram_file);
-    }
-    {
-        memset(eeprom, 0, sizeof(eeprom));
-        fseek(g_eeprom_file, 0, SEEK_SET);
-        fwrite(eeprom, 1, 0x800, g_eeprom_file);
-    }
-    {
-        fseek(g_mpak_file, 0, SEEK_SET);
-        for (auto buf : mempack)
-        {
-            memset(buf, 0, sizeof(mempack) / 4);
-            fwrite(buf, 1, 0x800, g_mpak_file);
-        }
-    }
+    // Only the first 0x800 bytes of each mempak's worth are cleared, back to back, as it has always been done.
+    memset(mempack, 0, sizeof(mempack));
+    savedata_write(savedata_mempak, mempack, 0x2000);
 
-    fclose(g_eeprom_file);
-    fclose(g_sram_file);
-    fclose(g_fram_file);
-    fclose(g_mpak_file);
+    savedata_close();
 }
 
 void audio_thread()
@@ -2086,14 +1940,7 @@ core_result vr_close_rom_impl(bool stop_vcr)
 
     emu_thread_handle.join();
 
-    fflush(g_eeprom_file);
-    fflush(g_sram_file);
-    fflush(g_fram_file);
-    fflush(g_mpak_file);
-    fclose(g_eeprom_file);
-    fclose(g_sram_file);
-    fclose(g_fram_file);
-    fclose(g_mpak_file);
+    savedata_close();
 
     return Res_Ok;
 }
@@ -2155,11 +2002,8 @@ core_result vr_start_rom_impl(std::filesystem::path path)
         return VR_RomInvalid;
     }
 
-    // Open all the save file streams
-    if (!open_core_file_stream(get_eeprom_path(), &g_eeprom_file) ||
-        !open_core_file_stream(get_sram_path(), &g_sram_file) ||
-        !open_core_file_stream(get_flashram_path(), &g_fram_file) ||
-        !open_core_file_stream(get_mempak_path(), &g_mpak_file))
+    // Load all the save files
+    if (!savedata_open())
     {
         g_core->callbacks.emu_starting_changed(false);
         return VR_FileOpenFailed;
@@ -57,14 +57,15 @@ extern bool g_vr_fast_forward;
 extern bool g_vr_frame_skipped;
 extern core_system_type g_sys_type;
 
-extern FILE *g_eeprom_file;
-extern FILE *g_sram_file;
-extern FILE *g_fram_file;
-extern FILE *g_mpak_file;
 
 extern bool g_vr_benchmark_enabled;
 
 void pure_interpreter();
+void cached_interpreter();
+void threaded_interpreter();
+void x64_dynarec();
+void init_blocks();
+void free_blocks();
 extern void jump_to_func();
 void update_count();
 int32_t check_cop1_unusable();
@@ -73,6 +74,10 @@ void critical_stop(std::string_view message = "Unknown error");
 core_result vr_reset_rom_impl(bool reset_save_data, bool stop_vcr, bool skip_reset_recording_check = false);
 
 std::filesystem::path vr_get_rom_path();
+std::filesystem::path get_sram_path();
+std::filesystem::path get_eeprom_path();
+std::filesystem::path get_flashram_path();
+std::filesystem::path get_mempak_path();
 bool vr_get_core_executing();
 bool vr_get_launched();
 void vr_frame_advance(size_t count);
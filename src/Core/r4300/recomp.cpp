@@ -7,6 +7,7 @@
 #include <CommonPCH.h>
 #include <Core.h>
 #include <memory/memory.h>
+#include <r4300/cop1_helpers.h>
 #include <r4300/macros.h>
 #include <r4300/ops.h>
 #include <r4300/r4300.h>
@@ -1195,7 +1196,7 @@ static void (*recomp_bc[4])(void) = {RBC1F, RBC1T, RBC1FL, RBC1TL};
 
 static void RADD_S()
 {
-    dst->ops = ADD_S;
+    dst->ops = COP1_OP(ADD_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genadd_s();
@@ -1204,7 +1205,7 @@ static void RADD_S()
 
 static void RSUB_S()
 {
-    dst->ops = SUB_S;
+    dst->ops = COP1_OP(SUB_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gensub_s();
@@ -1213,7 +1214,7 @@ static void RSUB_S()
 
 static void RMUL_S()
 {
-    dst->ops = MUL_S;
+    dst->ops = COP1_OP(MUL_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genmul_s();
@@ -1222,7 +1223,7 @@ static void RMUL_S()
 
 static void RDIV_S()
 {
-    dst->ops = DIV_S;
+    dst->ops = COP1_OP(DIV_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gendiv_s();
@@ -1231,7 +1232,7 @@ static void RDIV_S()
 
 static void RSQRT_S()
 {
-    dst->ops = SQRT_S;
+    dst->ops = COP1_OP(SQRT_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gensqrt_s();
@@ -1240,7 +1241,7 @@ static void RSQRT_S()
 
 static void RABS_S()
 {
-    dst->ops = ABS_S;
+    dst->ops = COP1_OP(ABS_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genabs_s();
@@ -1258,7 +1259,7 @@ static void RMOV_S()
 
 static void RNEG_S()
 {
-    dst->ops = NEG_S;
+    dst->ops = COP1_OP(NEG_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genneg_s();
@@ -1267,7 +1268,7 @@ static void RNEG_S()
 
 static void RROUND_L_S()
 {
-    dst->ops = ROUND_L_S;
+    dst->ops = COP1_OP(ROUND_L_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genround_l_s();
@@ -1276,7 +1277,7 @@ static void RROUND_L_S()
 
 static void RTRUNC_L_S()
 {
-    dst->ops = TRUNC_L_S;
+    dst->ops = COP1_OP(TRUNC_L_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gentrunc_l_s();
@@ -1285,7 +1286,7 @@ static void RTRUNC_L_S()
 
 static void RCEIL_L_S()
 {
-    dst->ops = CEIL_L_S;
+    dst->ops = COP1_OP(CEIL_L_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genceil_l_s();
@@ -1294,7 +1295,7 @@ static void RCEIL_L_S()
 
 static void RFLOOR_L_S()
 {
-    dst->ops = FLOOR_L_S;
+    dst->ops = COP1_OP(FLOOR_L_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genfloor_l_s();
@@ -1303,7 +1304,7 @@ static void RFLOOR_L_S()
 
 static void RROUND_W_S()
 {
-    dst->ops = ROUND_W_S;
+    dst->ops = COP1_OP(ROUND_W_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genround_w_s();
@@ -1312,7 +1313,7 @@ static void RROUND_W_S()
 
 static void RTRUNC_W_S()
 {
-    dst->ops = TRUNC_W_S;
+    dst->ops = COP1_OP(TRUNC_W_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gentrunc_w_s();
@@ -1321,7 +1322,7 @@ static void RTRUNC_W_S()
 
 static void RCEIL_W_S()
 {
-    dst->ops = CEIL_W_S;
+    dst->ops = COP1_OP(CEIL_W_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genceil_w_s();
@@ -1330,7 +1331,7 @@ static void RCEIL_W_S()
 
 static void RFLOOR_W_S()
 {
-    dst->ops = FLOOR_W_S;
+    dst->ops = COP1_OP(FLOOR_W_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genfloor_w_s();
@@ -1339,7 +1340,7 @@ static void RFLOOR_W_S()
 
 static void RCVT_D_S()
 {
-    dst->ops = CVT_D_S;
+    dst->ops = COP1_OP(CVT_D_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gencvt_d_s();
@@ -1348,7 +1349,7 @@ static void RCVT_D_S()
 
 static void RCVT_W_S()
 {
-    dst->ops = CVT_W_S;
+    dst->ops = COP1_OP(CVT_W_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gencvt_w_s();
@@ -1357,7 +1358,7 @@ static void RCVT_W_S()
 
 static void RCVT_L_S()
 {
-    dst->ops = CVT_L_S;
+    dst->ops = COP1_OP(CVT_L_S);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gencvt_l_s();
@@ -1523,7 +1524,7 @@ static void (*recomp_s[64])(void) = {
 
 static void RADD_D()
 {
-    dst->ops = ADD_D;
+    dst->ops = COP1_OP(ADD_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genadd_d();
@@ -1532,7 +1533,7 @@ static void RADD_D()
 
 static void RSUB_D()
 {
-    dst->ops = SUB_D;
+    dst->ops = COP1_OP(SUB_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gensub_d();
@@ -1541,7 +1542,7 @@ static void RSUB_D()
 
 static void RMUL_D()
 {
-    dst->ops = MUL_D;
+    dst->ops = COP1_OP(MUL_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genmul_d();
@@ -1550,7 +1551,7 @@ static void RMUL_D()
 
 static void RDIV_D()
 {
-    dst->ops = DIV_D;
+    dst->ops = COP1_OP(DIV_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gendiv_d();
@@ -1559,7 +1560,7 @@ static void RDIV_D()
 
 static void RSQRT_D()
 {
-    dst->ops = SQRT_D;
+    dst->ops = COP1_OP(SQRT_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gensqrt_d();
@@ -1568,7 +1569,7 @@ static void RSQRT_D()
 
 static void RABS_D()
 {
-    dst->ops = ABS_D;
+    dst->ops = COP1_OP(ABS_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genabs_d();
@@ -1586,7 +1587,7 @@ static void RMOV_D()
 
 static void RNEG_D()
 {
-    dst->ops = NEG_D;
+    dst->ops = COP1_OP(NEG_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genneg_d();
@@ -1595,7 +1596,7 @@ static void RNEG_D()
 
 static void RROUND_L_D()
 {
-    dst->ops = ROUND_L_D;
+    dst->ops = COP1_OP(ROUND_L_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genround_l_d();
@@ -1604,7 +1605,7 @@ static void RROUND_L_D()
 
 static void RTRUNC_L_D()
 {
-    dst->ops = TRUNC_L_D;
+    dst->ops = COP1_OP(TRUNC_L_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gentrunc_l_d();
@@ -1613,7 +1614,7 @@ static void RTRUNC_L_D()
 
 static void RCEIL_L_D()
 {
-    dst->ops = CEIL_L_D;
+    dst->ops = COP1_OP(CEIL_L_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genceil_l_d();
@@ -1622,7 +1623,7 @@ static void RCEIL_L_D()
 
 static void RFLOOR_L_D()
 {
-    dst->ops = FLOOR_L_D;
+    dst->ops = COP1_OP(FLOOR_L_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genfloor_l_d();
@@ -1631,7 +1632,7 @@ static void RFLOOR_L_D()
 
 static void RROUND_W_D()
 {
-    dst->ops = ROUND_W_D;
+    dst->ops = COP1_OP(ROUND_W_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genround_w_d();
@@ -1640,7 +1641,7 @@ static void RROUND_W_D()
 
 static void RTRUNC_W_D()
 {
-    dst->ops = TRUNC_W_D;
+    dst->ops = COP1_OP(TRUNC_W_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gentrunc_w_d();
@@ -1649,7 +1650,7 @@ static void RTRUNC_W_D()
 
 static void RCEIL_W_D()
 {
-    dst->ops = CEIL_W_D;
+    dst->ops = COP1_OP(CEIL_W_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genceil_w_d();
@@ -1658,7 +1659,7 @@ static void RCEIL_W_D()
 
 static void RFLOOR_W_D()
 {
-    dst->ops = FLOOR_W_D;
+    dst->ops = COP1_OP(FLOOR_W_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) genfloor_w_d();
@@ -1667,7 +1668,7 @@ static void RFLOOR_W_D()
 
 static void RCVT_S_D()
 {
-    dst->ops = CVT_S_D;
+    dst->ops = COP1_OP(CVT_S_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gencvt_s_d();
@@ -1676,7 +1677,7 @@ static void RCVT_S_D()
 
 static void RCVT_W_D()
 {
-    dst->ops = CVT_W_D;
+    dst->ops = COP1_OP(CVT_W_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gencvt_w_d();
@@ -1685,7 +1686,7 @@ static void RCVT_W_D()
 
 static void RCVT_L_D()
 {
-    dst->ops = CVT_L_D;
+    dst->ops = COP1_OP(CVT_L_D);
     recompile_standard_cf_type();
 #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore) gencvt_l_d();
@@ -2821,6 +2822,10 @@ void init_block(int32_t *source, precomp_block *block)
             dst->ops = NOTCOMPILED;
         }
     }
+    threaded_invalidate(block);
+    #ifdef MUPEN64RR_ENABLE_DYNAREC_X64
+    x64_invalidate(block);
+    #endif
     #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore)
     {
@@ -2848,6 +2853,8 @@ void init_block(int32_t *source, precomp_block *block)
             blocks[paddr >> 12]->code = NULL;
             blocks[paddr >> 12]->block = NULL;
             blocks[paddr >> 12]->jumps_table = NULL;
+            blocks[paddr >> 12]->threaded = NULL;
+            blocks[paddr >> 12]->x64_entries = NULL;
             blocks[paddr >> 12]->start = paddr & ~0xFFF;
             blocks[paddr >> 12]->end = (paddr & ~0xFFF) + 0x1000;
         }
@@ -2861,6 +2868,8 @@ void init_block(int32_t *source, precomp_block *block)
             blocks[paddr >> 12]->code = NULL;
             blocks[paddr >> 12]->block = NULL;
             blocks[paddr >> 12]->jumps_table = NULL;
+            blocks[paddr >> 12]->threaded = NULL;
+            blocks[paddr >> 12]->x64_entries = NULL;
             blocks[paddr >> 12]->start = paddr & ~0xFFF;
             blocks[paddr >> 12]->end = (paddr & ~0xFFF) + 0x1000;
         }
@@ -2876,6 +2885,8 @@ void init_block(int32_t *source, precomp_block *block)
                 blocks[(block->start + 0x20000000) >> 12]->code = NULL;
                 blocks[(block->start + 0x20000000) >> 12]->block = NULL;
                 blocks[(block->start + 0x20000000) >> 12]->jumps_table = NULL;
+                blocks[(block->start + 0x20000000) >> 12]->threaded = NULL;
+                blocks[(block->start + 0x20000000) >> 12]->x64_entries = NULL;
                 blocks[(block->start + 0x20000000) >> 12]->start = (block->start + 0x20000000) & ~0xFFF;
                 blocks[(block->start + 0x20000000) >> 12]->end = ((block->start + 0x20000000) & ~0xFFF) + 0x1000;
             }
@@ -2889,6 +2900,8 @@ void init_block(int32_t *source, precomp_block *block)
                 blocks[(block->start - 0x20000000) >> 12]->code = NULL;
                 blocks[(block->start - 0x20000000) >> 12]->block = NULL;
                 blocks[(block->start - 0x20000000) >> 12]->jumps_table = NULL;
+                blocks[(block->start - 0x20000000) >> 12]->threaded = NULL;
+                blocks[(block->start - 0x20000000) >> 12]->x64_entries = NULL;
                 blocks[(block->start - 0x20000000) >> 12]->start = (block->start - 0x20000000) & ~0xFFF;
                 blocks[(block->start - 0x20000000) >> 12]->end = ((block->start - 0x20000000) & ~0xFFF) + 0x1000;
             }
@@ -2907,6 +2920,10 @@ void recompile_block(int32_t *source, precomp_block *block, uint32_t func)
     dst_block = block;
 
     block->hash = 0;
+    threaded_invalidate(block);
+    #ifdef MUPEN64RR_ENABLE_DYNAREC_X64
+    x64_invalidate(block);
+    #endif
 
     #ifdef MUPEN64RR_ENABLE_DYNAREC
     if (dynacore)
@@ -2939,7 +2956,7 @@ void recompile_block(int32_t *source, precomp_block *block, uint32_t func)
         dst->reg_cache_infos.need_map = 0;
         dst->local_addr = code_length;
         recomp_ops[((src >> 26) & 0x3F)]();
-        if (g_ctx.tl_active())
+        if (g_ctx.tl_active() && tracelog_is_traced(dst->addr, src))
         {
             dst->s_ops = dst->ops;
             dst->ops = tracelog_log_interp_ops;
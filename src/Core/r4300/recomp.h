@@ -56,6 +56,34 @@ typedef struct _precomp_instr
     uint32_t src;
 } precomp_instr;
 
+// The operations of the threaded interpreter. TRANSLATE marks entries which haven't been translated yet, and FALLBACK
+// ones which run their precomp_instr's ops.
+#define THREADED_OPS(X)                                                                                                \
+    X(TRANSLATE) X(FALLBACK) X(NOP) X(SLL) X(SRL) X(SRA) X(SLLV) X(SRLV) X(SRAV) X(MFHI) X(MTHI) X(MFLO)               \
+    X(MTLO) X(DSLLV) X(DSRLV) X(DSRAV) X(ADDU) X(SUBU) X(AND) X(OR) X(XOR) X(NOR) X(SLT) X(SLTU) X(DADDU)              \
+    X(DSUBU) X(DSLL) X(DSRL) X(DSRA) X(DSLL32) X(DSRL32) X(DSRA32) X(ADDIU) X(SLTI) X(SLTIU) X(ANDI) X(ORI)            \
+    X(XORI) X(LUI) X(LUI_ADDIU) X(LUI_ORI)
+
+enum : uint8_t
+{
+#define THREADED_ENUM(name) TI_##name,
+    THREADED_OPS(THREADED_ENUM)
+#undef THREADED_ENUM
+};
+
+/**
+ * \brief A compact instruction used by the threaded interpreter.
+ * Register operands are indices into <c>reg</c>, and <c>imm</c> holds the decoded immediate or shift amount.
+ */
+typedef struct _threaded_instr
+{
+    uint8_t op;
+    uint8_t rd;
+    uint8_t rs;
+    uint8_t rt;
+    int32_t imm;
+} threaded_instr;
+
 typedef struct _precomp_block
 {
     precomp_instr *block;
@@ -67,10 +95,32 @@ typedef struct _precomp_block
     void *jumps_table;
     int32_t jumps_number;
     uint64_t hash;
+    threaded_instr *threaded;
+
+    /// The entry points into the x86-64 dynamic recompiler's code, indexed like <c>block</c>. Entries are null until
+    /// compiled, and X64_FALLBACK_ENTRY for instructions which can't start a run of compiled code.
+    void **x64_entries;
 } precomp_block;
 
 void recompile_block(int32_t *source, precomp_block *block, uint32_t func);
 void init_block(int32_t *source, precomp_block *block);
+void threaded_invalidate(precomp_block *block);
+
+/**
+ * \brief Translates a compiled instruction into its threaded form.
+ * \param inst The instruction.
+ * \param out Receives the translation. Its op is never TI_FALLBACK or one of the fused ops.
+ * \return Whether the instruction has a threaded form. If not, it has to be run through its ops.
+ */
+bool threaded_translate(const precomp_instr *inst, threaded_instr &out);
+
+inline void *const X64_FALLBACK_ENTRY = (void *)1;
+
+/**
+ * \brief Drops the x86-64 dynamic recompiler's code for a block.
+ */
+void x64_invalidate(precomp_block *block);
+
 void recompile_opcode();
 void prefetch_opcode(uint32_t op);
 void dyna_jump();
@@ -161,11 +161,16 @@ bool rom_load(std::filesystem::path path)
     }
 
     rom_size = decompressed_rom.size();
-    uint32_t taille = rom_size;
+
+    // The ROM is accessed in whole words (DMA, byte swizzling), so a ROM whose size isn't a multiple of 4 is padded with
+    // zeros up to the next word instead of being read past its allocation.
+    const uint32_t padded_size = (rom_size + 3) & ~3;
+    uint32_t taille = padded_size;
     if (g_core->cfg->use_summercart && taille < 0x4000000) taille = 0x4000000;
 
     g_ctx.rom = rom = (unsigned char *)malloc(taille);
     memcpy(rom, decompressed_rom.data(), rom_size);
+    memset(rom + rom_size, 0, padded_size - rom_size);
 
     uint8_t tmp;
     if (rom[0] == 0x37)
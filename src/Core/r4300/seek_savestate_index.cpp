@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <Core.h>
+#include <r4300/seek_savestate_index.h>
+
+std::vector<t_seek_savestate>::iterator t_seek_savestate_index::lower_bound(const size_t frame)
+{
+    return std::ranges::lower_bound(m_entries, frame, {}, &t_seek_savestate::frame);
+}
+
+std::vector<t_seek_savestate>::const_iterator t_seek_savestate_index::lower_bound(const size_t frame) const
+{
+    return std::ranges::lower_bound(m_entries, frame, {}, &t_seek_savestate::frame);
+}
+
+const t_seek_savestate *t_seek_savestate_index::find(const size_t frame) const
+{
+    const auto it = lower_bound(frame);
+    return it != m_entries.end() && it->frame == frame ? &*it : nullptr;
+}
+
+const t_seek_savestate *t_seek_savestate_index::find_before(const size_t frame) const
+{
+    const auto it = lower_bound(frame);
+    return it != m_entries.begin() ? &*std::prev(it) : nullptr;
+}
+
+std::span<const t_seek_savestate> t_seek_savestate_index::range(const size_t first, const size_t last) const
+{
+    if (first >= last)
+    {
+        return {};
+    }
+    return {lower_bound(first), lower_bound(last)};
+}
+
+const t_seek_savestate &t_seek_savestate_index::insert(const size_t frame, std::vector<uint8_t> data,
+                                                       std::shared_ptr<const std::vector<uint8_t>> keyframe)
+{
+    auto it = lower_bound(frame);
+    if (it != m_entries.end() && it->frame == frame)
+    {
+        it->data = std::move(data);
+        it->keyframe = std::move(keyframe);
+        it->last_use = ++m_use_counter;
+        return *it;
+    }
+    t_seek_savestate st{
+        .frame = frame, .data = std::move(data), .keyframe = std::move(keyframe), .last_use = ++m_use_counter};
+    return *m_entries.insert(it, std::move(st));
+}
+
+void t_seek_savestate_index::touch(const size_t frame)
+{
+    const auto it = lower_bound(frame);
+    if (it != m_entries.end() && it->frame == frame)
+    {
+        it->last_use = ++m_use_counter;
+    }
+}
+
+bool t_seek_savestate_index::erase(const size_t frame)
+{
+    const auto it = lower_bound(frame);
+    if (it == m_entries.end() || it->frame != frame)
+    {
+        return false;
+    }
+    m_entries.erase(it);
+    return true;
+}
+
+std::vector<size_t> t_seek_savestate_index::erase_range(const size_t first, const size_t last)
+{
+    if (first >= last)
+    {
+        return {};
+    }
+
+    const auto begin = lower_bound(first);
+    const auto end = lower_bound(last);
+
+    std::vector<size_t> frames;
+    frames.reserve(end - begin);
+    for (auto it = begin; it != end; ++it)
+    {
+        frames.push_back(it->frame);
+    }
+
+    m_entries.erase(begin, end);
+    return frames;
+}
+
+std::optional<size_t> t_seek_savestate_index::pick_eviction(const core_seek_savestate_eviction policy,
+                                                            const size_t current_frame) const
+{
+    // The entries are sorted, so the savestate at frame 0 can only be the first one.
+    const auto first = !m_entries.empty() && m_entries.front().frame == 0 ? 1 : 0;
+    if (first >= m_entries.size())
+    {
+        return std::nullopt;
+    }
+
+    switch (policy)
+    {
+    case core_seek_savestate_eviction_lru: {
+        const auto it = std::ranges::min_element(m_entries.begin() + first, m_entries.end(), {},
+                                                 &t_seek_savestate::last_use);
+        return it->frame;
+    }
+    case core_seek_savestate_eviction_thinning: {
+        // Exponential spacing means the gap around a savestate is proportional to its distance from the current
+        // frame. Evict the savestate whose removal leaves the smallest gap relative to that distance, which is the one
+        // in the most densely covered region.
+        size_t victim = m_entries[first].frame;
+        double lowest_score = DBL_MAX;
+        for (size_t i = first; i < m_entries.size(); ++i)
+        {
+            const auto frame = m_entries[i].frame;
+            const auto prev = i > 0 ? m_entries[i - 1].frame : 0;
+            const auto next = i + 1 < m_entries.size() ? m_entries[i + 1].frame : std::max(current_frame, frame);
+            const auto distance = current_frame > frame ? current_frame - frame : 1;
+
+            const auto score = (double)(next - prev) / (double)distance;
+            if (score < lowest_score)
+            {
+                lowest_score = score;
+                victim = frame;
+            }
+        }
+        return victim;
+    }
+    default:
+        return m_entries[first].frame;
+    }
+}
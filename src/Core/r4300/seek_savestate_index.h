@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <core_api.h>
+
+/**
+ * \brief A seek savestate stored in a seek savestate index.
+ */
+struct t_seek_savestate
+{
+    /// The frame the savestate was created at.
+    size_t frame;
+
+    /// The savestate, stored as a delta against keyframe. See st_delta.h.
+    std::vector<uint8_t> data;
+
+    /// The raw savestate the delta is encoded against. Shared between all savestates encoded against it.
+    std::shared_ptr<const std::vector<uint8_t>> keyframe;
+
+    /// The index's use counter value when the savestate was last created or loaded.
+    uint64_t last_use;
+};
+
+/**
+ * \brief Seek savestates ordered by frame.
+ *
+ * The savestates are kept in a vector sorted by frame, which makes lookups, predecessor queries and range queries
+ * O(log n) and keeps iteration cache-friendly. Insertions and removals move the entries after the affected one, which
+ * is cheap since an entry's data lives on the heap.
+ */
+class t_seek_savestate_index
+{
+  public:
+    using iterator = std::vector<t_seek_savestate>::const_iterator;
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+    iterator begin() const { return m_entries.begin(); }
+    iterator end() const { return m_entries.end(); }
+
+    /**
+     * \brief Gets the savestate at the specified frame.
+     * \return The savestate, or nullptr if there is none at the frame.
+     */
+    const t_seek_savestate *find(size_t frame) const;
+
+    /**
+     * \brief Gets whether a savestate exists at the specified frame.
+     */
+    bool contains(const size_t frame) const { return find(frame) != nullptr; }
+
+    /**
+     * \brief Gets the closest savestate before the specified frame.
+     * \return The savestate, or nullptr if there is none before the frame.
+     */
+    const t_seek_savestate *find_before(size_t frame) const;
+
+    /**
+     * \brief Gets the savestates whose frames lie in the range [first, last).
+     */
+    std::span<const t_seek_savestate> range(size_t first, size_t last) const;
+
+    /**
+     * \brief Adds a savestate at the specified frame, replacing the existing one if there is one.
+     * \param frame The frame the savestate was created at.
+     * \param data The savestate's delta.
+     * \param keyframe The raw savestate the delta is encoded against.
+     * \return The stored savestate.
+     */
+    const t_seek_savestate &insert(size_t frame, std::vector<uint8_t> data,
+                                   std::shared_ptr<const std::vector<uint8_t>> keyframe = nullptr);
+
+    /**
+     * \brief Marks the savestate at the specified frame as used, which keeps it from being evicted under the LRU
+     * policy.
+     */
+    void touch(size_t frame);
+
+    /**
+     * \brief Removes the savestate at the specified frame, if there is one.
+     * \return Whether a savestate was removed.
+     */
+    bool erase(size_t frame);
+
+    /**
+     * \brief Removes all savestates whose frames lie in the range [first, last).
+     * \return The frames of the removed savestates.
+     */
+    std::vector<size_t> erase_range(size_t first, size_t last);
+
+    /**
+     * \brief Removes all savestates.
+     */
+    void clear() { m_entries.clear(); }
+
+    /**
+     * \brief Picks the savestate to evict when the index is full. The savestate at frame 0 is never picked, as it's
+     * required for seeking back to the start of the movie.
+     * \param policy The eviction policy.
+     * \param current_frame The current frame, used by the thinning policy.
+     * \return The frame of the savestate to evict, or nullopt if there is no savestate which can be evicted.
+     */
+    std::optional<size_t> pick_eviction(core_seek_savestate_eviction policy, size_t current_frame) const;
+
+  private:
+    std::vector<t_seek_savestate>::iterator lower_bound(size_t frame);
+    std::vector<t_seek_savestate>::const_iterator lower_bound(size_t frame) const;
+
+    std::vector<t_seek_savestate> m_entries;
+    uint64_t m_use_counter{};
+};
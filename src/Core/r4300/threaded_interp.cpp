@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <Core.h>
+#include <r4300/ops.h>
+#include <r4300/r4300.h>
+#include <r4300/recomp.h>
+
+// The threaded interpreter runs the same blocks as the cached interpreter, but executes the common integer instructions
+// from a compact per-block stream instead of calling through every precomp_instr's function pointer. Everything else
+// (jumps, branches, memory accesses, coprocessors, ...) falls back to the regular ops, so behaviour stays identical to
+// the cached interpreter.
+//
+// Entries are translated lazily from the precomp_instr they shadow and reset whenever the block is (re)compiled.
+// Fallback entries always call the current ops of their precomp_instr, so only native translations can go stale.
+
+#if defined(__GNUC__) || defined(__clang__)
+#define THREADED_COMPUTED_GOTO
+#endif
+
+enum t_operand_form : uint8_t
+{
+    FORM_NONE,
+    FORM_R,
+    FORM_I,
+    FORM_I_UNSIGNED,
+};
+
+struct t_translation
+{
+    void (*ops)();
+    uint8_t op;
+    t_operand_form form;
+};
+
+// The cached interpreter implements ADD, SUB, DADD, DSUB and ADDI without overflow traps, so they share the unsigned
+// variants' handlers.
+static const t_translation translations[] = {
+    {NOP, TI_NOP, FORM_NONE},       {SYNC, TI_NOP, FORM_NONE},      {SLL, TI_SLL, FORM_R},
+    {SRL, TI_SRL, FORM_R},          {SRA, TI_SRA, FORM_R},          {SLLV, TI_SLLV, FORM_R},
+    {SRLV, TI_SRLV, FORM_R},        {SRAV, TI_SRAV, FORM_R},        {MFHI, TI_MFHI, FORM_R},
+    {MTHI, TI_MTHI, FORM_R},        {MFLO, TI_MFLO, FORM_R},        {MTLO, TI_MTLO, FORM_R},
+    {DSLLV, TI_DSLLV, FORM_R},      {DSRLV, TI_DSRLV, FORM_R},      {DSRAV, TI_DSRAV, FORM_R},
+    {ADD, TI_ADDU, FORM_R},         {ADDU, TI_ADDU, FORM_R},        {SUB, TI_SUBU, FORM_R},
+    {SUBU, TI_SUBU, FORM_R},        {AND, TI_AND, FORM_R},          {OR, TI_OR, FORM_R},
+    {XOR, TI_XOR, FORM_R},          {NOR, TI_NOR, FORM_R},          {SLT, TI_SLT, FORM_R},
+    {SLTU, TI_SLTU, FORM_R},        {DADD, TI_DADDU, FORM_R},       {DADDU, TI_DADDU, FORM_R},
+    {DSUB, TI_DSUBU, FORM_R},       {DSUBU, TI_DSUBU, FORM_R},      {DSLL, TI_DSLL, FORM_R},
+    {DSRL, TI_DSRL, FORM_R},        {DSRA, TI_DSRA, FORM_R},        {DSLL32, TI_DSLL32, FORM_R},
+    {DSRL32, TI_DSRL32, FORM_R},    {DSRA32, TI_DSRA32, FORM_R},    {ADDI, TI_ADDIU, FORM_I},
+    {ADDIU, TI_ADDIU, FORM_I},      {SLTI, TI_SLTI, FORM_I},        {SLTIU, TI_SLTIU, FORM_I},
+    {ANDI, TI_ANDI, FORM_I_UNSIGNED}, {ORI, TI_ORI, FORM_I_UNSIGNED}, {XORI, TI_XORI, FORM_I_UNSIGNED},
+    {LUI, TI_LUI, FORM_I},
+};
+
+/**
+ * \brief Gets the amount of instructions a block holds, including the overflow area past its end.
+ */
+static size_t block_length(const precomp_block *block)
+{
+    const size_t length = (block->end - block->start) / 4;
+    return (length + 1) + (length >> 2);
+}
+
+/**
+ * \brief Converts a register pointer from a precomp_instr into an index into <c>reg</c>.
+ * \return Whether the pointer points into <c>reg</c>.
+ */
+static bool reg_index(const int64_t *ptr, uint8_t &index)
+{
+    const auto offset = (uintptr_t)ptr - (uintptr_t)reg;
+    if (offset >= sizeof(reg) || offset % sizeof(reg[0]))
+    {
+        return false;
+    }
+    index = (uint8_t)(offset / sizeof(reg[0]));
+    return true;
+}
+
+bool threaded_translate(const precomp_instr *inst, threaded_instr &out)
+{
+    for (const auto &translation : translations)
+    {
+        if (translation.ops != inst->ops)
+        {
+            continue;
+        }
+
+        out = {};
+        bool valid = true;
+        switch (translation.form)
+        {
+        case FORM_R:
+            valid = reg_index(inst->f.r.rd, out.rd) && reg_index(inst->f.r.rs, out.rs) &&
+                    reg_index(inst->f.r.rt, out.rt);
+            out.imm = inst->f.r.sa;
+            break;
+        case FORM_I:
+            valid = reg_index(inst->f.i.rs, out.rs) && reg_index(inst->f.i.rt, out.rt);
+            out.imm = inst->f.i.immediate;
+            break;
+        case FORM_I_UNSIGNED:
+            valid = reg_index(inst->f.i.rs, out.rs) && reg_index(inst->f.i.rt, out.rt);
+            out.imm = (uint16_t)inst->f.i.immediate;
+            break;
+        default:
+            break;
+        }
+
+        if (!valid)
+        {
+            return false;
+        }
+
+        out.op = translation.op;
+        if (out.op == TI_LUI)
+        {
+            out.imm = (int32_t)((uint32_t)out.imm << 16);
+        }
+        return true;
+    }
+    return false;
+}
+
+static void translate_one(const precomp_block *block, const size_t index)
+{
+    threaded_instr *ti = &block->threaded[index];
+    if (!threaded_translate(&block->block[index], *ti))
+    {
+        *ti = {.op = TI_FALLBACK};
+    }
+}
+
+/**
+ * \brief Translates the instruction at the specified index of a block, fusing it with the following instruction when
+ * possible.
+ */
+static void translate(const precomp_block *block, const size_t index)
+{
+    translate_one(block, index);
+
+    threaded_instr *ti = &block->threaded[index];
+    if (ti->op != TI_LUI)
+    {
+        return;
+    }
+
+    // The entries past the block's end are only initialized once compiled, so we can't look ahead into them.
+    if (index + 1 >= (block->end - block->start) / 4)
+    {
+        return;
+    }
+
+    threaded_instr *next = ti + 1;
+    if (next->op == TI_TRANSLATE)
+    {
+        translate_one(block, index + 1);
+    }
+
+    // LUI followed by an ADDIU or ORI on the same register is how constants and addresses are built.
+    if (next->rs != ti->rt)
+    {
+        return;
+    }
+    if (next->op == TI_ADDIU)
+    {
+        ti->op = TI_LUI_ADDIU;
+    }
+    else if (next->op == TI_ORI)
+    {
+        ti->op = TI_LUI_ORI;
+    }
+}
+
+/**
+ * \brief Gets the threaded instruction shadowing <c>PC</c>, or nullptr if <c>PC</c> isn't part of the current block.
+ */
+static threaded_instr *lookup()
+{
+    precomp_block *block = actual;
+    if (!block || !block->block)
+    {
+        return nullptr;
+    }
+
+    const size_t length = block_length(block);
+    const auto offset = (uintptr_t)PC - (uintptr_t)block->block;
+    if (offset >= length * sizeof(precomp_instr) || offset % sizeof(precomp_instr))
+    {
+        return nullptr;
+    }
+
+    if (!block->threaded)
+    {
+        block->threaded = (threaded_instr *)malloc((length + 1) * sizeof(threaded_instr));
+        threaded_invalidate(block);
+    }
+
+    return block->threaded + offset / sizeof(precomp_instr);
+}
+
+void threaded_invalidate(precomp_block *block)
+{
+    if (!block->threaded)
+    {
+        return;
+    }
+
+    const size_t length = block_length(block);
+    memset(block->threaded, 0, length * sizeof(threaded_instr));
+
+    // Sentinel for running off the end of the block, which behaves like the cached interpreter would.
+    block->threaded[length] = {.op = TI_FALLBACK};
+}
+
+#define R_RD reg[ti->rd]
+#define R_RS reg[ti->rs]
+#define R_RT reg[ti->rt]
+#define R_RS32 ((uint32_t)reg[ti->rs])
+#define R_RT32 ((uint32_t)reg[ti->rt])
+#define SEXT32(x) (int64_t)(int32_t)(x)
+
+#define NEXT(n)                                                                                                        \
+    PC += (n);                                                                                                         \
+    ti += (n);                                                                                                         \
+    DISPATCH()
+
+#ifdef THREADED_COMPUTED_GOTO
+#define DISPATCH() goto *labels[ti->op]
+#define OP(name) ti_##name
+#else
+#define DISPATCH() goto dispatch
+#define OP(name) case TI_##name
+#endif
+
+void threaded_interpreter()
+{
+#ifdef THREADED_COMPUTED_GOTO
+#define THREADED_LABEL(name) &&ti_##name,
+    static void *const labels[] = {THREADED_OPS(THREADED_LABEL)};
+#undef THREADED_LABEL
+#endif
+
+    threaded_instr *ti;
+
+enter:
+    while (!stop)
+    {
+        ti = lookup();
+        if (ti)
+        {
+            DISPATCH();
+        }
+        PC->ops();
+        g_vr_beq_ignore_jmp = false;
+    }
+    return;
+
+#ifndef THREADED_COMPUTED_GOTO
+dispatch:
+    switch (ti->op)
+    {
+#endif
+    OP(TRANSLATE):
+        translate(actual, ti - actual->threaded);
+        DISPATCH();
+    OP(FALLBACK):
+        PC->ops();
+        g_vr_beq_ignore_jmp = false;
+        goto enter;
+    OP(NOP):
+        NEXT(1);
+    OP(SLL):
+        R_RD = SEXT32(R_RT32 << ti->imm);
+        NEXT(1);
+    OP(SRL):
+        R_RD = SEXT32(R_RT32 >> ti->imm);
+        NEXT(1);
+    OP(SRA):
+        R_RD = SEXT32((int32_t)R_RT32 >> ti->imm);
+        NEXT(1);
+    OP(SLLV):
+        R_RD = SEXT32(R_RT32 << (R_RS32 & 0x1F));
+        NEXT(1);
+    OP(SRLV):
+        R_RD = SEXT32(R_RT32 >> (R_RS32 & 0x1F));
+        NEXT(1);
+    OP(SRAV):
+        R_RD = SEXT32((int32_t)R_RT32 >> (R_RS32 & 0x1F));
+        NEXT(1);
+    OP(MFHI):
+        R_RD = hi;
+        NEXT(1);
+    OP(MTHI):
+        hi = R_RS;
+        NEXT(1);
+    OP(MFLO):
+        R_RD = lo;
+        NEXT(1);
+    OP(MTLO):
+        lo = R_RS;
+        NEXT(1);
+    OP(DSLLV):
+        R_RD = (int64_t)((uint64_t)R_RT << (R_RS32 & 0x3F));
+        NEXT(1);
+    OP(DSRLV):
+        R_RD = (int64_t)((uint64_t)R_RT >> (R_RS32 & 0x3F));
+        NEXT(1);
+    OP(DSRAV):
+        R_RD = R_RT >> (R_RS32 & 0x3F);
+        NEXT(1);
+    OP(ADDU):
+        R_RD = SEXT32(R_RS32 + R_RT32);
+        NEXT(1);
+    OP(SUBU):
+        R_RD = SEXT32(R_RS32 - R_RT32);
+        NEXT(1);
+    OP(AND):
+        R_RD = R_RS & R_RT;
+        NEXT(1);
+    OP(OR):
+        R_RD = R_RS | R_RT;
+        NEXT(1);
+    OP(XOR):
+        R_RD = R_RS ^ R_RT;
+        NEXT(1);
+    OP(NOR):
+        R_RD = ~(R_RS | R_RT);
+        NEXT(1);
+    OP(SLT):
+        R_RD = R_RS < R_RT ? 1 : 0;
+        NEXT(1);
+    OP(SLTU):
+        R_RD = (uint64_t)R_RS < (uint64_t)R_RT ? 1 : 0;
+        NEXT(1);
+    OP(DADDU):
+        R_RD = (int64_t)((uint64_t)R_RS + (uint64_t)R_RT);
+        NEXT(1);
+    OP(DSUBU):
+        R_RD = (int64_t)((uint64_t)R_RS - (uint64_t)R_RT);
+        NEXT(1);
+    OP(DSLL):
+        R_RD = (int64_t)((uint64_t)R_RT << ti->imm);
+        NEXT(1);
+    OP(DSRL):
+        R_RD = (int64_t)((uint64_t)R_RT >> ti->imm);
+        NEXT(1);
+    OP(DSRA):
+        R_RD = R_RT >> ti->imm;
+        NEXT(1);
+    OP(DSLL32):
+        R_RD = (int64_t)((uint64_t)R_RT << (32 + ti->imm));
+        NEXT(1);
+    OP(DSRL32):
+        R_RD = (int64_t)((uint64_t)R_RT >> (32 + ti->imm));
+        NEXT(1);
+    OP(DSRA32):
+        R_RD = R_RT >> (32 + ti->imm);
+        NEXT(1);
+    OP(ADDIU):
+        R_RT = SEXT32(R_RS32 + (uint32_t)ti->imm);
+        NEXT(1);
+    OP(SLTI):
+        R_RT = R_RS < (int64_t)ti->imm ? 1 : 0;
+        NEXT(1);
+    OP(SLTIU):
+        R_RT = (uint64_t)R_RS < (uint64_t)(int64_t)ti->imm ? 1 : 0;
+        NEXT(1);
+    OP(ANDI):
+        R_RT = R_RS & ti->imm;
+        NEXT(1);
+    OP(ORI):
+        R_RT = R_RS | ti->imm;
+        NEXT(1);
+    OP(XORI):
+        R_RT = R_RS ^ ti->imm;
+        NEXT(1);
+    OP(LUI):
+        R_RT = ti->imm;
+        NEXT(1);
+    OP(LUI_ADDIU):
+        R_RT = ti->imm;
+        reg[ti[1].rt] = SEXT32((uint32_t)ti->imm + (uint32_t)ti[1].imm);
+        NEXT(2);
+    OP(LUI_ORI):
+        R_RT = ti->imm;
+        reg[ti[1].rt] = (int64_t)ti->imm | ti[1].imm;
+        NEXT(2);
+#ifndef THREADED_COMPUTED_GOTO
+    default:
+        goto enter;
+    }
+#endif
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <core_trace.h>
+#include <zstd.h>
+
+// Upper bound for a chunk's compressed size, which protects against allocating absurd amounts of memory for corrupted
+// chunk headers. Chunks are written with 1 MiB of records at most.
+constexpr uint32_t MAX_CHUNK_SIZE = 0x1000000;
+
+template <typename T> static bool read_value(std::ifstream &file, T &value)
+{
+    return (bool)file.read((char *)&value, sizeof(T));
+}
+
+core_result core_trace_reader::open(const std::filesystem::path &path)
+{
+    m_file = std::ifstream(path, std::ios::binary);
+    m_chunks.clear();
+
+    if (!m_file)
+    {
+        return TL_BadFile;
+    }
+
+    if (!read_value(m_file, m_header) || m_header.magic != CORE_TRACE_MAGIC || m_header.version != CORE_TRACE_VERSION ||
+        m_header.record_size != sizeof(core_trace_record))
+    {
+        return TL_InvalidFormat;
+    }
+
+    if (m_header.codec != core_st_codec_store && m_header.codec != core_st_codec_zstd)
+    {
+        return TL_InvalidFormat;
+    }
+
+    if (m_header.index_offset != 0)
+    {
+        core_trace_index_header index{};
+        m_file.seekg((std::streamoff)m_header.index_offset);
+        if (!read_value(m_file, index) || index.magic != CORE_TRACE_INDEX_MAGIC)
+        {
+            return TL_InvalidFormat;
+        }
+
+        // The index must fit in the file, otherwise a corrupted count would make us allocate absurd amounts of memory.
+        std::error_code ec;
+        const uint64_t file_size = std::filesystem::file_size(path, ec);
+        const uint64_t index_end = (uint64_t)m_file.tellg();
+        if (ec || index_end > file_size || (uint64_t)index.count * sizeof(core_trace_chunk) > file_size - index_end)
+        {
+            return TL_InvalidFormat;
+        }
+
+        m_chunks.resize(index.count);
+        if (!m_file.read((char *)m_chunks.data(), (std::streamsize)(m_chunks.size() * sizeof(core_trace_chunk))))
+        {
+            m_chunks.clear();
+            return TL_InvalidFormat;
+        }
+        return Res_Ok;
+    }
+
+    // Without an index, we walk the chunk headers up to the first incomplete chunk.
+    uint64_t offset = sizeof(core_trace_header);
+    while (true)
+    {
+        core_trace_chunk chunk{.offset = offset};
+        m_file.seekg((std::streamoff)offset);
+        if (!read_value(m_file, chunk.header) || chunk.header.magic != CORE_TRACE_CHUNK_MAGIC)
+        {
+            break;
+        }
+
+        offset += sizeof(core_trace_chunk_header) + chunk.header.size;
+        m_file.seekg((std::streamoff)offset - 1);
+        if (m_file.get() == std::char_traits<char>::eof())
+        {
+            break;
+        }
+
+        m_chunks.push_back(chunk);
+    }
+    m_file.clear();
+
+    return Res_Ok;
+}
+
+const core_trace_header &core_trace_reader::header() const
+{
+    return m_header;
+}
+
+const std::vector<core_trace_chunk> &core_trace_reader::chunks() const
+{
+    return m_chunks;
+}
+
+size_t core_trace_reader::find_vi(const uint32_t vi) const
+{
+    const auto it = std::ranges::lower_bound(m_chunks, vi, {}, [](const auto &chunk) { return chunk.header.vi; });
+    return it - m_chunks.begin();
+}
+
+core_result core_trace_reader::read_chunk(const size_t index, std::vector<core_trace_record> &records)
+{
+    const auto &chunk = m_chunks.at(index);
+    const size_t size = chunk.header.record_count * sizeof(core_trace_record);
+
+    if (chunk.header.size > MAX_CHUNK_SIZE || size > MAX_CHUNK_SIZE)
+    {
+        return TL_InvalidFormat;
+    }
+
+    m_buf.resize(chunk.header.size);
+    m_file.seekg((std::streamoff)(chunk.offset + sizeof(core_trace_chunk_header)));
+    if (!m_file.read((char *)m_buf.data(), (std::streamsize)m_buf.size()))
+    {
+        m_file.clear();
+        return TL_BadFile;
+    }
+
+    records.resize(chunk.header.record_count);
+
+    if (m_header.codec == core_st_codec_store)
+    {
+        if (m_buf.size() != size)
+        {
+            return TL_InvalidFormat;
+        }
+        memcpy(records.data(), m_buf.data(), size);
+        return Res_Ok;
+    }
+
+    const auto result = ZSTD_decompress(records.data(), size, m_buf.data(), m_buf.size());
+    if (ZSTD_isError(result) || result != size)
+    {
+        return TL_InvalidFormat;
+    }
+
+    return Res_Ok;
+}
@@ -8,37 +8,338 @@
 #include "tracelog.h"
 #include "disasm.h"
 #include "r4300.h"
+#include "vcr.h"
+#include <Core.h>
+#include <core_trace.h>
+#include <zstd.h>
 
-bool enabled = false;
+// The size of a chunk's uncompressed contents, which makes for 65536 records per chunk in binary trace files.
+constexpr size_t CHUNK_SIZE = 0x100000;
+
+// The space kept free at the end of a chunk in text mode, as lines are formatted before their length is known.
+constexpr size_t LINE_RESERVE = 512;
+
+// The amount of chunks in the ring between the emulation thread and the writer.
+constexpr size_t RING_SIZE = 8;
+
+constexpr int32_t ZSTD_LEVEL = 1;
+
+/// A chunk of trace output, filled by the emulation thread and written out by the writer.
+struct t_chunk
+{
+    std::unique_ptr<uint8_t[]> data;
+
+    /// The amount of bytes in use.
+    size_t size;
+
+    /// The chunk header written in front of the compressed data in binary trace files.
+    core_trace_chunk_header header;
+};
+
+std::atomic<bool> enabled = false;
 bool use_binary = false;
 
 FILE *log_file;
-char traceLoggingBuf[0x10000];
-char *traceLoggingPointer = traceLoggingBuf;
+
+// Set by the emulation thread while it's writing to the current chunk, which lets tl_stop wait for it to finish before
+// taking the chunk over.
+static std::atomic<bool> g_recording = false;
+
+// The ring of chunks between the emulation thread and the writer. The emulation thread fills the chunk at g_ring_head
+// and publishes it by incrementing g_ring_head. The writer writes out the chunks before g_ring_head and frees them by
+// incrementing g_ring_tail. Both indices only ever increase.
+static t_chunk g_ring[RING_SIZE];
+static std::atomic<size_t> g_ring_head;
+static std::atomic<size_t> g_ring_tail;
+
+// The chunk being filled by the emulation thread.
+static t_chunk *g_chunk;
+
+// Whether the writer is submitted to the thread pool. The writer only runs while there are chunks to write, so it
+// doesn't hold on to a pool thread for the whole trace, and is resubmitted by the next publish once it has exited.
+static std::atomic<bool> g_writer_scheduled;
+
+// The writer's buffer for compressed chunks.
+static std::vector<uint8_t> g_compressed;
+
+// The amount of VIs since tracing started.
+static uint32_t g_vi;
+
+// The writer's position in the file, the chunks it has written so far, and whether a write failed.
+static uint64_t g_file_offset;
+static std::vector<core_trace_chunk> g_index;
+static bool g_write_failed;
+
+// The filter applied to the next trace, and the one applied to the active trace.
+static core_tl_filter g_next_filter;
+static core_tl_filter g_filter;
+
+// Whether each instruction passes the active filter's class restriction, indexed by INST.
+static bool g_traced_insts[INST_COUNT];
+
+// Whether the current VI is inside the active filter's VI window.
+static bool g_in_window;
 
 bool tl_active()
 {
     return enabled;
 }
 
-void flush_buf()
+static uint32_t get_class(const INST inst)
+{
+    // jalr shares its format with the two-register arithmetic instructions.
+    if (inst == INST_JALR)
+    {
+        return core_tl_class_jump;
+    }
+
+    switch (InstFormat[inst])
+    {
+    case INSTF_ADDRR:
+    case INSTF_LFR:
+        return core_tl_class_load;
+    case INSTF_ADDRW:
+    case INSTF_LFW:
+        return core_tl_class_store;
+    case INSTF_0BRANCH:
+    case INSTF_1BRANCH:
+    case INSTF_2BRANCH:
+        return core_tl_class_branch;
+    case INSTF_J:
+    case INSTF_JR:
+        return core_tl_class_jump;
+    case INSTF_LUI:
+    case INSTF_ISIGN:
+    case INSTF_IUNSIGN:
+    case INSTF_R1:
+    case INSTF_R2:
+    case INSTF_R3:
+    case INSTF_SA:
+        return core_tl_class_alu;
+    case INSTF_MFC0:
+    case INSTF_MTC0:
+        return core_tl_class_cop0;
+    case INSTF_MFC1:
+    case INSTF_MTC1:
+    case INSTF_R2F:
+    case INSTF_R3F:
+    case INSTF_C:
+        return core_tl_class_fpu;
+    default:
+        return core_tl_class_other;
+    }
+}
+
+static bool in_ranges(const std::vector<core_tl_range> &ranges, const uint32_t first, const uint32_t last)
+{
+    for (const auto &range : ranges)
+    {
+        if (first <= range.last && last >= range.first)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool tracelog_is_traced(const uint32_t pc, const uint32_t w)
+{
+    if (!g_filter.pc_ranges.empty() && !in_ranges(g_filter.pc_ranges, pc, pc))
+    {
+        return false;
+    }
+    return g_traced_insts[GetInstruction(w)];
+}
+
+/**
+ * \brief Gets whether a store which is about to execute passes the active filter's write restriction.
+ * \param w The store's opcode.
+ */
+static bool passes_write_filter(const uint32_t w)
+{
+    if (g_filter.write_ranges.empty())
+    {
+        return true;
+    }
+
+    uint32_t size;
+    switch (GetInstruction(w))
+    {
+    case INST_SB:
+        size = 1;
+        break;
+    case INST_SH:
+        size = 2;
+        break;
+    case INST_SW:
+    case INST_SWL:
+    case INST_SWR:
+    case INST_SC:
+    case INST_SWC1:
+        size = 4;
+        break;
+    default:
+        size = 8;
+        break;
+    }
+
+    // All stores share the base and offset encoding. The unaligned ones write part of the aligned word or doubleword
+    // holding the address, which we treat as written as a whole.
+    const uint32_t addr = ((uint32_t)reg[w >> 21 & 0x1F] + (int16_t)(w & 0xFFFF)) & ~(size - 1);
+    return in_ranges(g_filter.write_ranges, addr, addr + size - 1);
+}
+
+/**
+ * \brief Makes the cached interpreter recompile the code within the active filter's address ranges, which routes its
+ * instructions through or away from the trace logger depending on whether tracing is enabled.
+ */
+static void recompile_traced_code()
+{
+    if (interpcore != 0)
+    {
+        return;
+    }
+
+    if (g_filter.pc_ranges.empty())
+    {
+        vr_recompile(UINT32_MAX);
+        return;
+    }
+
+    for (const auto &range : g_filter.pc_ranges)
+    {
+        for (uint32_t page = range.first >> 12; page <= range.last >> 12; ++page)
+        {
+            invalid_code[page] = 1;
+        }
+    }
+}
+
+static void reset_chunk(t_chunk &chunk)
+{
+    chunk.size = 0;
+    chunk.header = {
+        .magic = CORE_TRACE_CHUNK_MAGIC,
+        .vi = g_vi,
+        .pc_min = UINT32_MAX,
+        .pc_max = 0,
+    };
+}
+
+static void tracelog_write_worker();
+
+/**
+ * \brief Hands the current chunk to the writer and continues with the next one, waiting for the writer to free it if
+ * the ring is full.
+ */
+static void publish_chunk()
+{
+    const size_t head = g_ring_head.load(std::memory_order_relaxed) + 1;
+    g_ring_head.store(head);
+    if (!g_writer_scheduled.exchange(true))
+    {
+        g_core->submit_task(tracelog_write_worker);
+    }
+
+    size_t tail = g_ring_tail.load(std::memory_order_acquire);
+    while (head - tail >= RING_SIZE)
+    {
+        g_ring_tail.wait(tail, std::memory_order_acquire);
+        tail = g_ring_tail.load(std::memory_order_acquire);
+    }
+
+    g_chunk = &g_ring[head % RING_SIZE];
+    reset_chunk(*g_chunk);
+}
+
+static bool write_chunk(const t_chunk &chunk)
 {
-    fwrite(traceLoggingBuf, 1, traceLoggingPointer - traceLoggingBuf, log_file);
-    traceLoggingPointer = traceLoggingBuf;
+    if (!use_binary)
+    {
+        return fwrite(chunk.data.get(), 1, chunk.size, log_file) == chunk.size;
+    }
+
+    const size_t size =
+        ZSTD_compress(g_compressed.data(), g_compressed.size(), chunk.data.get(), chunk.size, ZSTD_LEVEL);
+    if (ZSTD_isError(size))
+    {
+        return false;
+    }
+
+    core_trace_chunk entry{.offset = g_file_offset, .header = chunk.header};
+    entry.header.size = (uint32_t)size;
+    entry.header.record_count = (uint32_t)(chunk.size / sizeof(core_trace_record));
+
+    if (fwrite(&entry.header, sizeof(entry.header), 1, log_file) != 1 ||
+        fwrite(g_compressed.data(), 1, size, log_file) != size)
+    {
+        return false;
+    }
+
+    g_file_offset += sizeof(entry.header) + size;
+    g_index.push_back(entry);
+    return true;
 }
 
-void write_buf()
+/**
+ * \brief Writes out published chunks until the ring is empty, then exits to give its pool thread back.
+ */
+static void tracelog_write_worker()
 {
-    const char *const buflength = traceLoggingBuf + sizeof(traceLoggingBuf) - 512;
-    if (traceLoggingPointer >= buflength)
+    size_t tail = g_ring_tail.load(std::memory_order_relaxed);
+
+    while (true)
     {
-        flush_buf();
+        while (tail != g_ring_head.load(std::memory_order_acquire))
+        {
+            const auto &chunk = g_ring[tail % RING_SIZE];
+            if (!g_write_failed && chunk.size != 0 && !write_chunk(chunk))
+            {
+                g_write_failed = true;
+                g_core->log_error("[Core] Failed to write to the trace log");
+            }
+
+            g_ring_tail.store(++tail, std::memory_order_release);
+            g_ring_tail.notify_one();
+        }
+
+        g_writer_scheduled.store(false);
+        g_writer_scheduled.notify_all();
+
+        // A chunk published after the ring was found empty but before we unscheduled ourselves didn't resubmit us,
+        // so we pick it up here unless a newer publish already did.
+        if (tail == g_ring_head.load() || g_writer_scheduled.exchange(true))
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * \brief Makes room for a record in the current chunk.
+ * \param size The maximum size of the record.
+ * \param pc The address of the recorded instruction.
+ * \return The position the record is written at.
+ */
+static char *begin_record(const size_t size, const uint32_t pc)
+{
+    if (g_chunk->size + size > CHUNK_SIZE)
+    {
+        publish_chunk();
     }
+    g_chunk->header.pc_min = std::min(g_chunk->header.pc_min, pc);
+    g_chunk->header.pc_max = std::max(g_chunk->header.pc_max, pc);
+    return (char *)g_chunk->data.get() + g_chunk->size;
+}
+
+static void end_record(const char *p)
+{
+    g_chunk->size = p - (char *)g_chunk->data.get();
 }
 
 void log_bin(uint32_t pc, uint32_t w)
 {
-    char *&p = traceLoggingPointer;
+    char *p = begin_record(sizeof(core_trace_record), pc);
     INSTDECODE decode;
     // little endian
 #define HEX8(n)                                                                                                        \
@@ -136,7 +437,7 @@ void log_bin(uint32_t pc, uint32_t w)
         NONE;
         break;
     }
-    write_buf();
+    end_record(p);
 #undef HEX8
 #undef REGCPU
 #undef REGFPU
@@ -146,7 +447,8 @@ void log_bin(uint32_t pc, uint32_t w)
 
 void log(uint32_t pc, uint32_t w)
 {
-    char *&p = traceLoggingPointer;
+    char *p = begin_record(LINE_RESERVE, pc);
+    const char *const end = (char *)g_chunk->data.get() + CHUNK_SIZE;
     INSTDECODE decode;
     const char *const x = "0123456789abcdef";
 #define HEX8(n)                                                                                                        \
@@ -211,7 +513,7 @@ void log(uint32_t pc, uint32_t w)
     *(p++) = x[(n) / 10];                                                                                              \
     *(p++) = x[(n) % 10];                                                                                              \
     *(p++) = '=';                                                                                                      \
-    p += snprintf(p, sizeof(traceLoggingBuf) - (p - traceLoggingBuf), "%f", *reg_cop1_simple[n])
+    p += snprintf(p, end - p, "%f", *reg_cop1_simple[n])
 #define REGFPU2(n, m)                                                                                                  \
     REGFPU(n);                                                                                                         \
     if ((n) != (m))                                                                                                    \
@@ -291,7 +593,7 @@ void log(uint32_t pc, uint32_t w)
     }
     *(p++) = '\n';
 
-    write_buf();
+    end_record(p);
 #undef HEX8
 #undef REGCPU
 #undef REGFPU
@@ -302,19 +604,26 @@ void log(uint32_t pc, uint32_t w)
 
 void tracelog_log_pure()
 {
-    if (!use_binary)
+    g_recording = true;
+    if (enabled && g_in_window && tracelog_is_traced(interp_addr, vr_op) && passes_write_filter(vr_op))
     {
-        log(interp_addr, vr_op);
-    }
-    else
-    {
-        log_bin(interp_addr, vr_op);
+        if (!use_binary)
+        {
+            log(interp_addr, vr_op);
+        }
+        else
+        {
+            log_bin(interp_addr, vr_op);
+        }
     }
+    g_recording.store(false, std::memory_order_release);
 }
 
 void tracelog_log_interp_ops()
 {
-    if (enabled)
+    // The recompiler only routes instructions which pass the address and class restrictions through here.
+    g_recording = true;
+    if (enabled && g_in_window && passes_write_filter(PC->src))
     {
         if (!use_binary)
         {
@@ -325,24 +634,141 @@ void tracelog_log_interp_ops()
             log_bin(PC->addr, PC->src);
         }
     }
+    g_recording.store(false, std::memory_order_release);
     PC->s_ops();
 }
 
-void tl_start(std::filesystem::path path, bool binary, bool append)
+void tracelog_on_vi()
 {
+    if (!enabled)
+    {
+        return;
+    }
+
+    g_recording = true;
+    if (enabled)
+    {
+        ++g_vi;
+        if (use_binary && g_chunk->size != 0)
+        {
+            publish_chunk();
+        }
+        g_chunk->header.vi = g_vi;
+        g_in_window = g_vi >= g_filter.first_vi && g_vi <= g_filter.last_vi;
+    }
+    g_recording.store(false, std::memory_order_release);
+}
+
+core_result tl_start(std::filesystem::path path, bool binary, bool append)
+{
+    tl_stop();
+
+    // Binary trace files can't be appended to, as their index is at the end.
+    if (IOUtils::path_fopen_s(log_file, path, append && !binary ? "ab" : "wb") != 0)
+    {
+        return TL_BadFile;
+    }
+
     use_binary = binary;
-    IOUtils::path_fopen_s(log_file, path, "wb");
+    g_filter = g_next_filter;
+    for (size_t i = 0; i < INST_COUNT; ++i)
+    {
+        const auto cls = get_class((INST)i);
+        g_traced_insts[i] = (g_filter.classes & cls) && (g_filter.write_ranges.empty() || cls == core_tl_class_store);
+    }
+    g_in_window = g_filter.first_vi == 0;
+    g_vi = 0;
+    g_file_offset = 0;
+    g_index.clear();
+    g_write_failed = false;
 
-    enabled = true;
-    if (interpcore == 0)
+    if (binary)
     {
-        vr_recompile(UINT32_MAX);
+        const core_trace_header header = {
+            .magic = CORE_TRACE_MAGIC,
+            .version = CORE_TRACE_VERSION,
+            .record_size = sizeof(core_trace_record),
+            .codec = core_st_codec_zstd,
+            .start_vi = vcr_get_current_vi(),
+            .index_offset = 0,
+        };
+        if (fwrite(&header, sizeof(header), 1, log_file) != 1)
+        {
+            fclose(log_file);
+            return TL_BadFile;
+        }
+        g_file_offset = sizeof(header);
+    }
+
+    for (auto &chunk : g_ring)
+    {
+        chunk.data = std::make_unique<uint8_t[]>(CHUNK_SIZE);
     }
+    g_ring_head = 0;
+    g_ring_tail = 0;
+    g_chunk = &g_ring[0];
+    reset_chunk(*g_chunk);
+
+    g_compressed.resize(binary ? ZSTD_compressBound(CHUNK_SIZE) : 0);
+    g_writer_scheduled = false;
+
+    enabled = true;
+    recompile_traced_code();
+    return Res_Ok;
 }
 
 void tl_stop()
 {
+    if (!enabled)
+    {
+        return;
+    }
     enabled = false;
-    flush_buf();
+
+    // The emulation thread might still be writing a record.
+    while (g_recording)
+    {
+        std::this_thread::yield();
+    }
+
+    if (g_chunk->size != 0)
+    {
+        publish_chunk();
+    }
+    while (g_writer_scheduled.load(std::memory_order_acquire))
+    {
+        g_writer_scheduled.wait(true, std::memory_order_acquire);
+    }
+
+    if (use_binary && !g_write_failed)
+    {
+        const core_trace_index_header index = {
+            .magic = CORE_TRACE_INDEX_MAGIC,
+            .count = (uint32_t)g_index.size(),
+        };
+        fwrite(&index, sizeof(index), 1, log_file);
+        fwrite(g_index.data(), sizeof(core_trace_chunk), g_index.size(), log_file);
+        fseek(log_file, offsetof(core_trace_header, index_offset), SEEK_SET);
+        fwrite(&g_file_offset, sizeof(g_file_offset), 1, log_file);
+    }
     fclose(log_file);
+
+    for (auto &chunk : g_ring)
+    {
+        chunk.data.reset();
+    }
+    g_compressed = {};
+
+    // Take the traced code off the trace logger again.
+    recompile_traced_code();
+}
+
+core_tl_filter tl_get_filter()
+{
+    return g_next_filter;
+}
+
+void tl_set_filter(const core_tl_filter &filter)
+{
+    g_next_filter = filter;
 }
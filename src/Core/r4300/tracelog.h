@@ -6,6 +6,16 @@
 
 #pragma once
 
+#include <include/core_types.h>
+
+/**
+ * \brief Gets whether an instruction passes the address and class restrictions of the active trace filter. The
+ * recompiler only routes the instructions which pass through the trace logger.
+ * \param pc The instruction's address.
+ * \param w The instruction's opcode.
+ */
+bool tracelog_is_traced(uint32_t pc, uint32_t w);
+
 /**
  * \brief Logs a dynarec-generated instruction
  */
@@ -16,7 +26,14 @@ void tracelog_log_interp_ops();
  */
 void tracelog_log_pure();
 
+/**
+ * \brief Notifies the trace logger of a VI, which starts a new chunk in binary trace files.
+ */
+void tracelog_on_vi();
+
 bool tl_active();
 
-void tl_start(std::filesystem::path path, bool binary, bool append);
+core_result tl_start(std::filesystem::path path, bool binary, bool append);
 void tl_stop();
+core_tl_filter tl_get_filter();
+void tl_set_filter(const core_tl_filter &filter);
@@ -14,6 +14,9 @@
 #include <format>
 #include <include/core_api.h>
 #include <iterator>
+#include <memory/savestates.h>
+#include <memory/st_delta.h>
+#include <r4300/movie_inputs.h>
 #include <r4300/r4300.h>
 #include <r4300/rom.h>
 #include <r4300/vcr.h>
@@ -65,14 +68,27 @@ class vcr_anti_lock
     ~vcr_anti_lock() { vcr_mtx.lock(); }
 };
 
+/**
+ * \brief Queues a notification to be delivered at the end of the current controller poll.
+ */
+static void vcr_push_event(const vcr_event_type type, const int32_t value = 0)
+{
+    if (vcr.pending_event_count == vcr.pending_events.size())
+    {
+        g_core->log_error(std::format("[VCR] Event buffer full, dropping event {}", (int32_t)type));
+        return;
+    }
+    vcr.pending_events[vcr.pending_event_count++] = {.type = type, .value = value};
+}
+
 bool vcr_is_task_recording(core_vcr_task task);
 
-bool write_movie_impl(const core_vcr_movie_header *hdr, const std::vector<core_buttons> &inputs,
-                      const std::filesystem::path &path)
+/**
+ * \brief Gets the header to write to movie files, which depends on the configured movie format.
+ */
+static core_vcr_movie_header get_header_for_writing(const core_vcr_movie_header &hdr)
 {
-    g_core->log_info(std::format("[VCR] write_movie_impl to {}...", vcr.movie_path.string()));
-
-    core_vcr_movie_header hdr_copy = *hdr;
+    core_vcr_movie_header hdr_copy = hdr;
 
     if (!g_core->cfg->vcr_write_extended_format)
     {
@@ -83,17 +99,20 @@ bool write_movie_impl(const core_vcr_movie_header *hdr, const std::vector<core_b
         memset(&hdr_copy.extended_data, 0, sizeof(hdr_copy.extended_flags));
     }
 
-    std::vector<uint8_t> out_buf(sizeof(core_vcr_movie_header) + sizeof(core_buttons) * hdr_copy.length_samples);
-    std::memcpy(out_buf.data(), &hdr_copy, sizeof(core_vcr_movie_header));
-    std::memcpy(out_buf.data() + sizeof(core_vcr_movie_header), inputs.data(),
-                sizeof(core_buttons) * hdr_copy.length_samples);
-    const auto written = IOUtils::write_entire_file(path, out_buf);
+    return hdr_copy;
+}
 
-    return written;
+/**
+ * \brief Gets the inputs to write to movie files, which are the first length_samples inputs.
+ */
+static std::span<const core_buttons> get_inputs_for_writing()
+{
+    return {vcr.inputs.data(), std::min((size_t)vcr.hdr.length_samples, vcr.inputs.size())};
 }
 
-// Writes the movie header + inputs to current movie_path
-bool write_movie()
+// Writes the movie header + inputs to current movie_path. Only the parts which changed since the last write are
+// written, see movie_writer.h. If stopping is true, the recording is about to stop.
+bool write_movie(const bool stopping = false)
 {
     if (!vcr_is_task_recording(vcr.task))
     {
@@ -101,9 +120,17 @@ bool write_movie()
         return true;
     }
 
-    g_core->log_info("[VCR] Flushing current movie...");
+    g_core->log_info(std::format("[VCR] Flushing current movie to {}...", vcr.movie_path.string()));
+
+    // Recorded inputs are normally already copied out of the movie file's mapping. Make sure they are, since the file
+    // is about to be modified.
+    vcr.inputs.mut();
+
+    const bool sync = g_core->cfg->vcr_sync == core_vcr_sync_always ||
+                      (stopping && g_core->cfg->vcr_sync == core_vcr_sync_on_stop);
 
-    return write_movie_impl(&vcr.hdr, vcr.inputs, vcr.movie_path);
+    return movie_writer_write(vcr.movie_writer, vcr.movie_path, get_header_for_writing(vcr.hdr),
+                              get_inputs_for_writing(), sync);
 }
 
 bool write_backup_impl()
@@ -112,7 +139,8 @@ bool write_backup_impl()
     const auto filename =
         std::format("{}.{}.m64", vcr.movie_path.stem().string(), static_cast<uint64_t>(time(nullptr)));
 
-    return write_movie_impl(&vcr.hdr, vcr.inputs, g_core->get_backups_directory() / filename);
+    return movie_write_full(g_core->get_backups_directory() / filename, get_header_for_writing(vcr.hdr),
+                            get_inputs_for_writing(), g_core->cfg->vcr_sync == core_vcr_sync_always);
 }
 
 bool is_task_playback(const core_vcr_task task)
@@ -219,7 +247,7 @@ static void set_rom_info(core_vcr_movie_header *header)
                              header->rsp_plugin_name);
 }
 
-core_result vcr_read_movie_header(std::vector<uint8_t> buf, core_vcr_movie_header *header)
+core_result vcr_read_movie_header(std::span<const uint8_t> buf, core_vcr_movie_header *header)
 {
     const core_vcr_movie_header default_hdr{};
     constexpr auto old_header_size = 512;
@@ -323,36 +351,66 @@ core_result vcr_parse_header(std::filesystem::path path, core_vcr_movie_header *
     new_header.rom_country = -1;
     strncpy(new_header.rom_name, "(no ROM)", sizeof(new_header.rom_name));
 
-    auto buf = IOUtils::read_entire_file(path);
-    if (buf.empty())
+    // Only the header is needed, so map the file instead of reading all of it.
+    const auto file = t_mapped_file::open(path);
+    if (!file)
     {
         return VCR_BadFile;
     }
 
-    const auto result = vcr_read_movie_header(buf, &new_header);
+    const auto result = vcr_read_movie_header(file->data(), &new_header);
     *header = new_header;
 
     return result;
 }
 
-core_result vcr_read_movie_inputs(std::filesystem::path path, std::vector<core_buttons> &inputs)
+/**
+ * \brief Reads the header and inputs of a mapped movie file.
+ * \param file The movie file's mapping.
+ * \param header The header to fill.
+ * \param inputs The inputs to fill. They are backed by the file's mapping.
+ * \return The operation result
+ */
+static core_result vcr_read_mapped_movie(std::shared_ptr<const t_mapped_file> file, core_vcr_movie_header *header,
+                                         t_movie_inputs &inputs)
 {
-    core_vcr_movie_header header = {};
-    const auto result = vcr_parse_header(path, &header);
+    const auto result = vcr_read_movie_header(file->data(), header);
     if (result != Res_Ok)
     {
         return result;
     }
 
-    auto buf = IOUtils::read_entire_file(path);
+    if (file->data().size() < sizeof(core_vcr_movie_header) + sizeof(core_buttons) * header->length_samples)
+    {
+        return VCR_InvalidFormat;
+    }
 
-    if (buf.size() < sizeof(core_vcr_movie_header) + sizeof(core_buttons) * header.length_samples)
+    inputs = t_movie_inputs::map(std::move(file), sizeof(core_vcr_movie_header), header->length_samples);
+    return Res_Ok;
+}
+
+core_result vcr_read_movie_inputs(std::filesystem::path path, std::vector<core_buttons> &inputs)
+{
+    if (path.extension().compare(L".m64") != 0)
     {
         return VCR_InvalidFormat;
     }
 
-    inputs.resize(header.length_samples);
-    memcpy(inputs.data(), buf.data() + sizeof(core_vcr_movie_header), sizeof(core_buttons) * header.length_samples);
+    const auto file = t_mapped_file::open(path);
+    if (!file)
+    {
+        return VCR_BadFile;
+    }
+
+    core_vcr_movie_header header = {};
+    t_movie_inputs movie_inputs{};
+    const auto result = vcr_read_mapped_movie(file, &header, movie_inputs);
+    if (result != Res_Ok)
+    {
+        return result;
+    }
+
+    inputs.assign(movie_inputs.begin(), movie_inputs.end());
 
     return Res_Ok;
 }
@@ -452,6 +510,9 @@ core_result vcr_unfreeze(const vcr_freeze_info &freeze)
         // writing new input data at the currentFrame pointer
         vcr.task = task_recording;
 
+        // Leaving playback, so the movie file's mapping is released before the file is written to.
+        vcr.inputs.mut();
+
         // update header with new ROM info
         if (last_task == task_playback) set_rom_info(&vcr.hdr);
 
@@ -467,8 +528,20 @@ core_result vcr_unfreeze(const vcr_freeze_info &freeze)
                 write_backup_impl();
             }
 
+            // Usually, only the samples after the current one differ from the savestate's, so the rest of the movie
+            // file doesn't need to be rewritten.
+            const size_t common_length = std::min({vcr.inputs.size(), freeze.input_buffer.size(),
+                                                   (size_t)freeze.current_sample});
+            size_t first_difference = 0;
+            while (first_difference < common_length &&
+                   vcr.inputs[first_difference].value == freeze.input_buffer[first_difference].value)
+            {
+                first_difference++;
+            }
+            movie_writer_invalidate(vcr.movie_writer, first_difference);
+
             vcr.inputs.resize(freeze.current_sample);
-            memcpy(vcr.inputs.data(), freeze.input_buffer.data(), sizeof(core_buttons) * freeze.current_sample);
+            memcpy(vcr.inputs.mut().data(), freeze.input_buffer.data(), sizeof(core_buttons) * freeze.current_sample);
 
             write_movie();
         }
@@ -501,13 +574,30 @@ core_result vcr_write_backup()
     return result ? Res_Ok : VCR_BadFile;
 }
 
+/**
+ * \brief Discards the prefetched seek savestate if its frame lies in the range [first, last).
+ */
+static void vcr_discard_seek_prefetch(const size_t first = 0, const size_t last = SIZE_MAX)
+{
+    if (vcr.seek_prefetch.frame < first || vcr.seek_prefetch.frame >= last)
+    {
+        return;
+    }
+
+    vcr.seek_prefetch.frame = SIZE_MAX;
+    vcr.seek_prefetch.st = {};
+    ++vcr.seek_prefetch.generation;
+}
+
 void vcr_create_n_frame_savestate(size_t frame)
 {
     assert(vcr.current_sample == frame);
 
+    const auto eviction = (core_seek_savestate_eviction)g_core->cfg->seek_savestate_eviction;
+
     // OPTIMIZATION: When seeking, we can skip creating seek savestates until near the end where we know they wont be
-    // purged
-    if (vcr.seek_to_frame.has_value())
+    // purged. This doesn't hold when thinning, which keeps some savestates far from the end.
+    if (vcr.seek_to_frame.has_value() && eviction != core_seek_savestate_eviction_thinning)
     {
         const auto frames_from_end_where_savestates_start_appearing =
             g_core->cfg->seek_savestate_interval * g_core->cfg->seek_savestate_max_count;
@@ -519,25 +609,22 @@ void vcr_create_n_frame_savestate(size_t frame)
         }
     }
 
-    // If our seek savestate map is getting too large, we'll start purging the oldest ones (but not the first one!!!)
+    // If our seek savestate map is getting too large, we'll start purging according to the eviction policy (but never
+    // the one at frame 0!!!)
     if (vcr.seek_savestates.size() > g_core->cfg->seek_savestate_max_count)
     {
-        for (int32_t i = 1; i < vcr.hdr.length_samples; ++i)
+        if (const auto victim = vcr.seek_savestates.pick_eviction(eviction, frame))
         {
-            if (vcr.seek_savestates.contains(i))
-            {
-                g_core->log_info(std::format("[VCR] Map too large! Purging seek savestate at frame {}...", i));
-                vcr.seek_savestates.erase(i);
-                vcr.post_controller_poll_callbacks.emplace(
-                    [=] { g_core->callbacks.seek_savestate_changed((size_t)i); });
-                break;
-            }
+            g_core->log_info(std::format("[VCR] Map too large! Purging seek savestate at frame {}...", *victim));
+            vcr.seek_savestates.erase(*victim);
+            vcr_discard_seek_prefetch(*victim, *victim + 1);
+            vcr_push_event(vcr_event_seek_savestate_changed, (int32_t)*victim);
         }
     }
 
     g_core->log_info(std::format("[VCR] Creating seek savestate at frame {}...", frame));
     g_ctx.st_do_memory(
-        {}, core_st_job_save,
+        {}, core_st_job_save_incremental,
         [frame](const core_st_callback_info &info, const auto &buf) {
             std::unique_lock lock(vcr_mtx);
 
@@ -548,8 +635,22 @@ void vcr_create_n_frame_savestate(size_t frame)
                 return;
             }
 
-            g_core->log_info(std::format("[VCR] Seek savestate at frame {} of size {} completed", frame, buf.size()));
-            vcr.seek_savestates[frame] = buf;
+            // The first seek savestate becomes the keyframe which subsequent ones are delta-encoded against. As the
+            // movie drifts away from it, the deltas grow towards full savestates, so a savestate whose delta gets too
+            // large becomes the new keyframe. Older savestates keep their keyframe alive until they're evicted.
+            auto delta = vcr.seek_savestate_keyframe ? st_delta_encode(*vcr.seek_savestate_keyframe, buf)
+                                                     : std::vector<uint8_t>{};
+            if (!vcr.seek_savestate_keyframe || delta.size() > buf.size() / SEEK_SAVESTATE_REKEY_DIVISOR)
+            {
+                g_core->log_info(std::format("[VCR] Seek savestate at frame {} becomes the new keyframe", frame));
+                vcr.seek_savestate_keyframe = std::make_shared<const std::vector<uint8_t>>(buf);
+                delta = st_delta_encode(*vcr.seek_savestate_keyframe, buf);
+            }
+            const auto &st = vcr.seek_savestates.insert(frame, std::move(delta), vcr.seek_savestate_keyframe);
+            vcr_discard_seek_prefetch(frame, frame + 1);
+
+            g_core->log_info(std::format("[VCR] Seek savestate at frame {} of size {} completed ({} bytes stored)",
+                                         frame, buf.size(), st.data.size()));
 
             {
                 vcr_anti_lock bypass;
@@ -559,6 +660,40 @@ void vcr_create_n_frame_savestate(size_t frame)
         false);
 }
 
+/**
+ * \brief Gets the decoded seek savestate at the specified frame, taking it from the prefetch if it's ready.
+ * \return The savestate buffer, or an empty buffer if no valid seek savestate exists at the frame.
+ */
+static std::vector<uint8_t> vcr_get_seek_savestate(const size_t frame)
+{
+    const auto entry = vcr.seek_savestates.find(frame);
+    if (!entry)
+    {
+        return {};
+    }
+
+    vcr.seek_savestates.touch(frame);
+
+    if (vcr.seek_prefetch.frame == frame && !vcr.seek_prefetch.st.empty())
+    {
+        g_core->log_info(std::format("[VCR] Using prefetched seek savestate at frame {}", frame));
+        auto st = std::move(vcr.seek_prefetch.st);
+        vcr_discard_seek_prefetch();
+        return st;
+    }
+
+    // The seek won't wait for a decode that's still running, so its result can be dropped.
+    vcr_discard_seek_prefetch();
+
+    std::vector<uint8_t> st;
+    if (!st_delta_decode(*entry->keyframe, entry->data, st))
+    {
+        g_core->log_error(std::format("[VCR] Failed to decode seek savestate at frame {}", frame));
+        return {};
+    }
+    return st;
+}
+
 void vcr_handle_starting_tasks(int32_t index, core_buttons *input)
 {
     if (vcr.task == task_start_recording_from_reset)
@@ -712,7 +847,7 @@ void vcr_handle_recording(int32_t index, core_buttons *input)
         });
     }
 
-    vcr.post_controller_poll_callbacks.emplace([=] { g_core->callbacks.current_sample_changed(vcr.current_sample); });
+    vcr_push_event(vcr_event_sample_changed, vcr.current_sample);
 }
 
 void vcr_handle_playback(int32_t index, core_buttons *input)
@@ -744,7 +879,7 @@ void vcr_handle_playback(int32_t index, core_buttons *input)
                 g_ctx.vcr_start_playback(vcr.movie_path);
             }
 
-            vcr.post_controller_poll_callbacks.emplace([=] { g_core->callbacks.loop_movie(); });
+            vcr_push_event(vcr_event_loop_movie);
             return;
         }
 
@@ -804,7 +939,7 @@ void vcr_handle_playback(int32_t index, core_buttons *input)
     // state-dependent work.
 
     vcr.current_sample++;
-    vcr.post_controller_poll_callbacks.emplace([=] { g_core->callbacks.current_sample_changed(vcr.current_sample); });
+    vcr_push_event(vcr_event_sample_changed, vcr.current_sample);
 }
 
 void vcr_stop_seek_if_needed()
@@ -903,11 +1038,8 @@ void vcr_on_controller_poll(int32_t index, core_buttons *input)
     {
         g_core->input_get_keys(index, input);
 
-        {
-            vcr_anti_lock bypass;
-            g_core->callbacks.input(input, index);
-        }
-
+        lock.unlock();
+        g_core->callbacks.input(input, index);
         return;
     }
 
@@ -922,15 +1054,28 @@ void vcr_on_controller_poll(int32_t index, core_buttons *input)
 
     vcr_handle_playback(index, input);
 
-    // Since the callback might want to call VCR functions, we have to release the lock to avoid deadlocking in
-    // situations with interlocked threads (e.g. UI and Emu) In addition, we have to be careful to only call this
-    // function after we're done with VCR work as to avoid reentrancy issues.
+    // Since the callbacks might want to call VCR functions, we have to release the lock to avoid deadlocking in
+    // situations with interlocked threads (e.g. UI and Emu) In addition, we have to be careful to only call them after
+    // we're done with VCR work as to avoid reentrancy issues. The events are copied out first, so the lock doesn't have
+    // to be reacquired afterwards.
+    const auto events = vcr.pending_events;
+    const auto event_count = vcr.pending_event_count;
+    vcr.pending_event_count = 0;
+    lock.unlock();
+
+    for (size_t i = 0; i < event_count; ++i)
     {
-        vcr_anti_lock bypass;
-        while (!vcr.post_controller_poll_callbacks.empty())
+        switch (events[i].type)
         {
-            vcr.post_controller_poll_callbacks.front()();
-            vcr.post_controller_poll_callbacks.pop();
+        case vcr_event_sample_changed:
+            g_core->callbacks.current_sample_changed(events[i].value);
+            break;
+        case vcr_event_seek_savestate_changed:
+            g_core->callbacks.seek_savestate_changed((size_t)events[i].value);
+            break;
+        case vcr_event_loop_movie:
+            g_core->callbacks.loop_movie();
+            break;
         }
     }
 }
@@ -1026,6 +1171,7 @@ core_result vcr_start_record(std::filesystem::path path, uint16_t flags, std::st
     const core_vcr_movie_header default_hdr{};
     memset(&vcr.hdr, 0, sizeof(core_vcr_movie_header));
     vcr.inputs = {};
+    movie_writer_reset(vcr.movie_writer);
 
     vcr.hdr.magic = MOVIE_MAGIC;
     vcr.hdr.version = LATEST_MOVIE_VERSION;
@@ -1046,22 +1192,26 @@ core_result vcr_start_record(std::filesystem::path path, uint16_t flags, std::st
         // save state
         g_core->log_info("[VCR] Saving state...");
         vcr.task = task_start_recording_from_snapshot;
-        g_ctx.st_do_file(
-            get_path_for_new_movie(vcr.movie_path), core_st_job_save,
-            [](const core_st_callback_info &info, auto &&...) {
+
+        const auto on_failure = [] {
+            g_core->show_dialog("Failed to save savestate while starting recording.\nRecording will be stopped.", "VCR",
+                                fsvc_error);
+
+            vcr_anti_lock bypass;
+            g_ctx.vcr_stop_all();
+        };
+
+        // The savestate is generated in memory, so that recording starts on the frame it was taken on. The file is
+        // written in the background afterwards, and the recording is stopped if that fails.
+        g_ctx.st_do_memory(
+            {}, core_st_job_save,
+            [=, path = get_path_for_new_movie(vcr.movie_path)](const core_st_callback_info &info,
+                                                                const std::vector<uint8_t> &buffer) {
                 std::unique_lock lock(vcr_mtx);
 
                 if (info.result != Res_Ok)
                 {
-                    g_core->show_dialog(
-                        "Failed to save savestate while starting recording.\nRecording will be stopped.", "VCR",
-                        fsvc_error);
-
-                    {
-                        vcr_anti_lock bypass;
-                        g_ctx.vcr_stop_all();
-                    }
-
+                    on_failure();
                     return;
                 }
 
@@ -1069,6 +1219,16 @@ core_result vcr_start_record(std::filesystem::path path, uint16_t flags, std::st
                 vcr.task = task_recording;
                 // FIXME: Doesn't this need a message broadcast?
                 // TODO: Also, what about clearing the input on first frame
+
+                // The recording might have been stopped, or replaced by another one, by the time the write finishes.
+                st_write_file(path, buffer, [=, uid = vcr.hdr.uid](const core_st_callback_info &info, auto &&...) {
+                    std::unique_lock lock(vcr_mtx);
+
+                    if (info.result != Res_Ok && vcr.task == task_recording && vcr.hdr.uid == uid)
+                    {
+                        on_failure();
+                    }
+                });
             },
             true);
     }
@@ -1149,15 +1309,19 @@ core_result vcr_replace_author_info(const std::filesystem::path &path, std::stri
     }
 
     // 1. Read movie header
-    const auto buf = IOUtils::read_entire_file(path);
-
-    if (buf.empty())
+    core_vcr_movie_header hdr{};
+    core_result result;
     {
-        return VCR_BadFile;
-    }
+        // The mapping has to be gone before the file is written to.
+        const auto file = t_mapped_file::open(path);
 
-    core_vcr_movie_header hdr{};
-    auto result = vcr_read_movie_header(buf, &hdr);
+        if (!file)
+        {
+            return VCR_BadFile;
+        }
+
+        result = vcr_read_movie_header(file->data(), &hdr);
+    }
 
     if (result != Res_Ok)
     {
@@ -1254,9 +1418,10 @@ core_result vcr_start_playback(std::filesystem::path path)
 {
     std::unique_lock lock(vcr_mtx);
 
-    auto movie_buf = IOUtils::read_entire_file(path);
+    // The inputs are served from the file's mapping during playback, so long movies don't have to be read upfront.
+    const auto movie_file = t_mapped_file::open(path);
 
-    if (movie_buf.empty())
+    if (!movie_file)
     {
         return VCR_BadFile;
     }
@@ -1278,17 +1443,13 @@ core_result vcr_start_playback(std::filesystem::path path)
     }
 
     core_vcr_movie_header header{};
-    const auto result = vcr_read_movie_header(movie_buf, &header);
+    t_movie_inputs movie_inputs{};
+    const auto result = vcr_read_mapped_movie(movie_file, &header, movie_inputs);
     if (result != Res_Ok)
     {
         return result;
     }
 
-    std::vector<core_buttons> movie_inputs{};
-    movie_inputs.resize(header.length_samples);
-    memcpy(movie_inputs.data(), movie_buf.data() + sizeof(core_vcr_movie_header),
-           sizeof(core_buttons) * header.length_samples);
-
     for (auto &[Present, RawData, Plugin] : g_core->controls)
     {
         if (!Present || !RawData) continue;
@@ -1408,8 +1569,9 @@ core_result vcr_start_playback(std::filesystem::path path)
     vcr.current_sample = 0;
     vcr.current_vi = 0;
     vcr.movie_path = path;
-    vcr.inputs = movie_inputs;
+    vcr.inputs = std::move(movie_inputs);
     vcr.hdr = header;
+    movie_writer_reset(vcr.movie_writer);
 
     if (header.startFlags & MOVIE_START_FROM_SNAPSHOT)
     {
@@ -1503,26 +1665,9 @@ static size_t compute_sample_from_seek_string(const std::string &str)
 
 size_t vcr_find_closest_savestate_before_frame(size_t frame)
 {
-    int32_t lowest_distance = INT32_MAX;
-    size_t lowest_distance_frame = 0;
-    for (const auto &[slot_frame, _] : vcr.seek_savestates)
-    {
-        // Current and future sts are invalid for rewinding
-        if (slot_frame >= frame)
-        {
-            continue;
-        }
-
-        auto distance = frame - slot_frame;
-
-        if (distance < lowest_distance)
-        {
-            lowest_distance = distance;
-            lowest_distance_frame = slot_frame;
-        }
-    }
-
-    return lowest_distance_frame;
+    // Current and future sts are invalid for rewinding
+    const auto st = vcr.seek_savestates.find_before(frame);
+    return st ? st->frame : 0;
 }
 
 static core_result vcr_begin_seek_impl(std::string str, bool pause_at_end, bool resume, bool warp_modify)
@@ -1607,11 +1752,13 @@ static core_result vcr_begin_seek_impl(std::string str, bool pause_at_end, bool
                 "[VCR] Seeking during playback to frame {}, loading closest savestate at {}...", frame, closest_key));
             vcr.seek_savestate_loading = true;
 
+            auto st = vcr_get_seek_savestate(closest_key);
+
             // NOTE: This needs to go through AsyncExecutor (despite us already being on a worker thread) or it will
             // cause a deadlock.
-            g_core->submit_task([=] {
+            g_core->submit_task([=, st = std::move(st)] {
                 g_ctx.st_do_memory(
-                    vcr.seek_savestates[closest_key], core_st_job_load,
+                    st, core_st_job_load,
                     [=](const core_st_callback_info &info, auto &&...) {
                         if (info.result != Res_Ok)
                         {
@@ -1678,18 +1825,10 @@ static core_result vcr_begin_seek_impl(std::string str, bool pause_at_end, bool
         // inputs prior to them
         if (!g_core->cfg->vcr_readonly)
         {
-            std::vector<size_t> to_erase;
-            for (const auto &[sample, _] : vcr.seek_savestates)
+            vcr_discard_seek_prefetch(target_sample);
+            for (const auto sample : vcr.seek_savestates.erase_range(target_sample, SIZE_MAX))
             {
-                if (sample >= target_sample)
-                {
-                    to_erase.push_back(sample);
-                }
-            }
-            for (const auto sample : to_erase)
-            {
-                g_core->log_info(std::format("[VCR] Erasing now-invalidated seek savestate at frame {}...", sample));
-                vcr.seek_savestates.erase(sample);
+                g_core->log_info(std::format("[VCR] Erased now-invalidated seek savestate at frame {}...", sample));
                 post_unlock_callbacks.push([=] { g_core->callbacks.seek_savestate_changed(sample); });
             }
         }
@@ -1703,11 +1842,13 @@ static core_result vcr_begin_seek_impl(std::string str, bool pause_at_end, bool
                         target_sample, closest_key));
         vcr.seek_savestate_loading = true;
 
+        auto st = vcr_get_seek_savestate(closest_key);
+
         // NOTE: This needs to go through AsyncExecutor (despite us already being on a worker thread) or it will cause a
         // deadlock.
-        g_core->submit_task([=] {
+        g_core->submit_task([=, st = std::move(st)] {
             g_ctx.st_do_memory(
-                vcr.seek_savestates[closest_key], core_st_job_load,
+                st, core_st_job_load,
                 [=](const core_st_callback_info &info, auto &&...) {
                     if (info.result != Res_Ok)
                     {
@@ -1746,6 +1887,64 @@ core_result vcr_begin_seek(std::string str, bool pause_at_end)
     return vcr_begin_seek_impl(str, pause_at_end, true, false);
 }
 
+void vcr_prefetch_seek(std::string str, bool pause_at_end)
+{
+    std::unique_lock lock(vcr_mtx);
+
+    if (vcr.task == task_idle || g_core->cfg->seek_savestate_interval == 0)
+    {
+        return;
+    }
+
+    // Mirror the target computation of vcr_begin_seek_impl.
+    auto frame = compute_sample_from_seek_string(str);
+    if (frame == SIZE_MAX || !can_seek_to(frame) || (pause_at_end && !can_seek_to(--frame)))
+    {
+        return;
+    }
+
+    // Seeks ahead of the current sample just continue emulating without loading a seek savestate.
+    if (vcr.current_sample <= frame)
+    {
+        return;
+    }
+
+    const auto closest = vcr.seek_savestates.find_before(frame);
+    if (!closest || closest->frame == vcr.seek_prefetch.frame)
+    {
+        return;
+    }
+
+    vcr_discard_seek_prefetch();
+    vcr.seek_prefetch.frame = closest->frame;
+    const auto generation = ++vcr.seek_prefetch.generation;
+
+    g_core->log_trace(std::format("[VCR] Prefetching seek savestate at frame {}...", closest->frame));
+
+    // The delta is small, so it's copied. The keyframe is shared, as it's never modified once created.
+    g_core->submit_task([frame = closest->frame, generation, keyframe = closest->keyframe,
+                         delta = closest->data] {
+        std::vector<uint8_t> st;
+        const bool decoded = st_delta_decode(*keyframe, delta, st);
+
+        std::unique_lock lock(vcr_mtx);
+
+        if (vcr.seek_prefetch.generation != generation)
+        {
+            return;
+        }
+
+        if (!decoded)
+        {
+            g_core->log_error(std::format("[VCR] Failed to prefetch seek savestate at frame {}", frame));
+            vcr_discard_seek_prefetch();
+            return;
+        }
+
+        vcr.seek_prefetch.st = std::move(st);
+    });
+}
+
 void vcr_stop_seek()
 {
     // We need to acquire the mutex here, as this function is also called during input poll
@@ -1789,14 +1988,9 @@ static void vcr_clear_seek_savestates(std::queue<std::function<void()>> &post_un
 {
     g_core->log_info("[VCR] Clearing seek savestates...");
 
-    std::vector<size_t> prev_seek_savestate_keys;
-    prev_seek_savestate_keys.reserve(vcr.seek_savestates.size());
-    for (const auto &[key, _] : vcr.seek_savestates)
-    {
-        prev_seek_savestate_keys.push_back(key);
-    }
-
-    vcr.seek_savestates.clear();
+    const auto prev_seek_savestate_keys = vcr.seek_savestates.erase_range(0, SIZE_MAX);
+    vcr.seek_savestate_keyframe = nullptr;
+    vcr_discard_seek_prefetch();
 
     for (const auto frame : prev_seek_savestate_keys)
     {
@@ -1847,7 +2041,7 @@ core_result vcr_stop_all()
 
         if (vcr.task == task_recording)
         {
-            write_movie();
+            write_movie(true);
 
             vcr.task = task_idle;
 
@@ -1855,6 +2049,8 @@ core_result vcr_stop_all()
                 std::format("[VCR] Recording stopped. Recorded %ld input samples", vcr.hdr.length_samples));
         }
 
+        vcr.inputs = {};
+
         {
             vcr_anti_lock bypass;
             execute_post_unlock_callbacks(post_unlock_callbacks);
@@ -1869,6 +2065,9 @@ core_result vcr_stop_all()
         vcr.task = task_idle;
         cht_layer_pop();
 
+        // Releases the movie file's mapping, which keeps other processes from modifying the file.
+        vcr.inputs = {};
+
         {
             vcr_anti_lock bypass;
             execute_post_unlock_callbacks(post_unlock_callbacks);
@@ -1914,11 +2113,17 @@ int32_t vcr_get_current_vi()
 std::vector<core_buttons> vcr_get_inputs()
 {
     std::unique_lock lock(vcr_mtx);
-    return vcr.inputs;
+    return {vcr.inputs.begin(), vcr.inputs.end()};
+}
+
+void vcr_view_inputs(const std::function<void(std::span<const core_buttons>)> &func)
+{
+    std::unique_lock lock(vcr_mtx);
+    func(vcr.inputs);
 }
 
 /// Finds the first input difference between two input vectors. Returns SIZE_MAX if they are identical.
-size_t vcr_find_first_input_difference(const std::vector<core_buttons> &first, const std::vector<core_buttons> &second)
+size_t vcr_find_first_input_difference(std::span<const core_buttons> first, std::span<const core_buttons> second)
 {
     if (first.size() != second.size())
     {
@@ -1986,6 +2191,7 @@ core_result vcr_begin_warp_modify(const std::vector<core_buttons> &inputs)
 
         vcr.inputs = inputs;
         vcr.hdr.length_samples = vcr.inputs.size();
+        movie_writer_invalidate(vcr.movie_writer, vcr.warp_modify_first_difference_frame);
 
         vcr.warp_modify_active = false;
         vcr_increment_rerecord_count();
@@ -2015,6 +2221,7 @@ core_result vcr_begin_warp_modify(const std::vector<core_buttons> &inputs)
 
     vcr.inputs = inputs;
     vcr.hdr.length_samples = vcr.inputs.size();
+    movie_writer_invalidate(vcr.movie_writer, vcr.warp_modify_first_difference_frame);
     vcr.warp_modify_active = true;
     g_ctx.vr_resume_emu();
 
@@ -2047,9 +2254,9 @@ void vcr_get_seek_savestate_frames(std::unordered_map<size_t, bool> &map)
 
     map.clear();
 
-    for (const auto &[key, _] : vcr.seek_savestates)
+    for (const auto &st : vcr.seek_savestates)
     {
-        map[key] = true;
+        map[st.frame] = true;
     }
 }
 
@@ -7,6 +7,50 @@
 #pragma once
 
 #include <core_api.h>
+#include <r4300/movie_inputs.h>
+#include <r4300/movie_writer.h>
+#include <r4300/seek_savestate_index.h>
+
+// A seek savestate becomes the new keyframe once its delta exceeds the raw savestate's size divided by this value.
+constexpr size_t SEEK_SAVESTATE_REKEY_DIVISOR = 4;
+
+/**
+ * \brief A notification raised while handling a controller poll.
+ */
+typedef enum
+{
+    vcr_event_sample_changed,
+    vcr_event_seek_savestate_changed,
+    vcr_event_loop_movie,
+} vcr_event_type;
+
+/**
+ * \brief A notification which is delivered to the host once the VCR lock is released at the end of a controller poll.
+ */
+struct t_vcr_event
+{
+    /// The kind of notification.
+    vcr_event_type type;
+
+    /// The notification's argument, captured when it was raised. Unused for vcr_event_loop_movie.
+    int32_t value;
+};
+
+/**
+ * \brief A seek savestate which is decoded ahead of the seek that loads it.
+ */
+struct t_seek_prefetch
+{
+    /// The frame of the seek savestate, or SIZE_MAX if none is prefetched.
+    size_t frame = SIZE_MAX;
+
+    /// The decoded savestate. Empty while it's still being decoded.
+    std::vector<uint8_t> st;
+
+    /// Incremented whenever a prefetch is started or discarded, which lets a decode that finishes late detect that
+    /// its result is no longer wanted.
+    uint64_t generation{};
+};
 
 struct t_vcr_state
 {
@@ -19,19 +63,33 @@ struct t_vcr_state
     size_t seek_start_sample{};
     bool seek_pause_at_end{};
     bool seek_savestate_loading{};
-    std::unordered_map<size_t, std::vector<uint8_t>> seek_savestates{};
+    // Seek savestates ordered by frame, each stored as a delta against the keyframe current at its creation. See
+    // st_delta.h.
+    t_seek_savestate_index seek_savestates{};
+    // The raw savestate which new seek savestate deltas are encoded against. Null if no seek savestate has been
+    // created. Replaced once deltas grow too large, see vcr_create_n_frame_savestate. Immutable once created, so
+    // prefetch workers can decode against it without holding the lock.
+    std::shared_ptr<const std::vector<uint8_t>> seek_savestate_keyframe{};
+    // The seek savestate the next seek is expected to load, decoded in the background. See vcr_prefetch_seek.
+    t_seek_prefetch seek_prefetch{};
 
     bool warp_modify_active{};
     size_t warp_modify_first_difference_frame{};
 
     core_vcr_movie_header hdr{};
-    std::vector<core_buttons> inputs{};
+    t_movie_inputs inputs{};
+    // Tracks what was last written to the movie file. Must be invalidated when already written inputs are modified.
+    t_movie_writer movie_writer{};
 
     int32_t current_sample = -1;
     int32_t current_vi = -1;
 
     bool reset_requested{};
-    std::queue<std::function<void()>> post_controller_poll_callbacks{};
+
+    // Notifications raised during the current controller poll. A poll raises at most a few, so they live in a fixed
+    // buffer instead of being allocated every frame.
+    std::array<t_vcr_event, 8> pending_events{};
+    size_t pending_event_count{};
 };
 
 /**
@@ -70,7 +128,7 @@ bool vcr_allows_core_pause();
 bool vcr_allows_core_unpause();
 bool vcr_is_frame_skipped();
 void vcr_request_reset();
-core_result vcr_read_movie_header(std::vector<uint8_t> buf, core_vcr_movie_header *header);
+core_result vcr_read_movie_header(std::span<const uint8_t> buf, core_vcr_movie_header *header);
 core_result vcr_parse_header(std::filesystem::path path, core_vcr_movie_header *header);
 core_result vcr_read_movie_inputs(std::filesystem::path path, std::vector<core_buttons> &inputs);
 core_result vcr_start_playback(std::filesystem::path path);
@@ -80,8 +138,21 @@ core_result vcr_replace_author_info(const std::filesystem::path &path, std::stri
                                     std::string_view description);
 core_vcr_seek_info vcr_get_seek_info();
 core_result vcr_begin_seek(std::string str, bool pause_at_end);
+
+/**
+ * \brief Decodes the seek savestate which a seek with the specified parameters would load in the background.
+ * \param str A seek format string. See vcr_begin_seek.
+ * \param pause_at_end Whether the seek would pause the emu when it ends.
+ */
+void vcr_prefetch_seek(std::string str, bool pause_at_end);
 void vcr_stop_seek();
 bool vcr_is_seeking();
+
+/**
+ * \brief Creates a seek savestate at the current frame.
+ * \param frame The current frame.
+ */
+void vcr_create_n_frame_savestate(size_t frame);
 bool vcr_freeze(vcr_freeze_info &freeze);
 core_result vcr_unfreeze(const vcr_freeze_info &freeze);
 core_result vcr_write_backup();
@@ -92,6 +163,7 @@ uint32_t vcr_get_length_samples();
 uint32_t vcr_get_length_vis();
 int32_t vcr_get_current_vi();
 std::vector<core_buttons> vcr_get_inputs();
+void vcr_view_inputs(const std::function<void(std::span<const core_buttons>)> &func);
 core_result vcr_begin_warp_modify(const std::vector<core_buttons> &inputs);
 bool vcr_get_warp_modify_status();
 size_t vcr_get_warp_modify_first_difference_frame();
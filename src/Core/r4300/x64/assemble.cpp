@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <r4300/x64/assemble.h>
+#include <optional>
+
+static std::vector<uint8_t> *out;
+
+void x64_init_assembler(std::vector<uint8_t> *code)
+{
+    out = code;
+}
+
+static void put8(const uint8_t octet)
+{
+    out->push_back(octet);
+}
+
+static void put32(const uint32_t dword)
+{
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        put8((uint8_t)(dword >> i * 8));
+    }
+}
+
+static void put64(const uint64_t qword)
+{
+    put32((uint32_t)qword);
+    put32((uint32_t)(qword >> 32));
+}
+
+/**
+ * \brief Emits a REX prefix if the instruction needs one.
+ * \param w Whether the operand size is 64 bits.
+ * \param reg The register in the ModRM reg field, or the opcode extension.
+ * \param rm The register in the ModRM rm field.
+ * \param byte Whether rm is accessed as a byte register, which needs a REX prefix to address SPL to DIL.
+ */
+static void rex(const bool w, const uint8_t reg, const uint8_t rm, const bool byte = false)
+{
+    const uint8_t prefix = 0x40 | w << 3 | (reg >> 3 & 1) << 2 | (rm >> 3 & 1);
+    if (prefix != 0x40 || (byte && rm >= 4))
+    {
+        put8(prefix);
+    }
+}
+
+static void modrm(const uint8_t mod, const uint8_t reg, const uint8_t rm)
+{
+    put8(mod << 6 | (reg & 7) << 3 | (rm & 7));
+}
+
+/**
+ * \brief Emits an instruction operating on two registers.
+ * \param opcode The opcode, whose ModRM reg field holds <c>reg</c> and rm field <c>rm</c>.
+ */
+static void op_reg_reg(const uint8_t opcode, const bool w, const uint8_t reg, const uint8_t rm)
+{
+    rex(w, reg, rm);
+    put8(opcode);
+    modrm(3, reg, rm);
+}
+
+/**
+ * \brief Emits an instruction operating on a register and a memory operand at a base register plus a displacement.
+ */
+static void op_reg_mem(const uint8_t opcode, const uint8_t reg, const uint8_t base, const int32_t disp)
+{
+    rex(true, reg, base);
+    put8(opcode);
+    modrm(2, reg, base);
+    if ((base & 7) == RSP)
+    {
+        put8(0x24);
+    }
+    put32(disp);
+}
+
+/**
+ * \brief Emits a group 1 instruction (<c>81 /ext id</c>) with a register operand.
+ */
+static void group1_imm32(const uint8_t ext, const bool w, const uint8_t reg, const int32_t imm32)
+{
+    rex(w, ext, reg);
+    put8(0x81);
+    modrm(3, ext, reg);
+    put32(imm32);
+}
+
+/**
+ * \brief Emits a shift by an immediate (<c>C1 /ext ib</c>) or by CL (<c>D3 /ext</c>).
+ */
+static void shift(const uint8_t ext, const bool w, const uint8_t reg, const std::optional<uint8_t> imm8)
+{
+    rex(w, ext, reg);
+    put8(imm8 ? 0xC1 : 0xD3);
+    modrm(3, ext, reg);
+    if (imm8)
+    {
+        put8(*imm8);
+    }
+}
+
+static void setcc(const uint8_t cc, const uint8_t reg8)
+{
+    rex(false, 0, reg8, true);
+    put8(0x0F);
+    put8(0x90 | cc);
+    modrm(3, 0, reg8);
+}
+
+void mov_reg64_reg64(const x64_reg reg1, const x64_reg reg2)
+{
+    op_reg_reg(0x89, true, reg2, reg1);
+}
+
+void mov_reg32_reg32(const x64_reg reg1, const x64_reg reg2)
+{
+    op_reg_reg(0x89, false, reg2, reg1);
+}
+
+void mov_reg64_imm64(const x64_reg reg64, const uint64_t imm64)
+{
+    rex(true, 0, reg64);
+    put8(0xB8 | (reg64 & 7));
+    put64(imm64);
+}
+
+void mov_reg64_simm32(const x64_reg reg64, const int32_t imm32)
+{
+    rex(true, 0, reg64);
+    put8(0xC7);
+    modrm(3, 0, reg64);
+    put32(imm32);
+}
+
+void mov_reg64_m64(const x64_reg reg64, const x64_reg base, const int32_t disp)
+{
+    op_reg_mem(0x8B, reg64, base, disp);
+}
+
+void mov_m64_reg64(const x64_reg base, const int32_t disp, const x64_reg reg64)
+{
+    op_reg_mem(0x89, reg64, base, disp);
+}
+
+void movsxd_reg64_reg32(const x64_reg reg64, const x64_reg reg32)
+{
+    op_reg_reg(0x63, true, reg64, reg32);
+}
+
+void movzx_reg32_reg8(const x64_reg reg32, const x64_reg reg8)
+{
+    rex(false, reg32, reg8, true);
+    put8(0x0F);
+    put8(0xB6);
+    modrm(3, reg32, reg8);
+}
+
+void add_reg32_reg32(const x64_reg reg1, const x64_reg reg2)
+{
+    op_reg_reg(0x01, false, reg2, reg1);
+}
+
+void sub_reg32_reg32(const x64_reg reg1, const x64_reg reg2)
+{
+    op_reg_reg(0x29, false, reg2, reg1);
+}
+
+void add_reg64_reg64(const x64_reg reg1, const x64_reg reg2)
+{
+    op_reg_reg(0x01, true, reg2, reg1);
+}
+
+void sub_reg64_reg64(const x64_reg reg1, const x64_reg reg2)
+{
+    op_reg_reg(0x29, true, reg2, reg1);
+}
+
+void and_reg64_reg64(const x64_reg reg1, const x64_reg reg2)
+{
+    op_reg_reg(0x21, true, reg2, reg1);
+}
+
+void or_reg64_reg64(const x64_reg reg1, const x64_reg reg2)
+{
+    op_reg_reg(0x09, true, reg2, reg1);
+}
+
+void xor_reg64_reg64(const x64_reg reg1, const x64_reg reg2)
+{
+    op_reg_reg(0x31, true, reg2, reg1);
+}
+
+void cmp_reg64_reg64(const x64_reg reg1, const x64_reg reg2)
+{
+    op_reg_reg(0x39, true, reg2, reg1);
+}
+
+void not_reg64(const x64_reg reg64)
+{
+    rex(true, 2, reg64);
+    put8(0xF7);
+    modrm(3, 2, reg64);
+}
+
+void add_reg32_imm32(const x64_reg reg32, const int32_t imm32)
+{
+    group1_imm32(0, false, reg32, imm32);
+}
+
+void and_reg64_imm32(const x64_reg reg64, const int32_t imm32)
+{
+    group1_imm32(4, true, reg64, imm32);
+}
+
+void or_reg64_imm32(const x64_reg reg64, const int32_t imm32)
+{
+    group1_imm32(1, true, reg64, imm32);
+}
+
+void xor_reg64_imm32(const x64_reg reg64, const int32_t imm32)
+{
+    group1_imm32(6, true, reg64, imm32);
+}
+
+void cmp_reg64_imm32(const x64_reg reg64, const int32_t imm32)
+{
+    group1_imm32(7, true, reg64, imm32);
+}
+
+void shl_reg32_imm8(const x64_reg reg32, const uint8_t imm8)
+{
+    shift(4, false, reg32, imm8);
+}
+
+void shr_reg32_imm8(const x64_reg reg32, const uint8_t imm8)
+{
+    shift(5, false, reg32, imm8);
+}
+
+void sar_reg32_imm8(const x64_reg reg32, const uint8_t imm8)
+{
+    shift(7, false, reg32, imm8);
+}
+
+void shl_reg64_imm8(const x64_reg reg64, const uint8_t imm8)
+{
+    shift(4, true, reg64, imm8);
+}
+
+void shr_reg64_imm8(const x64_reg reg64, const uint8_t imm8)
+{
+    shift(5, true, reg64, imm8);
+}
+
+void sar_reg64_imm8(const x64_reg reg64, const uint8_t imm8)
+{
+    shift(7, true, reg64, imm8);
+}
+
+void shl_reg32_cl(const x64_reg reg32)
+{
+    shift(4, false, reg32, std::nullopt);
+}
+
+void shr_reg32_cl(const x64_reg reg32)
+{
+    shift(5, false, reg32, std::nullopt);
+}
+
+void sar_reg32_cl(const x64_reg reg32)
+{
+    shift(7, false, reg32, std::nullopt);
+}
+
+void shl_reg64_cl(const x64_reg reg64)
+{
+    shift(4, true, reg64, std::nullopt);
+}
+
+void shr_reg64_cl(const x64_reg reg64)
+{
+    shift(5, true, reg64, std::nullopt);
+}
+
+void sar_reg64_cl(const x64_reg reg64)
+{
+    shift(7, true, reg64, std::nullopt);
+}
+
+void setl_reg8(const x64_reg reg8)
+{
+    setcc(0xC, reg8);
+}
+
+void setb_reg8(const x64_reg reg8)
+{
+    setcc(0x2, reg8);
+}
+
+void push_reg64(const x64_reg reg64)
+{
+    rex(false, 0, reg64);
+    put8(0x50 | (reg64 & 7));
+}
+
+void pop_reg64(const x64_reg reg64)
+{
+    rex(false, 0, reg64);
+    put8(0x58 | (reg64 & 7));
+}
+
+void ret()
+{
+    put8(0xC3);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+// The x86-64 general purpose registers, numbered as in their encoding.
+enum x64_reg : uint8_t
+{
+    RAX,
+    RCX,
+    RDX,
+    RBX,
+    RSP,
+    RBP,
+    RSI,
+    RDI,
+    R8,
+    R9,
+    R10,
+    R11,
+    R12,
+    R13,
+    R14,
+    R15,
+};
+
+/**
+ * \brief Directs the emitted code into a buffer, appending to its contents.
+ */
+void x64_init_assembler(std::vector<uint8_t> *code);
+
+void mov_reg64_reg64(x64_reg reg1, x64_reg reg2);
+void mov_reg32_reg32(x64_reg reg1, x64_reg reg2);
+void mov_reg64_imm64(x64_reg reg64, uint64_t imm64);
+void mov_reg64_simm32(x64_reg reg64, int32_t imm32);
+void mov_reg64_m64(x64_reg reg64, x64_reg base, int32_t disp);
+void mov_m64_reg64(x64_reg base, int32_t disp, x64_reg reg64);
+void movsxd_reg64_reg32(x64_reg reg64, x64_reg reg32);
+void movzx_reg32_reg8(x64_reg reg32, x64_reg reg8);
+
+void add_reg32_reg32(x64_reg reg1, x64_reg reg2);
+void sub_reg32_reg32(x64_reg reg1, x64_reg reg2);
+void add_reg64_reg64(x64_reg reg1, x64_reg reg2);
+void sub_reg64_reg64(x64_reg reg1, x64_reg reg2);
+void and_reg64_reg64(x64_reg reg1, x64_reg reg2);
+void or_reg64_reg64(x64_reg reg1, x64_reg reg2);
+void xor_reg64_reg64(x64_reg reg1, x64_reg reg2);
+void cmp_reg64_reg64(x64_reg reg1, x64_reg reg2);
+void not_reg64(x64_reg reg64);
+
+void add_reg32_imm32(x64_reg reg32, int32_t imm32);
+void and_reg64_imm32(x64_reg reg64, int32_t imm32);
+void or_reg64_imm32(x64_reg reg64, int32_t imm32);
+void xor_reg64_imm32(x64_reg reg64, int32_t imm32);
+void cmp_reg64_imm32(x64_reg reg64, int32_t imm32);
+
+void shl_reg32_imm8(x64_reg reg32, uint8_t imm8);
+void shr_reg32_imm8(x64_reg reg32, uint8_t imm8);
+void sar_reg32_imm8(x64_reg reg32, uint8_t imm8);
+void shl_reg64_imm8(x64_reg reg64, uint8_t imm8);
+void shr_reg64_imm8(x64_reg reg64, uint8_t imm8);
+void sar_reg64_imm8(x64_reg reg64, uint8_t imm8);
+void shl_reg32_cl(x64_reg reg32);
+void shr_reg32_cl(x64_reg reg32);
+void sar_reg32_cl(x64_reg reg32);
+void shl_reg64_cl(x64_reg reg64);
+void shr_reg64_cl(x64_reg reg64);
+void sar_reg64_cl(x64_reg reg64);
+
+void setl_reg8(x64_reg reg8);
+void setb_reg8(x64_reg reg8);
+
+void push_reg64(x64_reg reg64);
+void pop_reg64(x64_reg reg64);
+void ret();
@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <Core.h>
+#include <alloc.h>
+#include <r4300/r4300.h>
+#include <r4300/recomp.h>
+#include <r4300/x64/assemble.h>
+#include <r4300/x64/regcache.h>
+#include <optional>
+
+// The experimental x86-64 integer JIT is the cached interpreter with straight-line runs of integer ALU instructions
+// compiled to host code. Those are the instructions the threaded interpreter translates, and their runs keep the MIPS
+// registers in host registers.
+// Everything else (jumps, branches, memory accesses, coprocessors, ...) runs through the instruction's ops between
+// runs, so exceptions and interrupt timing are identical to the cached interpreter.
+//
+// A compiled run is a leaf function which only touches reg, hi and lo, and points PC past the run before returning.
+// Runs are compiled lazily for each instruction they're entered at, and dropped whenever their block is (re)compiled.
+
+// The size of the buffer holding all compiled runs. It's emptied when full.
+constexpr size_t CODE_CACHE_SIZE = 16 * 1024 * 1024;
+
+// The maximum amount of instructions in a run, which bounds the size of a run's code.
+constexpr size_t MAX_RUN_LENGTH = 256;
+
+// The callee-saved registers a run may use, which it has to save in both the System V and the Windows calling
+// convention.
+constexpr x64_reg SAVED_REGISTERS[] = {RBX, RBP, RSI, RDI, R12, R13, R14, R15};
+
+static uint8_t *code_cache;
+static size_t code_cache_used;
+
+/**
+ * \brief Gets the amount of instructions a block holds, excluding the overflow area past its end.
+ */
+static size_t block_length(const precomp_block *block)
+{
+    return (block->end - block->start) / 4;
+}
+
+void x64_invalidate(precomp_block *block)
+{
+    if (!block->x64_entries)
+    {
+        return;
+    }
+    memset(block->x64_entries, 0, block_length(block) * sizeof(void *));
+}
+
+/**
+ * \brief Drops all compiled runs.
+ */
+static void flush_code_cache()
+{
+    for (const auto block : blocks)
+    {
+        if (block)
+        {
+            x64_invalidate(block);
+        }
+    }
+    code_cache_used = 0;
+}
+
+/**
+ * \brief Gets the displacement of a variable from <c>reg</c>, which is how the compiled code addresses it.
+ * \return The displacement, or nothing if it doesn't fit into 32 bits.
+ */
+static std::optional<int32_t> reg_displacement(const void *ptr)
+{
+    const auto disp = (intptr_t)ptr - (intptr_t)reg;
+    if (disp < INT32_MIN || disp > INT32_MAX)
+    {
+        return std::nullopt;
+    }
+    return (int32_t)disp;
+}
+
+/**
+ * \brief Writes RAX to a MIPS register.
+ */
+static void store_rax(const uint8_t mips_reg)
+{
+    mov_reg64_reg64(x64_allocate_register_w(mips_reg), RAX);
+}
+
+/**
+ * \brief Sign-extends EAX and writes it to a MIPS register.
+ */
+static void store_eax(const uint8_t mips_reg)
+{
+    movsxd_reg64_reg32(RAX, RAX);
+    store_rax(mips_reg);
+}
+
+/**
+ * \brief Emits a 32-bit shift of rt by the amount in rs, like SLLV and friends.
+ */
+static void gen_shift32_variable(const threaded_instr &ti, void (*shift)(x64_reg))
+{
+    const x64_reg rs = x64_allocate_register(ti.rs);
+    const x64_reg rt = x64_allocate_register(ti.rt);
+    mov_reg32_reg32(RCX, rs);
+    mov_reg32_reg32(RAX, rt);
+    shift(RAX);
+    store_eax(ti.rd);
+}
+
+/**
+ * \brief Emits a 64-bit shift of rt by the amount in rs, like DSLLV and friends.
+ */
+static void gen_shift64_variable(const threaded_instr &ti, void (*shift)(x64_reg))
+{
+    const x64_reg rs = x64_allocate_register(ti.rs);
+    const x64_reg rt = x64_allocate_register(ti.rt);
+    mov_reg32_reg32(RCX, rs);
+    mov_reg64_reg64(RAX, rt);
+    shift(RAX);
+    store_rax(ti.rd);
+}
+
+/**
+ * \brief Emits an operation on rs and rt whose result is written to rd.
+ */
+static void gen_r_type(const threaded_instr &ti, void (*op)(x64_reg, x64_reg), const bool sign_extend)
+{
+    const x64_reg rs = x64_allocate_register(ti.rs);
+    const x64_reg rt = x64_allocate_register(ti.rt);
+    if (sign_extend)
+    {
+        mov_reg32_reg32(RAX, rs);
+        op(RAX, rt);
+        store_eax(ti.rd);
+    }
+    else
+    {
+        mov_reg64_reg64(RAX, rs);
+        op(RAX, rt);
+        store_rax(ti.rd);
+    }
+}
+
+/**
+ * \brief Emits a comparison of rs with rt or an immediate, whose result is written to rd or rt.
+ */
+static void gen_set(const threaded_instr &ti, void (*set)(x64_reg), const bool immediate)
+{
+    const x64_reg rs = x64_allocate_register(ti.rs);
+    if (immediate)
+    {
+        cmp_reg64_imm32(rs, ti.imm);
+    }
+    else
+    {
+        cmp_reg64_reg64(rs, x64_allocate_register(ti.rt));
+    }
+    set(RAX);
+    movzx_reg32_reg8(RAX, RAX);
+    store_rax(immediate ? ti.rt : ti.rd);
+}
+
+/**
+ * \brief Emits a logical operation on rs and a zero-extended immediate, whose result is written to rt.
+ */
+static void gen_logical_immediate(const threaded_instr &ti, void (*op)(x64_reg, int32_t))
+{
+    mov_reg64_reg64(RAX, x64_allocate_register(ti.rs));
+    op(RAX, ti.imm);
+    store_rax(ti.rt);
+}
+
+/**
+ * \brief Emits an instruction.
+ * \return Whether the instruction could be emitted. If not, nothing was emitted.
+ */
+static bool gen_instruction(const threaded_instr &ti)
+{
+    static const auto hi_disp = reg_displacement(&hi);
+    static const auto lo_disp = reg_displacement(&lo);
+
+    switch (ti.op)
+    {
+    case TI_NOP:
+        break;
+    case TI_SLL:
+    case TI_SRL:
+    case TI_SRA:
+        mov_reg32_reg32(RAX, x64_allocate_register(ti.rt));
+        if (ti.op == TI_SLL)
+        {
+            shl_reg32_imm8(RAX, (uint8_t)ti.imm);
+        }
+        else if (ti.op == TI_SRL)
+        {
+            shr_reg32_imm8(RAX, (uint8_t)ti.imm);
+        }
+        else
+        {
+            sar_reg32_imm8(RAX, (uint8_t)ti.imm);
+        }
+        store_eax(ti.rd);
+        break;
+    case TI_SLLV:
+        gen_shift32_variable(ti, shl_reg32_cl);
+        break;
+    case TI_SRLV:
+        gen_shift32_variable(ti, shr_reg32_cl);
+        break;
+    case TI_SRAV:
+        gen_shift32_variable(ti, sar_reg32_cl);
+        break;
+    case TI_MFHI:
+    case TI_MFLO: {
+        const auto disp = ti.op == TI_MFHI ? hi_disp : lo_disp;
+        if (!disp)
+        {
+            return false;
+        }
+        mov_reg64_m64(RAX, X64_REG_BASE, *disp);
+        store_rax(ti.rd);
+        break;
+    }
+    case TI_MTHI:
+    case TI_MTLO: {
+        const auto disp = ti.op == TI_MTHI ? hi_disp : lo_disp;
+        if (!disp)
+        {
+            return false;
+        }
+        mov_m64_reg64(X64_REG_BASE, *disp, x64_allocate_register(ti.rs));
+        break;
+    }
+    case TI_DSLLV:
+        gen_shift64_variable(ti, shl_reg64_cl);
+        break;
+    case TI_DSRLV:
+        gen_shift64_variable(ti, shr_reg64_cl);
+        break;
+    case TI_DSRAV:
+        gen_shift64_variable(ti, sar_reg64_cl);
+        break;
+    case TI_ADDU:
+        gen_r_type(ti, add_reg32_reg32, true);
+        break;
+    case TI_SUBU:
+        gen_r_type(ti, sub_reg32_reg32, true);
+        break;
+    case TI_AND:
+        gen_r_type(ti, and_reg64_reg64, false);
+        break;
+    case TI_OR:
+        gen_r_type(ti, or_reg64_reg64, false);
+        break;
+    case TI_XOR:
+        gen_r_type(ti, xor_reg64_reg64, false);
+        break;
+    case TI_NOR: {
+        const x64_reg rs = x64_allocate_register(ti.rs);
+        const x64_reg rt = x64_allocate_register(ti.rt);
+        mov_reg64_reg64(RAX, rs);
+        or_reg64_reg64(RAX, rt);
+        not_reg64(RAX);
+        store_rax(ti.rd);
+        break;
+    }
+    case TI_SLT:
+        gen_set(ti, setl_reg8, false);
+        break;
+    case TI_SLTU:
+        gen_set(ti, setb_reg8, false);
+        break;
+    case TI_DADDU:
+        gen_r_type(ti, add_reg64_reg64, false);
+        break;
+    case TI_DSUBU:
+        gen_r_type(ti, sub_reg64_reg64, false);
+        break;
+    case TI_DSLL:
+    case TI_DSRL:
+    case TI_DSRA:
+    case TI_DSLL32:
+    case TI_DSRL32:
+    case TI_DSRA32: {
+        const bool upper = ti.op == TI_DSLL32 || ti.op == TI_DSRL32 || ti.op == TI_DSRA32;
+        const uint8_t sa = (uint8_t)(ti.imm + (upper ? 32 : 0));
+        mov_reg64_reg64(RAX, x64_allocate_register(ti.rt));
+        if (ti.op == TI_DSLL || ti.op == TI_DSLL32)
+        {
+            shl_reg64_imm8(RAX, sa);
+        }
+        else if (ti.op == TI_DSRL || ti.op == TI_DSRL32)
+        {
+            shr_reg64_imm8(RAX, sa);
+        }
+        else
+        {
+            sar_reg64_imm8(RAX, sa);
+        }
+        store_rax(ti.rd);
+        break;
+    }
+    case TI_ADDIU:
+        mov_reg32_reg32(RAX, x64_allocate_register(ti.rs));
+        add_reg32_imm32(RAX, ti.imm);
+        store_eax(ti.rt);
+        break;
+    case TI_SLTI:
+        gen_set(ti, setl_reg8, true);
+        break;
+    case TI_SLTIU:
+        gen_set(ti, setb_reg8, true);
+        break;
+    case TI_ANDI:
+        gen_logical_immediate(ti, and_reg64_imm32);
+        break;
+    case TI_ORI:
+        gen_logical_immediate(ti, or_reg64_imm32);
+        break;
+    case TI_XORI:
+        gen_logical_immediate(ti, xor_reg64_imm32);
+        break;
+    case TI_LUI:
+        mov_reg64_simm32(x64_allocate_register_w(ti.rt), ti.imm);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief Compiles the run of instructions starting at an index of a block.
+ * \return The run's entry point, or X64_FALLBACK_ENTRY if the instruction can't start a run.
+ */
+static void *compile_run(const precomp_block *block, const size_t index)
+{
+    static std::vector<uint8_t> body;
+    static std::vector<uint8_t> code;
+
+    body.clear();
+    x64_init_assembler(&body);
+    x64_init_cache();
+
+    size_t end = index;
+    threaded_instr ti;
+    while (end < block_length(block) && end - index < MAX_RUN_LENGTH && threaded_translate(&block->block[end], ti) &&
+           gen_instruction(ti))
+    {
+        x64_next_instruction();
+        ++end;
+    }
+
+    if (end == index)
+    {
+        return X64_FALLBACK_ENTRY;
+    }
+    x64_free_all_registers();
+
+    code.clear();
+    x64_init_assembler(&code);
+    for (const auto saved : SAVED_REGISTERS)
+    {
+        if (x64_register_used(saved))
+        {
+            push_reg64(saved);
+        }
+    }
+    mov_reg64_imm64(X64_REG_BASE, (uint64_t)reg);
+    code.insert(code.end(), body.begin(), body.end());
+    mov_reg64_imm64(RAX, (uint64_t)&block->block[end]);
+    mov_reg64_imm64(RCX, (uint64_t)&PC);
+    mov_m64_reg64(RCX, 0, RAX);
+    for (const auto saved : std::views::reverse(SAVED_REGISTERS))
+    {
+        if (x64_register_used(saved))
+        {
+            pop_reg64(saved);
+        }
+    }
+    ret();
+
+    if (code_cache_used + code.size() > CODE_CACHE_SIZE)
+    {
+        flush_code_cache();
+    }
+    void *entry = code_cache + code_cache_used;
+    memcpy(entry, code.data(), code.size());
+    code_cache_used += code.size();
+    return entry;
+}
+
+/**
+ * \brief Gets the entry shadowing <c>PC</c>, or nullptr if <c>PC</c> isn't part of the current block.
+ */
+static void **lookup()
+{
+    precomp_block *block = actual;
+    if (!block || !block->block)
+    {
+        return nullptr;
+    }
+
+    const size_t length = block_length(block);
+    const auto offset = (uintptr_t)PC - (uintptr_t)block->block;
+    if (offset >= length * sizeof(precomp_instr) || offset % sizeof(precomp_instr))
+    {
+        return nullptr;
+    }
+
+    if (!block->x64_entries)
+    {
+        block->x64_entries = (void **)calloc(length, sizeof(void *));
+    }
+
+    return block->x64_entries + offset / sizeof(precomp_instr);
+}
+
+void x64_dynarec()
+{
+    if (!code_cache)
+    {
+        code_cache = (uint8_t *)malloc_exec(CODE_CACHE_SIZE);
+    }
+    if (!code_cache)
+    {
+        g_core->log_error("[Core] Failed to allocate the dynarec's code cache, falling back to the cached interpreter");
+        cached_interpreter();
+        return;
+    }
+    flush_code_cache();
+
+    while (!stop)
+    {
+        void **entry = lookup();
+        if (entry && !*entry)
+        {
+            // Compiling might flush the cache, which clears the entry again, so it has to be assigned afterwards.
+            void *compiled = compile_run(actual, entry - actual->x64_entries);
+            *entry = compiled;
+        }
+
+        if (entry && *entry != X64_FALLBACK_ENTRY)
+        {
+            ((void (*)())*entry)();
+        }
+        else
+        {
+            PC->ops();
+        }
+        g_vr_beq_ignore_jmp = false;
+    }
+}
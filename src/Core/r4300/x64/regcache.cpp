@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <r4300/x64/regcache.h>
+
+// The host registers MIPS registers are cached in. RAX and RCX are scratch registers, and X64_REG_BASE holds the
+// address of reg. The volatile registers come first, so short runs of code don't have to save any registers.
+static constexpr x64_reg cache_registers[] = {R8, R9, R10, R11, RSI, RDI, RBX, RBP, R12, R13, R14, R15};
+
+struct t_cache_entry
+{
+    /// The cached MIPS register, or -1 if the host register is free.
+    int32_t mips_reg;
+
+    /// Whether the host register holds a value which isn't written back yet.
+    bool dirty;
+
+    /// The instruction the host register was last allocated for, which makes for LRU eviction.
+    uint32_t last_use;
+};
+
+static t_cache_entry cache[std::size(cache_registers)];
+static uint16_t used_registers;
+static uint32_t instruction;
+
+void x64_init_cache()
+{
+    for (auto &entry : cache)
+    {
+        entry = {.mips_reg = -1};
+    }
+    used_registers = 0;
+    instruction = 1;
+}
+
+static int32_t mips_reg_offset(const uint8_t mips_reg)
+{
+    return mips_reg * (int32_t)sizeof(int64_t);
+}
+
+static void write_back(const size_t slot)
+{
+    if (cache[slot].mips_reg >= 0 && cache[slot].dirty)
+    {
+        mov_m64_reg64(X64_REG_BASE, mips_reg_offset((uint8_t)cache[slot].mips_reg), cache_registers[slot]);
+    }
+    cache[slot] = {.mips_reg = -1};
+}
+
+/**
+ * \brief Finds the slot caching a MIPS register, or frees the least recently used one for it.
+ * \return The slot, and whether it already held the MIPS register.
+ */
+static std::pair<size_t, bool> find_slot(const uint8_t mips_reg)
+{
+    size_t lru = 0;
+    for (size_t i = 0; i < std::size(cache); ++i)
+    {
+        if (cache[i].mips_reg == mips_reg)
+        {
+            return {i, true};
+        }
+        if (cache[i].mips_reg < 0)
+        {
+            if (cache[lru].mips_reg >= 0)
+            {
+                lru = i;
+            }
+        }
+        else if (cache[lru].mips_reg >= 0 && cache[i].last_use < cache[lru].last_use)
+        {
+            lru = i;
+        }
+    }
+
+    // An instruction allocates at most three registers, which can't run out of slots.
+    assert(cache[lru].mips_reg < 0 || cache[lru].last_use != instruction);
+    write_back(lru);
+    return {lru, false};
+}
+
+x64_reg x64_allocate_register(const uint8_t mips_reg)
+{
+    const auto [slot, cached] = find_slot(mips_reg);
+    const x64_reg host = cache_registers[slot];
+    if (!cached)
+    {
+        mov_reg64_m64(host, X64_REG_BASE, mips_reg_offset(mips_reg));
+        cache[slot] = {.mips_reg = mips_reg, .dirty = false};
+    }
+    cache[slot].last_use = instruction;
+    used_registers |= 1 << host;
+    return host;
+}
+
+x64_reg x64_allocate_register_w(const uint8_t mips_reg)
+{
+    const auto [slot, cached] = find_slot(mips_reg);
+    const x64_reg host = cache_registers[slot];
+    cache[slot] = {.mips_reg = mips_reg, .dirty = true, .last_use = instruction};
+    used_registers |= 1 << host;
+    return host;
+}
+
+void x64_free_all_registers()
+{
+    for (size_t i = 0; i < std::size(cache); ++i)
+    {
+        write_back(i);
+    }
+}
+
+bool x64_register_used(const x64_reg reg)
+{
+    return used_registers & 1 << reg;
+}
+
+void x64_next_instruction()
+{
+    ++instruction;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <r4300/x64/assemble.h>
+
+// The host register holding the address of reg while recompiled code runs.
+constexpr x64_reg X64_REG_BASE = RDX;
+
+/**
+ * \brief Empties the register cache for a new run of code.
+ */
+void x64_init_cache();
+
+/**
+ * \brief Gets a host register holding the value of a MIPS register, loading it if it isn't cached yet.
+ * \param mips_reg The index of the MIPS register in <c>reg</c>.
+ * \remarks The registers allocated for an instruction stay cached until the next instruction allocates.
+ */
+x64_reg x64_allocate_register(uint8_t mips_reg);
+
+/**
+ * \brief Gets a host register for a MIPS register which is about to be overwritten, without loading its old value.
+ * \param mips_reg The index of the MIPS register in <c>reg</c>.
+ */
+x64_reg x64_allocate_register_w(uint8_t mips_reg);
+
+/**
+ * \brief Emits the write-back of all modified MIPS registers and empties the cache.
+ */
+void x64_free_all_registers();
+
+/**
+ * \brief Gets whether a host register was handed out since the cache was emptied by x64_init_cache.
+ */
+bool x64_register_used(x64_reg reg);
+
+/**
+ * \brief Marks the end of an instruction, which allows the cache to evict the registers it allocated.
+ */
+void x64_next_instruction();
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+/*
+ * Inspects binary trace files.
+ *
+ * Only the chunks which can hold records in the requested VI and PC ranges are decompressed, so looking at a small part
+ * of a large trace is fast.
+ */
+
+static constexpr auto USAGE = R"(Usage: mupen64-trace <command> [options] <trace>
+
+Commands:
+  info                Prints the trace's header and a summary of its chunks
+  dump                Prints the trace's records as disassembly
+
+Options for dump:
+  --vi <first>[:<last>]   Only prints records executed in these VIs, counted from the start of the trace
+  --pc <first>[:<last>]   Only prints records whose address is in this range, in hexadecimal
+  --limit <n>             Stops after printing this many records
+)";
+
+/**
+ * \brief An inclusive range of values.
+ */
+struct t_range
+{
+    uint32_t first = 0;
+    uint32_t last = UINT32_MAX;
+
+    bool contains(const uint32_t value) const
+    {
+        return value >= first && value <= last;
+    }
+
+    bool overlaps(const uint32_t min, const uint32_t max) const
+    {
+        return min <= last && max >= first;
+    }
+};
+
+/**
+ * \brief Parses a range in the form first[:last].
+ * \return The range, or nullopt if the string isn't a valid range.
+ */
+static std::optional<t_range> parse_range(const std::string &str, const int base)
+{
+    t_range range{};
+
+    const auto sep = str.find(':');
+    const auto first = str.substr(0, sep);
+    const auto last = sep == std::string::npos ? first : str.substr(sep + 1);
+
+    const auto parse = [&](const std::string &part, uint32_t &value) {
+        const auto digits = base == 16 && part.starts_with("0x") ? part.substr(2) : part;
+        const auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), value, base);
+        return ec == std::errc{} && ptr == digits.data() + digits.size() && !digits.empty();
+    };
+
+    if (!parse(first, range.first) || !parse(last, range.last) || range.first > range.last)
+    {
+        return std::nullopt;
+    }
+    return range;
+}
+
+static int print_info(const core_trace_reader &reader)
+{
+    const auto &header = reader.header();
+    const auto &chunks = reader.chunks();
+
+    uint64_t records = 0;
+    uint64_t compressed = 0;
+    for (const auto &chunk : chunks)
+    {
+        records += chunk.header.record_count;
+        compressed += chunk.header.size;
+    }
+
+    printf("Version:      %u\n", header.version);
+    printf("Codec:        %s\n", header.codec == core_st_codec_zstd ? "zstd" : "store");
+    printf("Start VI:     %s\n", header.start_vi < 0 ? "none" : std::to_string(header.start_vi).c_str());
+    printf("Index:        %s\n", header.index_offset ? "present" : "missing, rebuilt from chunk headers");
+    printf("Chunks:       %zu\n", chunks.size());
+    printf("Records:      %llu\n", (unsigned long long)records);
+    printf("Compression:  %.1fx\n", compressed ? (double)(records * sizeof(core_trace_record)) / compressed : 0.0);
+    if (!chunks.empty())
+    {
+        printf("VIs:          %u-%u\n", chunks.front().header.vi, chunks.back().header.vi);
+    }
+    return 0;
+}
+
+static int dump(core_trace_reader &reader, core_ctx *ctx, const t_range &vis, const t_range &pcs, const size_t limit)
+{
+    const auto &chunks = reader.chunks();
+    std::vector<core_trace_record> records;
+    size_t printed = 0;
+
+    for (size_t i = reader.find_vi(vis.first); i < chunks.size() && chunks[i].header.vi <= vis.last; ++i)
+    {
+        const auto &header = chunks[i].header;
+        if (!pcs.overlaps(header.pc_min, header.pc_max))
+        {
+            continue;
+        }
+
+        if (const auto res = reader.read_chunk(i, records); res != Res_Ok)
+        {
+            fprintf(stderr, "Failed to read chunk %zu (error code %d)\n", i, (int32_t)res);
+            return 1;
+        }
+
+        for (const auto &record : records)
+        {
+            if (!pcs.contains(record.pc))
+            {
+                continue;
+            }
+            if (printed++ == limit)
+            {
+                return 0;
+            }
+
+            char disasm[256] = "nop";
+            if (record.opcode != 0)
+            {
+                *ctx->dbg_disassemble(disasm, record.opcode, record.pc) = '\0';
+            }
+            printf("%u %08x: %08x %-32s ; %08x %08x\n", header.vi, record.pc, record.opcode, disasm,
+                   record.operands[0], record.operands[1]);
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    argh::parser cmdl({"--vi", "--pc", "--limit"});
+    cmdl.parse(argc, argv);
+
+    if (cmdl[{"-h", "--help"}])
+    {
+        fputs(USAGE, stdout);
+        return 0;
+    }
+
+    if (cmdl.pos_args().size() != 3)
+    {
+        fputs(USAGE, stderr);
+        return 2;
+    }
+
+    const auto command = cmdl[1];
+    const std::filesystem::path path = cmdl[2];
+
+    core_trace_reader reader;
+    if (const auto res = reader.open(path); res != Res_Ok)
+    {
+        fprintf(stderr, "Failed to open %s (error code %d)\n", path.string().c_str(), (int32_t)res);
+        return 1;
+    }
+
+    if (command == "info")
+    {
+        return print_info(reader);
+    }
+
+    if (command != "dump")
+    {
+        fputs(USAGE, stderr);
+        return 2;
+    }
+
+    const auto vis = cmdl("--vi") ? parse_range(cmdl("--vi").str(), 10) : t_range{};
+    const auto pcs = cmdl("--pc") ? parse_range(cmdl("--pc").str(), 16) : t_range{};
+    size_t limit;
+    if (!vis || !pcs || !(cmdl("--limit", SIZE_MAX) >> limit))
+    {
+        fputs(USAGE, stderr);
+        return 2;
+    }
+
+    // The disassembler is only reachable through a core instance.
+    static core_cfg cfg{};
+    static core_params params{.cfg = &cfg};
+    core_ctx *ctx;
+    core_create(&params, &ctx);
+
+    return dump(reader, ctx, *vis, *pcs, limit);
+}
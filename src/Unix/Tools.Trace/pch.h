@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <CommonPCH.h>
+#include <optional>
+#include <core_api.h>
+#include <core_trace.h>
+
+#pragma warning(push, 0)
+#include <argh.h>
+#pragma warning pop
@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "Plugins.h"
+
+typedef void (*GETSOINFO)(core_plugin_info *);
+typedef int32_t (*INITIATEGFX)(core_gfx_info);
+typedef int32_t (*INITIATEAUDIO)(core_audio_info);
+typedef void (*INITIATECONTROLLERS)(core_input_info);
+typedef void (*INITIATERSP)(core_rsp_info, uint32_t *);
+
+struct t_plugin
+{
+    void *handle;
+    std::string name;
+};
+
+static t_plugin video_plugin{};
+static t_plugin audio_plugin{};
+static t_plugin input_plugin{};
+static t_plugin rsp_plugin{};
+
+static core_params *core{};
+
+static INITIATEGFX initiate_gfx{};
+static INITIATEAUDIO initiate_audio{};
+static INITIATECONTROLLERS initiate_controllers{};
+static INITIATERSP initiate_rsp{};
+static ROMOPEN video_rom_open{};
+static ROMOPEN audio_rom_open{};
+static ROMOPEN input_rom_open{};
+
+static core_gfx_info gfx_info{};
+static core_audio_info audio_info{};
+static core_input_info control_info{};
+static core_rsp_info rsp_info{};
+static uint32_t dummy_dw{};
+
+#pragma region Dummy Functions
+
+static uint32_t dummy_do_rsp_cycles(uint32_t cycles)
+{
+    return cycles;
+}
+
+static void dummy_void()
+{
+}
+
+static int32_t dummy_initiate_gfx(core_gfx_info)
+{
+    return 1;
+}
+
+static int32_t dummy_initiate_audio(core_audio_info)
+{
+    return 1;
+}
+
+static void dummy_initiate_controllers(core_input_info)
+{
+}
+
+static void dummy_initiate_rsp(core_rsp_info, uint32_t *)
+{
+}
+
+static void dummy_ai_dacrate_changed(int32_t)
+{
+}
+
+static uint32_t dummy_ai_read_length()
+{
+    return 0;
+}
+
+static void dummy_ai_update(int32_t)
+{
+}
+
+static void dummy_controller_command(int32_t, uint8_t *)
+{
+}
+
+static void dummy_get_keys(int32_t, core_buttons *keys)
+{
+    keys->value = 0;
+}
+
+static void dummy_set_keys(int32_t, core_buttons)
+{
+}
+
+static void dummy_read_controller(int32_t, uint8_t *)
+{
+}
+
+static void dummy_fb_read(uint32_t)
+{
+}
+
+static void dummy_fb_write(uint32_t, uint32_t)
+{
+}
+
+static void dummy_fb_get_framebuffer_info(void *)
+{
+}
+
+#pragma endregion
+
+#define FUNC(target, type, fallback, name)                                                                             \
+    target = (type)dlsym(handle, name);                                                                                \
+    if (!target) target = fallback
+
+/**
+ * \brief Opens a plugin and checks that it's of the expected type.
+ * \return An error message, or an empty string if the plugin was opened.
+ */
+static std::string open_plugin(const std::filesystem::path &path, const core_plugin_type type, t_plugin &plugin)
+{
+    if (plugin.handle)
+    {
+        dlclose(plugin.handle);
+        plugin = {};
+    }
+
+    const auto handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle)
+    {
+        return std::format("{}: {}", path.string(), dlerror());
+    }
+
+    const auto get_so_info = (GETSOINFO)dlsym(handle, "GetSoInfo");
+    if (!get_so_info)
+    {
+        dlclose(handle);
+        return std::format("{}: GetSoInfo missing", path.string());
+    }
+
+    core_plugin_info info{};
+    get_so_info(&info);
+
+    if (info.type != type)
+    {
+        dlclose(handle);
+        return std::format("{}: unexpected plugin type {}", path.string(), info.type);
+    }
+
+    plugin.handle = handle;
+    plugin.name = std::string(info.name, strnlen(info.name, sizeof(info.name)));
+    while (!plugin.name.empty() && plugin.name.back() == ' ')
+    {
+        plugin.name.pop_back();
+    }
+    return "";
+}
+
+Plugins::t_paths Plugins::dummy_paths()
+{
+    const auto dir = IOUtils::exe_path_cached().parent_path() / "plugin";
+    return {
+        .video = dir / "libno-video.so",
+        .audio = dir / "libno-audio.so",
+        .input = dir / "libno-input.so",
+        .rsp = dir / "libno-rsp.so",
+    };
+}
+
+std::string Plugins::load(const t_paths &paths, core_params &params)
+{
+    core = &params;
+
+    for (const auto &[path, type, plugin] : {
+             std::tuple{paths.video, plugin_video, &video_plugin},
+             std::tuple{paths.audio, plugin_audio, &audio_plugin},
+             std::tuple{paths.input, plugin_input, &input_plugin},
+             std::tuple{paths.rsp, plugin_rsp, &rsp_plugin},
+         })
+    {
+        if (auto error = open_plugin(path, type, *plugin); !error.empty())
+        {
+            return error;
+        }
+    }
+
+    auto handle = video_plugin.handle;
+    FUNC(initiate_gfx, INITIATEGFX, dummy_initiate_gfx, "InitiateGFX");
+    FUNC(video_rom_open, ROMOPEN, dummy_void, "RomOpen");
+    FUNC(params.video_process_dlist, PROCESSDLIST, dummy_void, "ProcessDList");
+    FUNC(params.video_process_rdp_list, PROCESSRDPLIST, dummy_void, "ProcessRDPList");
+    FUNC(params.video_show_cfb, SHOWCFB, dummy_void, "ShowCFB");
+    FUNC(params.video_vi_status_changed, VISTATUSCHANGED, dummy_void, "ViStatusChanged");
+    FUNC(params.video_vi_width_changed, VIWIDTHCHANGED, dummy_void, "ViWidthChanged");
+    FUNC(params.video_get_video_size, GETVIDEOSIZE, nullptr, "mge_get_video_size");
+    FUNC(params.video_fb_read, FBREAD, dummy_fb_read, "FBRead");
+    FUNC(params.video_fb_write, FBWRITE, dummy_fb_write, "FBWrite");
+    FUNC(params.video_fb_get_frame_buffer_info, FBGETFRAMEBUFFERINFO, dummy_fb_get_framebuffer_info,
+         "FBGetFrameBufferInfo");
+
+    handle = audio_plugin.handle;
+    FUNC(initiate_audio, INITIATEAUDIO, dummy_initiate_audio, "InitiateAudio");
+    FUNC(audio_rom_open, ROMOPEN, dummy_void, "RomOpen");
+    FUNC(params.audio_ai_dacrate_changed, AIDACRATECHANGED, dummy_ai_dacrate_changed, "AiDacrateChanged");
+    FUNC(params.audio_ai_len_changed, AILENCHANGED, dummy_void, "AiLenChanged");
+    FUNC(params.audio_ai_read_length, AIREADLENGTH, dummy_ai_read_length, "AiReadLength");
+    FUNC(params.audio_process_alist, PROCESSALIST, dummy_void, "ProcessAList");
+    FUNC(params.audio_ai_update, AIUPDATE, dummy_ai_update, "AiUpdate");
+
+    handle = input_plugin.handle;
+    FUNC(initiate_controllers, INITIATECONTROLLERS, dummy_initiate_controllers, "InitiateControllers");
+    FUNC(input_rom_open, ROMOPEN, dummy_void, "RomOpen");
+    FUNC(params.input_controller_command, CONTROLLERCOMMAND, dummy_controller_command, "ControllerCommand");
+    FUNC(params.input_get_keys, GETKEYS, dummy_get_keys, "GetKeys");
+    FUNC(params.input_set_keys, SETKEYS, dummy_set_keys, "SetKeys");
+    FUNC(params.input_read_controller, READCONTROLLER, dummy_read_controller, "ReadController");
+
+    handle = rsp_plugin.handle;
+    FUNC(initiate_rsp, INITIATERSP, dummy_initiate_rsp, "InitiateRSP");
+    FUNC(params.rsp_do_rsp_cycles, DORSPCYCLES, dummy_do_rsp_cycles, "DoRspCycles");
+
+    return "";
+}
+
+void Plugins::initiate(core_ctx *ctx)
+{
+    gfx_info.byteswapped = 1;
+    gfx_info.rom = ctx->rom;
+    gfx_info.rdram = (uint8_t *)ctx->rdram;
+    gfx_info.dmem = (uint8_t *)ctx->SP_DMEM;
+    gfx_info.imem = (uint8_t *)ctx->SP_IMEM;
+    gfx_info.mi_intr_reg = &ctx->MI_register->mi_intr_reg;
+    gfx_info.dpc_start_reg = &ctx->dpc_register->dpc_start;
+    gfx_info.dpc_end_reg = &ctx->dpc_register->dpc_end;
+    gfx_info.dpc_current_reg = &ctx->dpc_register->dpc_current;
+    gfx_info.dpc_status_reg = &ctx->dpc_register->dpc_status;
+    gfx_info.dpc_clock_reg = &ctx->dpc_register->dpc_clock;
+    gfx_info.dpc_bufbusy_reg = &ctx->dpc_register->dpc_bufbusy;
+    gfx_info.dpc_pipebusy_reg = &ctx->dpc_register->dpc_pipebusy;
+    gfx_info.dpc_tmem_reg = &ctx->dpc_register->dpc_tmem;
+    gfx_info.vi_status_reg = &ctx->vi_register->vi_status;
+    gfx_info.vi_origin_reg = &ctx->vi_register->vi_origin;
+    gfx_info.vi_width_reg = &ctx->vi_register->vi_width;
+    gfx_info.vi_intr_reg = &ctx->vi_register->vi_v_intr;
+    gfx_info.vi_v_current_line_reg = &ctx->vi_register->vi_current;
+    gfx_info.vi_timing_reg = &ctx->vi_register->vi_burst;
+    gfx_info.vi_v_sync_reg = &ctx->vi_register->vi_v_sync;
+    gfx_info.vi_h_sync_reg = &ctx->vi_register->vi_h_sync;
+    gfx_info.vi_leap_reg = &ctx->vi_register->vi_leap;
+    gfx_info.vi_h_start_reg = &ctx->vi_register->vi_h_start;
+    gfx_info.vi_v_start_reg = &ctx->vi_register->vi_v_start;
+    gfx_info.vi_v_burst_reg = &ctx->vi_register->vi_v_burst;
+    gfx_info.vi_x_scale_reg = &ctx->vi_register->vi_x_scale;
+    gfx_info.vi_y_scale_reg = &ctx->vi_register->vi_y_scale;
+    gfx_info.check_interrupts = dummy_void;
+
+    audio_info.byteswapped = 1;
+    audio_info.rom = ctx->rom;
+    audio_info.rdram = (uint8_t *)ctx->rdram;
+    audio_info.dmem = (uint8_t *)ctx->SP_DMEM;
+    audio_info.imem = (uint8_t *)ctx->SP_IMEM;
+    audio_info.mi_intr_reg = &dummy_dw;
+    audio_info.ai_dram_addr_reg = &ctx->ai_register->ai_dram_addr;
+    audio_info.ai_len_reg = &ctx->ai_register->ai_len;
+    audio_info.ai_control_reg = &ctx->ai_register->ai_control;
+    audio_info.ai_status_reg = &dummy_dw;
+    audio_info.ai_dacrate_reg = &ctx->ai_register->ai_dacrate;
+    audio_info.ai_bitrate_reg = &ctx->ai_register->ai_bitrate;
+    audio_info.check_interrupts = dummy_void;
+
+    // The controllers are set up by the host to match the movie, so they're handed to the plugin as they are.
+    control_info.byteswapped = 1;
+    control_info.header = ctx->rom;
+    control_info.controllers = core->controls;
+
+    rsp_info.byteswapped = 1;
+    rsp_info.rdram = (uint8_t *)ctx->rdram;
+    rsp_info.dmem = (uint8_t *)ctx->SP_DMEM;
+    rsp_info.imem = (uint8_t *)ctx->SP_IMEM;
+    rsp_info.mi_intr_reg = &ctx->MI_register->mi_intr_reg;
+    rsp_info.sp_mem_addr_reg = &ctx->sp_register->sp_mem_addr_reg;
+    rsp_info.sp_dram_addr_reg = &ctx->sp_register->sp_dram_addr_reg;
+    rsp_info.sp_rd_len_reg = &ctx->sp_register->sp_rd_len_reg;
+    rsp_info.sp_wr_len_reg = &ctx->sp_register->sp_wr_len_reg;
+    rsp_info.sp_status_reg = &ctx->sp_register->sp_status_reg;
+    rsp_info.sp_dma_full_reg = &ctx->sp_register->sp_dma_full_reg;
+    rsp_info.sp_dma_busy_reg = &ctx->sp_register->sp_dma_busy_reg;
+    rsp_info.sp_pc_reg = &ctx->rsp_register->rsp_pc;
+    rsp_info.sp_semaphore_reg = &ctx->sp_register->sp_semaphore_reg;
+    rsp_info.dpc_start_reg = &ctx->dpc_register->dpc_start;
+    rsp_info.dpc_end_reg = &ctx->dpc_register->dpc_end;
+    rsp_info.dpc_current_reg = &ctx->dpc_register->dpc_current;
+    rsp_info.dpc_status_reg = &ctx->dpc_register->dpc_status;
+    rsp_info.dpc_clock_reg = &ctx->dpc_register->dpc_clock;
+    rsp_info.dpc_bufbusy_reg = &ctx->dpc_register->dpc_bufbusy;
+    rsp_info.dpc_pipebusy_reg = &ctx->dpc_register->dpc_pipebusy;
+    rsp_info.dpc_tmem_reg = &ctx->dpc_register->dpc_tmem;
+    rsp_info.check_interrupts = dummy_void;
+    rsp_info.process_dlist_list = core->video_process_dlist;
+    rsp_info.process_alist_list = core->audio_process_alist;
+    rsp_info.process_rdp_list = core->video_process_rdp_list;
+    rsp_info.show_cfb = core->video_show_cfb;
+
+    initiate_gfx(gfx_info);
+    initiate_audio(audio_info);
+    initiate_controllers(control_info);
+    uint32_t cycle_count = 4;
+    initiate_rsp(rsp_info, &cycle_count);
+
+    video_rom_open();
+    audio_rom_open();
+    input_rom_open();
+}
+
+void Plugins::get_names(char *video, char *audio, char *input, char *rsp)
+{
+    const auto copy = [](const t_plugin &plugin, char *dest) {
+        if (!dest) return;
+        const auto len = std::min(plugin.name.size(), (size_t)63);
+        memcpy(dest, plugin.name.data(), len);
+        dest[len] = '\0';
+    };
+
+    copy(video_plugin, video);
+    copy(audio_plugin, audio);
+    copy(input_plugin, input);
+    copy(rsp_plugin, rsp);
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+namespace Plugins
+{
+/**
+ * \brief The paths of the plugins to load.
+ */
+struct t_paths
+{
+    std::filesystem::path video;
+    std::filesystem::path audio;
+    std::filesystem::path input;
+    std::filesystem::path rsp;
+};
+
+/**
+ * \brief Gets the paths of the bundled dummy plugins, which live in the plugin directory next to the executable.
+ */
+t_paths dummy_paths();
+
+/**
+ * \brief Loads the plugins and points the core's plugin functions at them.
+ * Functions which a plugin doesn't export are replaced with dummies, so the dummy plugins (which export none) run the
+ * game without video, audio, input or RSP emulation.
+ * \param paths The plugin paths.
+ * \param params The core parameters whose plugin functions are filled in.
+ * \return An error message, or an empty string if all plugins were loaded.
+ */
+std::string load(const t_paths &paths, core_params &params);
+
+/**
+ * \brief Initiates the loaded plugins and notifies them of the opened rom.
+ * \param ctx The core context whose memory and registers are handed to the plugins.
+ */
+void initiate(core_ctx *ctx);
+
+/**
+ * \brief Gets the names of the loaded plugins. See <c>core_params::get_plugin_names</c>.
+ */
+void get_names(char *video, char *audio, char *input, char *rsp);
+} // namespace Plugins
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "Results.h"
+
+void Runner::to_json(nlohmann::json &j, const t_result &result)
+{
+    j["movie"] = result.movie.string();
+    j["status"] = result.status;
+    j["message"] = result.message;
+    j["length_samples"] = result.length_samples;
+    j["samples_played"] = result.samples_played;
+    j["seconds"] = result.seconds;
+
+    // The hashes are written as hex strings, as not all JSON consumers can represent 64-bit integers exactly.
+    auto hashes = nlohmann::json::array();
+    for (const auto &[sample, hash] : result.hashes)
+    {
+        hashes.push_back({{"sample", sample}, {"hash", std::format("{:016x}", hash)}});
+    }
+    j["hashes"] = hashes;
+
+    j["first_mismatch"] = result.first_mismatch ? nlohmann::json(*result.first_mismatch) : nlohmann::json(nullptr);
+}
+
+void Runner::from_json(const nlohmann::json &j, t_result &result)
+{
+    result.movie = j.at("movie").get<std::string>();
+    result.status = j.at("status").get<t_status>();
+    result.message = j.value("message", "");
+    result.length_samples = j.value("length_samples", (size_t)0);
+    result.samples_played = j.value("samples_played", (size_t)0);
+    result.seconds = j.value("seconds", 0.0);
+
+    result.hashes.clear();
+    for (const auto &entry : j.value("hashes", nlohmann::json::array()))
+    {
+        const auto hash = entry.at("hash").get<std::string>();
+        result.hashes.push_back({.sample = entry.at("sample").get<size_t>(), .hash = std::stoull(hash, nullptr, 16)});
+    }
+
+    result.first_mismatch.reset();
+    if (j.contains("first_mismatch") && !j["first_mismatch"].is_null())
+    {
+        result.first_mismatch = j["first_mismatch"].get<size_t>();
+    }
+}
+
+Runner::t_status Runner::get_status(const bool stopped, const size_t samples_played, const size_t length_samples)
+{
+    if (!stopped)
+    {
+        return t_status::timeout;
+    }
+    return samples_played >= length_samples ? t_status::ok : t_status::incomplete;
+}
+
+std::optional<size_t> Runner::find_first_mismatch(const std::vector<t_hash> &actual,
+                                                 const std::vector<t_hash> &expected)
+{
+    size_t i = 0;
+    for (; i < actual.size() && i < expected.size(); ++i)
+    {
+        if (actual[i].sample != expected[i].sample)
+        {
+            return std::min(actual[i].sample, expected[i].sample);
+        }
+        if (actual[i].hash != expected[i].hash)
+        {
+            return actual[i].sample;
+        }
+    }
+    if (i < actual.size())
+    {
+        return actual[i].sample;
+    }
+    if (i < expected.size())
+    {
+        return expected[i].sample;
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+namespace Runner
+{
+/**
+ * \brief The outcome of a movie's verification run.
+ */
+enum class t_status
+{
+    // The movie played back to its end.
+    ok,
+    // The movie couldn't be played back, e.g. because no matching rom was found.
+    error,
+    // Playback stopped before the movie's end, e.g. because of an error during playback.
+    incomplete,
+    // The movie didn't reach its end within the time limit.
+    timeout,
+    // The process verifying the movie exited without producing a result.
+    crashed,
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(t_status, {
+                                           {t_status::ok, "ok"},
+                                           {t_status::error, "error"},
+                                           {t_status::incomplete, "incomplete"},
+                                           {t_status::timeout, "timeout"},
+                                           {t_status::crashed, "crashed"},
+                                       })
+
+/**
+ * \brief An emulator state hash taken during playback.
+ */
+struct t_hash
+{
+    /// The sample the hash was taken at.
+    size_t sample;
+
+    /// The hash of the emulator state.
+    uint64_t hash;
+};
+
+/**
+ * \brief The result of a verification run.
+ */
+struct t_result
+{
+    std::filesystem::path movie;
+    t_status status = t_status::error;
+
+    /// A description of what went wrong. Empty if the run succeeded.
+    std::string message;
+
+    /// The movie's length in samples.
+    size_t length_samples{};
+
+    /// The amount of samples which were played back.
+    size_t samples_played{};
+
+    /// The wall-clock time the run took.
+    double seconds{};
+
+    /// The state hashes, ordered by sample.
+    std::vector<t_hash> hashes;
+
+    /// The first sample whose hash differs from the baseline, if a baseline was compared against.
+    std::optional<size_t> first_mismatch;
+};
+
+void to_json(nlohmann::json &j, const t_result &result);
+void from_json(const nlohmann::json &j, t_result &result);
+
+/**
+ * \brief Determines the status of a run whose playback started.
+ * \param stopped Whether playback stopped within the time limit.
+ * \param samples_played The amount of samples which were played back.
+ * \param length_samples The movie's length in samples.
+ * \return The run's status, which is only ok if playback stopped at the movie's end.
+ */
+t_status get_status(bool stopped, size_t samples_played, size_t length_samples);
+
+/**
+ * \brief Finds the first sample at which two hash sequences differ, including samples only one of them reached.
+ * \param actual The hashes of the verified run.
+ * \param expected The baseline's hashes.
+ * \return The sample, or nullopt if the sequences are identical.
+ */
+std::optional<size_t> find_first_mismatch(const std::vector<t_hash> &actual, const std::vector<t_hash> &expected);
+
+} // namespace Runner
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "Runner.h"
+
+struct t_run_state
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+
+    // Whether playback has started, which tells the end of playback apart from the idle state before it.
+    bool started{};
+    bool done{};
+
+    size_t samples_played{};
+    std::vector<Runner::t_hash> hashes;
+
+    // The last error reported by the core through a dialog.
+    std::string last_error;
+};
+
+static core_cfg cfg{};
+static core_params params{};
+static core_ctx *ctx{};
+
+static Runner::t_options options{};
+static t_run_state state{};
+static std::filesystem::path saves_dir{};
+
+static void log(const std::string_view level, const std::string_view str)
+{
+    if (!options.verbose)
+    {
+        return;
+    }
+    fprintf(stderr, "[%.*s] %.*s\n", (int)level.size(), level.data(), (int)str.size(), str.data());
+}
+
+static std::filesystem::path find_available_rom(const std::function<bool(const core_rom_header &)> &predicate)
+{
+    for (const auto &dir : options.rom_dirs)
+    {
+        std::error_code ec;
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(dir, ec))
+        {
+            if (!entry.is_regular_file() || entry.file_size() <= sizeof(core_rom_header))
+            {
+                continue;
+            }
+
+            core_rom_header header{};
+            std::ifstream file(entry.path(), std::ios::binary);
+            if (!file.read((char *)&header, sizeof(header)))
+            {
+                continue;
+            }
+
+            ctx->vr_byteswap((uint8_t *)&header);
+
+            if (predicate(header))
+            {
+                return entry.path();
+            }
+        }
+    }
+    return {};
+}
+
+static void init_params()
+{
+    // Emulate as fast as possible without rendering, and never stop for anything but the end of the movie.
+    cfg.vcr_readonly = true;
+    cfg.is_movie_loop_enabled = false;
+    cfg.pause_at_last_frame = false;
+    cfg.wait_at_movie_end = false;
+    cfg.frame_skip_frequency = 0;
+    cfg.fastforward_silent = true;
+    cfg.max_lag = 0;
+    cfg.vcr_backups = false;
+    cfg.st_screenshot = false;
+
+    params.cfg = &cfg;
+    params.log_trace = [](std::string_view str) { log("trace", str); };
+    params.log_info = [](std::string_view str) { log("info", str); };
+    params.log_warn = [](std::string_view str) { log("warn", str); };
+    params.log_error = [](std::string_view str) { log("error", str); };
+    params.load_plugins = [] {
+        const auto error = Plugins::load(options.plugins, params);
+        if (!error.empty())
+        {
+            std::scoped_lock lock(state.mtx);
+            state.last_error = error;
+        }
+        return error.empty();
+    };
+    params.initiate_plugins = [] { Plugins::initiate(ctx); };
+    params.submit_task = [](const std::function<void()> &func) { std::thread(func).detach(); };
+    params.get_saves_directory = [] { return saves_dir; };
+    params.get_backups_directory = [] { return saves_dir; };
+    params.get_summercart_directory = [] { return saves_dir; };
+    params.get_summercart_path = [] { return saves_dir / "card.vhd"; };
+
+    // Nobody is around to answer questions, so anything which needs confirmation is declined and reported.
+    params.show_multiple_choice_dialog = [](std::string_view, const std::vector<std::string> &, const char *str,
+                                            const char *, core_dialog_type) -> size_t {
+        log("dialog", str);
+        return 0;
+    };
+    params.show_ask_dialog = [](std::string_view, const char *str, const char *, bool) {
+        log("dialog", str);
+        std::scoped_lock lock(state.mtx);
+        state.last_error = str;
+        return false;
+    };
+    params.show_dialog = [](const char *str, const char *, core_dialog_type type) {
+        log("dialog", str);
+        if (type == fsvc_error)
+        {
+            std::scoped_lock lock(state.mtx);
+            state.last_error = str;
+        }
+    };
+    params.show_statusbar = [](const char *) {};
+    params.update_screen = [] {};
+    params.copy_video = [](void *) {};
+    params.find_available_rom = find_available_rom;
+    params.mge_available = [] { return false; };
+    params.load_screen = [](void *) {};
+    params.get_plugin_names = Plugins::get_names;
+
+    // Called on the emu thread while it waits for the sample's input, so the state is consistent.
+    params.callbacks.current_sample_changed = [](const int32_t sample) {
+        std::scoped_lock lock(state.mtx);
+        state.samples_played = sample;
+        if (sample % options.interval == 0)
+        {
+            state.hashes.push_back({.sample = (size_t)sample, .hash = ctx->st_hash(core_st_hash_all)});
+        }
+    };
+    params.callbacks.task_changed = [](const core_vcr_task task) {
+        std::scoped_lock lock(state.mtx);
+        if (task != task_idle)
+        {
+            state.started = true;
+            return;
+        }
+        if (state.started)
+        {
+            state.done = true;
+            state.cv.notify_all();
+        }
+    };
+}
+
+Runner::t_result Runner::run(const t_options &run_options)
+{
+    options = run_options;
+
+    t_result result{.movie = options.movie};
+    const auto start_time = std::chrono::steady_clock::now();
+
+    saves_dir = std::filesystem::temp_directory_path() / std::format("mupen64-verify-{}", getpid());
+    std::filesystem::create_directories(saves_dir);
+
+    init_params();
+    core_create(&params, &ctx);
+    ctx->vr_set_fast_forward(true);
+
+    core_vcr_movie_header header{};
+    if (const auto res = ctx->vcr_parse_header(options.movie, &header); res != Res_Ok)
+    {
+        result.message = std::format("Failed to read the movie header (error code {})", (int32_t)res);
+        std::filesystem::remove_all(saves_dir);
+        return result;
+    }
+    result.length_samples = header.length_samples;
+
+    // The dummy input plugin doesn't provide controllers, so the movie's controller setup is plugged in.
+    for (int32_t i = 0; i < 4; ++i)
+    {
+        params.controls[i].Present = (header.controller_flags & CONTROLLER_X_PRESENT(i)) != 0;
+        params.controls[i].RawData = 0;
+        params.controls[i].Plugin = header.controller_flags & CONTROLLER_X_MEMPAK(i)   ? ce_mempak
+                                    : header.controller_flags & CONTROLLER_X_RUMBLE(i) ? ce_rumblepak
+                                                                                       : ce_none;
+    }
+
+    if (const auto res = ctx->vcr_start_playback(options.movie); res != Res_Ok)
+    {
+        std::scoped_lock lock(state.mtx);
+        result.message = std::format("Failed to start playback (error code {})", (int32_t)res);
+        if (!state.last_error.empty())
+        {
+            result.message += ": " + state.last_error;
+        }
+    }
+    else
+    {
+        std::unique_lock lock(state.mtx);
+        const bool done = state.cv.wait_for(lock, options.timeout, [] { return state.done; });
+
+        result.status = get_status(done, state.samples_played, header.length_samples);
+        switch (result.status)
+        {
+        case t_status::timeout:
+            result.message = std::format("Timed out at sample {}", state.samples_played);
+            break;
+        case t_status::incomplete:
+            result.message = std::format("Playback stopped at sample {}", state.samples_played);
+            if (!state.last_error.empty())
+            {
+                result.message += ": " + state.last_error;
+            }
+            break;
+        default:
+            result.message = state.last_error;
+            break;
+        }
+        result.samples_played = state.samples_played;
+        result.hashes = state.hashes;
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    // A timed out emu thread might never reach a point where it can be stopped, so we don't wait for it.
+    if (result.status != t_status::timeout)
+    {
+        ctx->vr_close_rom(true);
+    }
+
+    std::filesystem::remove_all(saves_dir);
+    return result;
+}
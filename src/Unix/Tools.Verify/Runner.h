@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include "Plugins.h"
+#include "Results.h"
+
+namespace Runner
+{
+/**
+ * \brief The parameters of a verification run.
+ */
+struct t_options
+{
+    /// The movie to play back.
+    std::filesystem::path movie;
+
+    /// The directories searched for the rom matching the movie.
+    std::vector<std::filesystem::path> rom_dirs;
+
+    /// The plugins to run the movie with.
+    Plugins::t_paths plugins;
+
+    /// The amount of samples between emulator state hashes.
+    size_t interval = 60;
+
+    /// The time after which the run is abandoned.
+    std::chrono::seconds timeout{600};
+
+    /// Whether core log output is written to stderr.
+    bool verbose{};
+};
+
+/**
+ * \brief Plays back a movie in the current process and hashes the emulator state along the way.
+ * \param options The run parameters.
+ * \return The run's result.
+ * \remarks The core is process-global, so this can only be called once per process.
+ */
+t_result run(const t_options &options);
+} // namespace Runner
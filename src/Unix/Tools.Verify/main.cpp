@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+/*
+ * Plays back movies headlessly and reports hashes of the emulator state along the way.
+ *
+ * The core is process-global, so every movie is played back in its own child process (this executable, started with
+ * --worker). Up to --jobs children run at a time, each printing its result as JSON on stdout.
+ */
+
+#include "Runner.h"
+
+extern char **environ;
+
+static constexpr auto USAGE = R"(Usage: mupen64-verify [options] <movie.m64>...
+
+Plays back movies without video, audio or input and reports hashes of the emulator state as JSON.
+
+Options:
+  --roms <dirs>       Semicolon-separated directories searched for the movies' roms (default: .)
+  --interval <n>      Samples between state hashes (default: 60)
+  --jobs <n>          Movies played back in parallel (default: hardware thread count)
+  --timeout <s>       Seconds after which a movie is abandoned (default: 600)
+  --baseline <file>   Report to compare the hashes against
+  --output <file>     File the report is written to (default: stdout)
+  --video <file>      Video plugin (default: bundled dummy plugin, likewise for the others)
+  --audio <file>      Audio plugin
+  --input <file>      Input plugin
+  --rsp <file>        RSP plugin
+  --verbose           Write core log output to stderr
+
+Exit status: 0 if all movies played back to their end and match the baseline, 1 otherwise, 2 on usage errors.
+)";
+
+/**
+ * \brief Parses a numeric option.
+ * \return The value, or nullopt if the option has an invalid value.
+ */
+static std::optional<size_t> parse_number(const argh::parser &cmdl, const char *name, const size_t def)
+{
+    size_t value;
+    if (!(cmdl(name, def) >> value))
+    {
+        fprintf(stderr, "Invalid value for %s\n", name);
+        return std::nullopt;
+    }
+    return value;
+}
+
+/**
+ * \brief Builds the arguments which make a worker process verify the specified movie with the same options.
+ */
+static std::vector<std::string> worker_args(const Runner::t_options &options, const std::filesystem::path &movie)
+{
+    std::string roms;
+    for (const auto &dir : options.rom_dirs)
+    {
+        roms += (roms.empty() ? "" : ";") + dir.string();
+    }
+
+    std::vector<std::string> args = {
+        IOUtils::exe_path_cached().string(),
+        "--worker",
+        "--roms",
+        roms,
+        "--interval",
+        std::to_string(options.interval),
+        "--timeout",
+        std::to_string(options.timeout.count()),
+        "--video",
+        options.plugins.video.string(),
+        "--audio",
+        options.plugins.audio.string(),
+        "--input",
+        options.plugins.input.string(),
+        "--rsp",
+        options.plugins.rsp.string(),
+    };
+    if (options.verbose)
+    {
+        args.emplace_back("--verbose");
+    }
+    args.push_back(movie.string());
+    return args;
+}
+
+/**
+ * \brief Verifies a movie in a worker process.
+ * \return The worker's result, or a crashed result if the worker didn't produce one.
+ */
+static Runner::t_result run_in_worker(const Runner::t_options &options, const std::filesystem::path &movie)
+{
+    Runner::t_result result{.movie = movie, .status = Runner::t_status::crashed};
+
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) != 0)
+    {
+        result.message = std::format("pipe2 failed: {}", strerror(errno));
+        return result;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+
+    const auto args = worker_args(options, movie);
+    std::vector<char *> argv;
+    for (const auto &arg : args)
+    {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid;
+    const int err = posix_spawn(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+
+    if (err != 0)
+    {
+        close(fds[0]);
+        result.message = std::format("posix_spawn failed: {}", strerror(err));
+        return result;
+    }
+
+    std::string output;
+    char buf[4096];
+    ssize_t len;
+    while ((len = read(fds[0], buf, sizeof(buf))) > 0 || (len < 0 && errno == EINTR))
+    {
+        output.append(buf, std::max(len, (ssize_t)0));
+    }
+    close(fds[0]);
+
+    int status;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR);
+
+    if (WIFSIGNALED(status))
+    {
+        result.message = std::format("Worker killed by signal {}", WTERMSIG(status));
+        return result;
+    }
+
+    try
+    {
+        result = nlohmann::json::parse(output).get<Runner::t_result>();
+    }
+    catch (const nlohmann::json::exception &e)
+    {
+        result.message =
+            std::format("Worker exited with status {} without a result: {}", WEXITSTATUS(status), e.what());
+    }
+    return result;
+}
+
+static int run_worker(const Runner::t_options &options)
+{
+    const auto result = Runner::run(options);
+    const auto json = nlohmann::json(result).dump();
+    fwrite(json.data(), 1, json.size(), stdout);
+    fflush(stdout);
+
+    // The emulator's threads aren't meant to be torn down by static destructors, so we leave without running them.
+    _exit(0);
+}
+
+int main(int argc, char *argv[])
+{
+    argh::parser cmdl({"--roms", "--interval", "--jobs", "--timeout", "--baseline", "--output", "--video", "--audio",
+                       "--input", "--rsp"});
+    cmdl.parse(argc, argv);
+
+    std::vector<std::filesystem::path> movies(cmdl.pos_args().begin() + 1, cmdl.pos_args().end());
+
+    if (cmdl[{"-h", "--help"}])
+    {
+        fputs(USAGE, stdout);
+        return 0;
+    }
+
+    if (movies.empty())
+    {
+        fputs(USAGE, stderr);
+        return 2;
+    }
+
+    Runner::t_options options{};
+
+    std::stringstream roms(cmdl("--roms", ".").str());
+    std::string dir;
+    while (std::getline(roms, dir, ';'))
+    {
+        options.rom_dirs.emplace_back(dir);
+    }
+
+    const auto dummies = Plugins::dummy_paths();
+    options.plugins = {
+        .video = cmdl("--video", dummies.video.string()).str(),
+        .audio = cmdl("--audio", dummies.audio.string()).str(),
+        .input = cmdl("--input", dummies.input.string()).str(),
+        .rsp = cmdl("--rsp", dummies.rsp.string()).str(),
+    };
+    options.verbose = cmdl["--verbose"];
+
+    const auto interval = parse_number(cmdl, "--interval", 60);
+    const auto timeout = parse_number(cmdl, "--timeout", 600);
+    const auto jobs = parse_number(cmdl, "--jobs", std::max(std::thread::hardware_concurrency(), 1u));
+    if (!interval || !timeout || !jobs || *interval == 0 || *jobs == 0)
+    {
+        fputs(USAGE, stderr);
+        return 2;
+    }
+    options.interval = *interval;
+    options.timeout = std::chrono::seconds(*timeout);
+
+    if (cmdl["--worker"])
+    {
+        options.movie = movies[0];
+        return run_worker(options);
+    }
+
+    std::map<std::string, Runner::t_result> baseline;
+    if (const auto baseline_path = cmdl("--baseline").str(); !baseline_path.empty())
+    {
+        try
+        {
+            std::ifstream file(baseline_path);
+            for (auto &result : nlohmann::json::parse(file).at("movies").get<std::vector<Runner::t_result>>())
+            {
+                baseline[result.movie.string()] = std::move(result);
+            }
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            fprintf(stderr, "Failed to read baseline %s: %s\n", baseline_path.c_str(), e.what());
+            return 2;
+        }
+    }
+
+    std::vector<Runner::t_result> results(movies.size());
+    std::atomic<size_t> next_movie{};
+    std::atomic<size_t> finished{};
+    std::mutex progress_mtx;
+
+    // Each thread drives one worker process at a time, so the processes do the actual work in parallel.
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < std::min(*jobs, movies.size()); ++i)
+    {
+        threads.emplace_back([&] {
+            for (size_t index; (index = next_movie++) < movies.size();)
+            {
+                auto &result = results[index];
+                result = run_in_worker(options, movies[index]);
+
+                if (const auto it = baseline.find(result.movie.string()); it != baseline.end())
+                {
+                    result.first_mismatch = Runner::find_first_mismatch(result.hashes, it->second.hashes);
+                }
+
+                std::scoped_lock lock(progress_mtx);
+                fprintf(stderr, "[%zu/%zu] %s: %s (%.1fs)%s\n", ++finished, movies.size(), result.movie.c_str(),
+                        nlohmann::json(result.status).get<std::string>().c_str(), result.seconds,
+                        result.first_mismatch ? std::format(", mismatch at sample {}", *result.first_mismatch).c_str()
+                                              : "");
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    size_t failed = 0;
+    size_t mismatched = 0;
+    for (const auto &result : results)
+    {
+        failed += result.status != Runner::t_status::ok;
+        mismatched += result.first_mismatch.has_value();
+    }
+
+    nlohmann::json report;
+    report["interval"] = options.interval;
+    report["movies"] = results;
+    report["summary"] = {{"total", results.size()}, {"failed", failed}, {"mismatched", mismatched}};
+
+    const auto json = report.dump(4);
+    if (const auto output_path = cmdl("--output").str(); !output_path.empty())
+    {
+        std::ofstream of(output_path);
+        of << json;
+    }
+    else
+    {
+        puts(json.c_str());
+    }
+
+    return failed == 0 && mismatched == 0 ? 0 : 1;
+}
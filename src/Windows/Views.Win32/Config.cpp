@@ -382,11 +382,13 @@ static void handle_config_ini(const bool is_reading, mINI::INIStructure &ini)
     HANDLE_P_VALUE(is_recent_scripts_frozen)
     HANDLE_P_VALUE(core.seek_savestate_interval)
     HANDLE_P_VALUE(core.seek_savestate_max_count)
+    HANDLE_P_VALUE(core.seek_savestate_eviction)
     HANDLE_P_VALUE(piano_roll_constrain_edit_to_column)
     HANDLE_P_VALUE(piano_roll_undo_stack_size)
     HANDLE_P_VALUE(piano_roll_keep_selection_visible)
     HANDLE_P_VALUE(piano_roll_keep_playhead_visible)
     HANDLE_P_VALUE(core.st_undo_load)
+    HANDLE_P_VALUE(core.st_codec)
     HANDLE_P_VALUE(core.use_summercart)
     HANDLE_P_VALUE(core.wii_vc_emulation)
     HANDLE_P_VALUE(core.float_exception_emulation)
@@ -415,6 +417,7 @@ static void handle_config_ini(const bool is_reading, mINI::INIStructure &ini)
     HANDLE_P_VALUE(core.vcr_readonly)
     HANDLE_P_VALUE(core.vcr_backups)
     HANDLE_P_VALUE(core.vcr_write_extended_format)
+    HANDLE_P_VALUE(core.vcr_sync)
     HANDLE_P_VALUE(core.wait_at_movie_end)
     HANDLE_P_VALUE(automatic_update_checking)
     HANDLE_P_VALUE(silent_mode)
@@ -290,6 +290,20 @@ bool show_error_dialog_for_result(const core_result result, void *hwnd)
         module = L"Core";
         error = L"The core params are missing a critical component.";
         break;
+    case IN_InstanceActive:
+        module = L"Core";
+        error = L"Another core instance is running a rom in this process.";
+        break;
+#pragma endregion
+#pragma region Tracelog
+    case TL_BadFile:
+        module = L"Tracelog";
+        error = L"The trace file couldn't be opened or written.";
+        break;
+    case TL_InvalidFormat:
+        module = L"Tracelog";
+        error = L"The trace file has an invalid format or is corrupted.";
+        break;
 #pragma endregion
     default:
         module = L"Unknown";
@@ -643,7 +643,10 @@ static void start_tracelog()
     auto result = MessageBox(g_main_ctx.hwnd, L"Should the trace log be generated in a binary format?", L"Trace Logger",
                              MB_YESNO | MB_ICONQUESTION | MB_DEFBUTTON1);
 
-    g_main_ctx.core_ctx->tl_start(path, result == IDYES, false);
+    if (const auto res = g_main_ctx.core_ctx->tl_start(path, result == IDYES, false); res != Res_Ok)
+    {
+        show_error_dialog_for_result(res);
+    }
 }
 
 static void show_debugger()
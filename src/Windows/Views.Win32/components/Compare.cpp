@@ -10,10 +10,39 @@
 static uint8_t compare_mode = 0;
 static size_t compare_interval = 0;
 
+// The control run's state hashes, keyed by sample. Only loaded in actual mode.
+static std::optional<std::map<size_t, uint64_t>> expected_hashes;
+
+// Whether the control run has replaced the previous run's hashes yet.
+static bool hashes_truncated = false;
+
+static std::filesystem::path hashes_path()
+{
+    return Config::save_directory() / L"cmp_hashes.txt";
+}
+
+/**
+ * \brief Loads the control run's hashes, which are stored as one "sample hash" line per comparison.
+ */
+static std::map<size_t, uint64_t> load_hashes()
+{
+    std::map<size_t, uint64_t> hashes;
+    std::ifstream file(hashes_path());
+    size_t sample;
+    uint64_t hash;
+    while (file >> std::dec >> sample >> std::hex >> hash)
+    {
+        hashes[sample] = hash;
+    }
+    return hashes;
+}
+
 void Compare::start(bool control, size_t interval)
 {
     compare_mode = control ? 1 : 2;
     compare_interval = interval;
+    expected_hashes.reset();
+    hashes_truncated = false;
 }
 
 void Compare::compare(size_t current_sample)
@@ -28,33 +57,35 @@ void Compare::compare(size_t current_sample)
         return;
     }
 
-    const auto save_dir = Config::save_directory();
+    const auto hash = g_main_ctx.core_ctx->st_hash(core_st_hash_all);
 
     if (compare_mode == 2)
     {
-        if (current_sample > compare_interval * 2)
+        if (!expected_hashes)
         {
-            const auto expected_path = save_dir / std::format(L"cmp_expected_{}.st", current_sample - compare_interval);
-            const auto actual_path = save_dir / std::format(L"cmp_actual_{}.st", current_sample - compare_interval);
-
-            if (IOUtils::file_contents_equal(expected_path, actual_path) == 1)
-            {
-                g_view_logger->info("MATCH at frame {}", current_sample - compare_interval);
-            }
-            else
-            {
-                g_view_logger->error("DIFFERENCE at frame {}", current_sample - compare_interval);
-            }
+            expected_hashes = load_hashes();
         }
 
-        const auto actual_path = save_dir / std::format(L"cmp_actual_{}.st", current_sample);
-        g_main_ctx.core_ctx->st_do_file(actual_path.c_str(), core_st_job_save, nullptr, true);
+        const auto it = expected_hashes->find(current_sample);
+        if (it == expected_hashes->end())
+        {
+            g_view_logger->warn("No control hash for frame {}", current_sample);
+        }
+        else if (it->second == hash)
+        {
+            g_view_logger->info("MATCH at frame {}", current_sample);
+        }
+        else
+        {
+            g_view_logger->error("DIFFERENCE at frame {}", current_sample);
+        }
 
         return;
     }
 
-    const auto path = save_dir / std::format(L"cmp_expected_{}.st", current_sample);
-    g_main_ctx.core_ctx->st_do_file(path.c_str(), core_st_job_save, nullptr, true);
+    std::ofstream file(hashes_path(), hashes_truncated ? std::ios::app : std::ios::trunc);
+    hashes_truncated = true;
+    file << std::format("{} {:016x}\n", current_sample, hash);
 }
 
 bool Compare::active()
@@ -7,8 +7,8 @@
 #pragma once
 
 /**
- * A module responsible for comparison of expected and actual savestates during movie playback. Used for regression
- * testing.
+ * A module responsible for comparison of expected and actual emulator state hashes during movie playback. Used for
+ * regression testing.
  */
 namespace Compare
 {
@@ -20,10 +20,10 @@ namespace Compare
 void start(bool control, size_t interval);
 
 /**
- * \brief Performs the comparison between the expected and actual savestates at the current sample.
+ * \brief Records or compares the emulator state hash at the current sample.
  * \param current_sample The VCR's current sample.
- * \warning Requires corresponding savestates to be present in the saves directory. Note that they are not checked for
- * ROM or movie congruence.
+ * \warning Must be called from the emu thread. Requires the control run's hashes to be present in the saves directory.
+ * Note that they are not checked for ROM or movie congruence.
  */
 void compare(size_t current_sample);
 
@@ -712,6 +712,21 @@ std::vector<t_options_group> get_static_option_groups()
                    L"out of memory exception.",
         GENPROPS(int32_t, core.seek_savestate_max_count),
     });
+    seek_piano_roll_group.items.emplace_back(t_options_item{
+        .type = t_options_item::Type::Enum,
+        .group_id = seek_piano_roll_group.id,
+        .name = L"Savestate Eviction",
+        .tooltip = L"Which savestate is discarded when the maximum count is exceeded.\nOldest - The one with the "
+                   L"lowest frame\nLeast Recently Used - The one which was used the longest time ago\nThinning - "
+                   L"Keep savestates dense near the current frame and sparse further back",
+        GENPROPS(int32_t, core.seek_savestate_eviction),
+        .possible_values =
+            {
+                std::make_pair(L"Oldest", (int32_t)core_seek_savestate_eviction_oldest),
+                std::make_pair(L"Least Recently Used", (int32_t)core_seek_savestate_eviction_lru),
+                std::make_pair(L"Thinning", (int32_t)core_seek_savestate_eviction_thinning),
+            },
+    });
     seek_piano_roll_group.items.emplace_back(t_options_item{
         .type = t_options_item::Type::Bool,
         .group_id = seek_piano_roll_group.id,
@@ -825,13 +840,16 @@ std::vector<t_options_group> get_static_option_groups()
         .name = L"Type",
         .tooltip =
             L"The core type to utilize for emulation.\nInterpreter - Slow and relatively accurate\nDynamic Recompiler "
-            L"- Fast, possibly less accurate, and only for x86 processors\nPure Interpreter - Very slow and accurate",
+            L"- Fast, possibly less accurate, and only for x86 processors\nPure Interpreter - Very slow and accurate\n"
+            L"Threaded Interpreter - Interpreter which runs common instructions from a compact stream, faster on any "
+            L"processor",
         GENPROPS(int32_t, core.core_type),
         .possible_values =
             {
                 std::make_pair(L"Interpreter", 0),
                 std::make_pair(L"Dynamic Recompiler", 1),
                 std::make_pair(L"Pure Interpreter", 2),
+                std::make_pair(L"Threaded Interpreter", 3),
             },
         .is_readonly = [] { return g_main_ctx.core_ctx->vr_get_launched(); },
     });
@@ -842,6 +860,21 @@ std::vector<t_options_group> get_static_option_groups()
         .tooltip = L"Whether undo savestate load functionality is enabled.",
         GENPROPS(int32_t, core.st_undo_load),
     });
+    core_group.items.emplace_back(t_options_item{
+        .type = t_options_item::Type::Enum,
+        .group_id = core_group.id,
+        .name = L"Savestate Compression",
+        .tooltip = L"The codec used to compress savestate files.\nStore - No compression, largest files\nLZ4 - Fastest "
+                   L"compression\nzstd - Fast compression, small files\ngzip - Slowest, but loadable by older versions",
+        GENPROPS(int32_t, core.st_codec),
+        .possible_values =
+            {
+                std::make_pair(L"Store", (int32_t)core_st_codec_store),
+                std::make_pair(L"LZ4", (int32_t)core_st_codec_lz4),
+                std::make_pair(L"zstd", (int32_t)core_st_codec_zstd),
+                std::make_pair(L"gzip", (int32_t)core_st_codec_gzip),
+            },
+    });
     core_group.items.emplace_back(t_options_item{
         .type = t_options_item::Type::Number,
         .group_id = core_group.id,
@@ -919,6 +952,20 @@ std::vector<t_options_group> get_static_option_groups()
                    L"are set to 0.",
         GENPROPS(int32_t, core.vcr_write_extended_format),
     });
+    vcr_group.items.emplace_back(t_options_item{
+        .type = t_options_item::Type::Enum,
+        .group_id = vcr_group.id,
+        .name = L"Movie Sync",
+        .tooltip = L"When writes to the recorded movie are forced to disk.\nNever - Fastest, but a system crash can "
+                   L"lose recent input\nOn Stop - When the recording stops\nAlways - After every write, slowest",
+        GENPROPS(int32_t, core.vcr_sync),
+        .possible_values =
+            {
+                std::make_pair(L"Never", (int32_t)core_vcr_sync_never),
+                std::make_pair(L"On Stop", (int32_t)core_vcr_sync_on_stop),
+                std::make_pair(L"Always", (int32_t)core_vcr_sync_always),
+            },
+    });
     vcr_group.items.emplace_back(t_options_item{
         .type = t_options_item::Type::Bool,
         .group_id = vcr_group.id,
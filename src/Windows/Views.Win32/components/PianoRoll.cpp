@@ -158,6 +158,9 @@ void update_inputs()
         SetWindowRedraw(g_lv_hwnd, true);
     }
 
+    // Seek savestate changes are applied to this incrementally, so start from the full set.
+    g_main_ctx.core_ctx->vcr_get_seek_savestate_frames(g_seek_savestate_frames);
+
     RedrawWindow(g_joy_hwnd, nullptr, nullptr, RDW_INVALIDATE);
 }
 
@@ -759,7 +762,10 @@ void on_current_sample_changed(std::any data)
 
         if (g_main_ctx.core_ctx->vcr_get_task() == task_recording)
         {
-            g_piano_roll_state.inputs = g_main_ctx.core_ctx->vcr_get_inputs();
+            // This runs every frame, so reuse the existing buffer instead of pulling a new copy of the inputs.
+            g_main_ctx.core_ctx->vcr_view_inputs([](const std::span<const core_buttons> inputs) {
+                g_piano_roll_state.inputs.assign(inputs.begin(), inputs.end());
+            });
             ListView_SetItemCountEx(g_lv_hwnd, g_piano_roll_state.inputs.size(), LVSICF_NOSCROLL);
         }
 
@@ -821,7 +827,15 @@ void on_seek_savestate_changed(std::any data)
 {
     g_piano_roll_dispatcher->invoke([=] {
         auto value = std::any_cast<size_t>(data);
-        g_main_ctx.core_ctx->vcr_get_seek_savestate_frames(g_seek_savestate_frames);
+        // Only the savestate at the notified frame changed, so there's no need to pull all frames again.
+        if (g_main_ctx.core_ctx->vcr_has_seek_savestate_at_frame(value))
+        {
+            g_seek_savestate_frames[value] = true;
+        }
+        else
+        {
+            g_seek_savestate_frames.erase(value);
+        }
         ListView_Update(g_lv_hwnd, value);
     });
 }
@@ -1014,6 +1028,13 @@ void on_piano_roll_selection_changed()
 {
     g_piano_roll_state.selected_indicies = get_listview_selection(g_lv_hwnd);
 
+    // A selected frame is a likely seek target, so let the core prepare the savestate for seeking to it.
+    if (g_piano_roll_state.selected_indicies.size() == 1 && can_seek())
+    {
+        const auto frame = g_piano_roll_state.selected_indicies[0];
+        ThreadPool::submit_task([=] { g_main_ctx.core_ctx->vcr_prefetch_seek(std::to_string(frame), true); });
+    }
+
     update_groupbox_status_text();
     RedrawWindow(g_joy_hwnd, nullptr, nullptr, RDW_INVALIDATE);
 }
@@ -1225,7 +1246,15 @@ handle_mouse_move:
             goto def;
         }
 
-        ThreadPool::submit_task([=] { g_main_ctx.core_ctx->vcr_begin_seek(std::to_string(lplvhtti.iItem), true); });
+        // While scrubbing, the previous seek is often still running. Prepare the new target so the seek started on
+        // the next mouse move can begin right away.
+        ThreadPool::submit_task([=] {
+            const auto str = std::to_string(lplvhtti.iItem);
+            if (g_main_ctx.core_ctx->vcr_begin_seek(str, true) == VCR_SeekAlreadyRunning)
+            {
+                g_main_ctx.core_ctx->vcr_prefetch_seek(str, true);
+            }
+        });
         return 0;
     }
 
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/r4300/cop1_helpers.h>
+#include <Core/r4300/macros.h>
+#include <Core/r4300/ops.h>
+#include <Core/r4300/r4300.h>
+#include <Core/r4300/recomp.h>
+
+static core_cfg cfg{};
+static core_params params{};
+static core_ctx *ctx = nullptr;
+
+// A straight run of COP1 instructions operating on f1 and f2 and writing to f3.
+static precomp_instr instrs[1000]{};
+
+/**
+ * \brief Sets up the FPU state and an instruction run for the handlers to execute.
+ */
+static void prepare_test(const bool float_exceptions)
+{
+    cfg = {};
+    cfg.float_exception_emulation = float_exceptions;
+    params.cfg = &cfg;
+    core_create(&params, &ctx);
+
+    interpcore = 0;
+    cop1_sync_float_exception_mode();
+
+    core_Status = 0x20000000;
+    for (int32_t i = 0; i < 32; ++i)
+    {
+        reg_cop1_fgr_64[i] = 0;
+        reg_cop1_simple[i] = (float *)&reg_cop1_fgr_64[i];
+        reg_cop1_double[i] = (double *)&reg_cop1_fgr_64[i];
+    }
+
+    for (auto &instr : instrs)
+    {
+        instr.f.cf.fs = 1;
+        instr.f.cf.ft = 2;
+        instr.f.cf.fd = 3;
+    }
+    PC = instrs;
+}
+
+/**
+ * \brief Executes a handler over the whole instruction run.
+ */
+static void run(void (*op)())
+{
+    PC = instrs;
+    for (size_t i = 0; i < std::size(instrs); ++i)
+    {
+        op();
+    }
+}
+
+#pragma region Unit
+
+TEST_CASE("sync_follows_config", "cop1_sync_float_exception_mode")
+{
+    prepare_test(false);
+    REQUIRE_FALSE(g_float_exceptions);
+
+    cfg.float_exception_emulation = true;
+    cop1_sync_float_exception_mode();
+    REQUIRE(g_float_exceptions);
+    REQUIRE(COP1_OP(ADD_S) == &ADD_S<true>);
+
+    cfg.float_exception_emulation = false;
+    cop1_sync_float_exception_mode();
+    REQUIRE_FALSE(g_float_exceptions);
+    REQUIRE(COP1_OP(ADD_S) == &ADD_S<false>);
+}
+
+TEST_CASE("sync_invalidates_blocks_on_change", "cop1_sync_float_exception_mode")
+{
+    prepare_test(false);
+    memset(invalid_code, 0, sizeof(invalid_code));
+
+    cop1_sync_float_exception_mode();
+    REQUIRE(invalid_code[0x80000] == 0);
+
+    cfg.float_exception_emulation = true;
+    cop1_sync_float_exception_mode();
+    REQUIRE(invalid_code[0x80000] == 1);
+}
+
+TEST_CASE("denormal_input_is_computed_without_exception_emulation", "ADD_S")
+{
+    prepare_test(false);
+
+    const float denormal = std::numeric_limits<float>::denorm_min();
+    *reg_cop1_simple[1] = denormal;
+    *reg_cop1_simple[2] = 1.0f;
+
+    ADD_S<false>();
+
+    REQUIRE(*reg_cop1_simple[3] == denormal + 1.0f);
+    REQUIRE(PC == instrs + 1);
+}
+
+TEST_CASE("normal_operands_match_across_specializations", "MUL_D")
+{
+    prepare_test(true);
+
+    *reg_cop1_double[1] = 1.5;
+    *reg_cop1_double[2] = -2.25;
+
+    MUL_D<true>();
+    const double checked = *reg_cop1_double[3];
+
+    PC = instrs;
+    MUL_D<false>();
+
+    REQUIRE(*reg_cop1_double[3] == checked);
+    REQUIRE(checked == 1.5 * -2.25);
+}
+
+#pragma endregion
+
+#pragma region Benchmark
+
+TEST_CASE("cop1_throughput", "[.][benchmark]")
+{
+    prepare_test(false);
+
+    *reg_cop1_simple[1] = 1.5f;
+    *reg_cop1_simple[2] = 2.5f;
+    BENCHMARK("add_s")
+    {
+        run(ADD_S<false>);
+        return *reg_cop1_simple[3];
+    };
+    BENCHMARK("add_s_float_exceptions")
+    {
+        run(ADD_S<true>);
+        return *reg_cop1_simple[3];
+    };
+
+    *reg_cop1_double[1] = 1.5;
+    *reg_cop1_double[2] = 2.5;
+    BENCHMARK("div_d")
+    {
+        run(DIV_D<false>);
+        return *reg_cop1_double[3];
+    };
+    BENCHMARK("div_d_float_exceptions")
+    {
+        run(DIV_D<true>);
+        return *reg_cop1_double[3];
+    };
+
+    BENCHMARK("trunc_w_d")
+    {
+        run(TRUNC_W_D<false>);
+        return reg_cop1_fgr_64[3];
+    };
+    BENCHMARK("trunc_w_d_float_exceptions")
+    {
+        run(TRUNC_W_D<true>);
+        return reg_cop1_fgr_64[3];
+    };
+}
+
+#pragma endregion
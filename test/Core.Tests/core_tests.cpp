@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/r4300/r4300.h>
+
+static core_cfg cfg{};
+static core_params params{};
+static core_params other_params{};
+static core_ctx *ctx = nullptr;
+
+#pragma region Unit
+
+TEST_CASE("recreating_instance_while_idle_succeeds", "core_create")
+{
+    params.cfg = &cfg;
+    other_params.cfg = &cfg;
+
+    REQUIRE(core_create(&params, &ctx) == Res_Ok);
+    REQUIRE(core_create(&other_params, &ctx) == Res_Ok);
+    REQUIRE(ctx != nullptr);
+}
+
+TEST_CASE("recreating_same_instance_while_launched_succeeds", "core_create")
+{
+    params.cfg = &cfg;
+
+    REQUIRE(core_create(&params, &ctx) == Res_Ok);
+
+    emu_launched = true;
+    const auto result = core_create(&params, &ctx);
+    emu_launched = false;
+
+    REQUIRE(result == Res_Ok);
+}
+
+TEST_CASE("creating_second_instance_while_launched_fails", "core_create")
+{
+    params.cfg = &cfg;
+    other_params.cfg = &cfg;
+
+    REQUIRE(core_create(&params, &ctx) == Res_Ok);
+
+    emu_launched = true;
+    core_ctx *other_ctx = nullptr;
+    const auto result = core_create(&other_params, &other_ctx);
+    emu_launched = false;
+
+    REQUIRE(result == IN_InstanceActive);
+    REQUIRE(other_ctx == nullptr);
+}
+
+#pragma endregion
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/memory/memory.h>
+#include <Core/r4300/debugger.h>
+#include <Core/r4300/r4300.h>
+
+static core_cfg cfg{};
+static core_params params{};
+static core_ctx *ctx = nullptr;
+static std::atomic<bool> paused{};
+static core_dbg_cpu_state last_cpu_state{};
+
+static void prepare()
+{
+    params.cfg = &cfg;
+    params.callbacks.debugger_resumed_changed = [](const bool resumed) { paused = !resumed; };
+    params.callbacks.debugger_cpu_state_changed = [](core_dbg_cpu_state *state) { last_cpu_state = *state; };
+    core_create(&params, &ctx);
+
+    ctx->dbg_set_is_resumed(true);
+    for (const auto address : ctx->dbg_get_breakpoints())
+    {
+        ctx->dbg_remove_breakpoint(address);
+    }
+    for (const auto &watchpoint : ctx->dbg_get_watchpoints())
+    {
+        ctx->dbg_remove_watchpoint(watchpoint.address);
+    }
+
+    memset(rdram, 0, sizeof(rdram));
+    for (const auto base : {0x8000, 0xa000})
+    {
+        readmem[base] = read_rdram;
+        readmemb[base] = read_rdramb;
+        readmemh[base] = read_rdramh;
+        readmemd[base] = read_rdramd;
+        writemem[base] = write_rdram;
+        writememb[base] = write_rdramb;
+        writememh[base] = write_rdramh;
+        writememd[base] = write_rdramd;
+    }
+}
+
+#pragma region Unit
+
+TEST_CASE("breakpoints_are_added_and_removed", "dbg_add_breakpoint")
+{
+    prepare();
+
+    ctx->dbg_add_breakpoint(0x80001000);
+    ctx->dbg_add_breakpoint(0x80000400);
+    ctx->dbg_add_breakpoint(0x80001000);
+
+    REQUIRE(ctx->dbg_get_breakpoints() == std::vector<uint32_t>{0x80000400, 0x80001000});
+
+    ctx->dbg_remove_breakpoint(0x80000400);
+    ctx->dbg_remove_breakpoint(0x80002000);
+
+    REQUIRE(ctx->dbg_get_breakpoints() == std::vector<uint32_t>{0x80001000});
+}
+
+TEST_CASE("armed_while_breakpoints_exist", "dbg_add_breakpoint")
+{
+    prepare();
+
+    REQUIRE_FALSE(g_dbg_armed);
+
+    ctx->dbg_add_breakpoint(0x80000400);
+    REQUIRE(g_dbg_armed);
+
+    ctx->dbg_remove_breakpoint(0x80000400);
+    REQUIRE_FALSE(g_dbg_armed);
+}
+
+TEST_CASE("armed_while_paused", "dbg_set_is_resumed")
+{
+    prepare();
+
+    ctx->dbg_set_is_resumed(false);
+    REQUIRE(g_dbg_armed);
+
+    ctx->dbg_set_is_resumed(true);
+    REQUIRE_FALSE(g_dbg_armed);
+}
+
+TEST_CASE("armed_while_stepping", "dbg_step")
+{
+    prepare();
+
+    ctx->dbg_set_is_resumed(false);
+    ctx->dbg_step();
+    REQUIRE(g_dbg_armed);
+
+    ctx->dbg_set_is_resumed(true);
+    REQUIRE_FALSE(g_dbg_armed);
+}
+
+TEST_CASE("early_cycle_passes_addresses_without_breakpoint", "on_early_cycle")
+{
+    prepare();
+
+    ctx->dbg_add_breakpoint(0x80000400);
+    ctx->dbg_add_breakpoint(0x80000404);
+    ctx->dbg_remove_breakpoint(0x80000404);
+
+    // Same page as the remaining breakpoint, and a page without any.
+    Debugger::on_early_cycle(0, 0x80000404);
+    Debugger::on_early_cycle(0, 0x80002000);
+
+    REQUIRE(ctx->dbg_get_resumed());
+}
+
+TEST_CASE("late_cycle_holds_until_resumed", "on_late_cycle")
+{
+    prepare();
+
+    // The interpreter reports the last instruction this way when it's armed, which has to stop it from dispatching
+    // the next one.
+    ctx->dbg_set_is_resumed(false);
+
+    std::atomic<bool> returned = false;
+    std::thread thread([&] {
+        Debugger::on_late_cycle(0x24010001, 0x80001004);
+        returned = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE_FALSE(returned);
+
+    ctx->dbg_set_is_resumed(true);
+    thread.join();
+
+    REQUIRE(returned);
+}
+
+TEST_CASE("watchpoints_trap_only_watched_pages_and_kinds", "dbg_add_watchpoint")
+{
+    prepare();
+
+    ctx->dbg_add_watchpoint({.address = 0x80000100, .size = 4, .kind = core_dbg_watch_write});
+
+    REQUIRE(readmem[0x8000] == read_rdram);
+    REQUIRE(writemem[0x8000] != write_rdram);
+    REQUIRE(writememb[0x8000] != write_rdramb);
+    REQUIRE(writemem[0xa000] == write_rdram);
+
+    ctx->dbg_remove_watchpoint(0x80000100);
+
+    REQUIRE(writemem[0x8000] == write_rdram);
+    REQUIRE(writememb[0x8000] == write_rdramb);
+    REQUIRE(ctx->dbg_get_watchpoints().empty());
+}
+
+TEST_CASE("watchpoints_are_replaced_at_same_address", "dbg_add_watchpoint")
+{
+    prepare();
+
+    ctx->dbg_add_watchpoint({.address = 0x80000100, .size = 4, .kind = core_dbg_watch_write});
+    ctx->dbg_add_watchpoint({.address = 0x80000000, .size = 1, .kind = core_dbg_watch_read});
+    ctx->dbg_add_watchpoint({.address = 0x80000100, .size = 8, .kind = core_dbg_watch_access});
+
+    const auto watchpoints = ctx->dbg_get_watchpoints();
+    REQUIRE(watchpoints.size() == 2);
+    REQUIRE(watchpoints[0].address == 0x80000000);
+    REQUIRE(watchpoints[1].address == 0x80000100);
+    REQUIRE(watchpoints[1].size == 8);
+    REQUIRE(watchpoints[1].kind == core_dbg_watch_access);
+}
+
+TEST_CASE("unwatched_accesses_on_trapped_page_pass_through", "dbg_add_watchpoint")
+{
+    prepare();
+
+    ctx->dbg_add_watchpoint({.address = 0x80000100, .size = 4, .kind = core_dbg_watch_access});
+
+    REQUIRE(write32(0x80000200, 0xDEADBEEF));
+    uint32_t value{};
+    REQUIRE(read32(0x80000200, value));
+
+    REQUIRE(value == 0xDEADBEEF);
+    REQUIRE(rdram[0x200 / 4] == 0xDEADBEEF);
+    REQUIRE(ctx->dbg_get_resumed());
+}
+
+TEST_CASE("watched_access_pauses_before_it_happens", "dbg_add_watchpoint")
+{
+    prepare();
+    interpcore = 1;
+    interp_addr = 0x80001000;
+
+    ctx->dbg_add_watchpoint({.address = 0x80000100, .size = 4, .kind = core_dbg_watch_write});
+
+    std::thread thread([] { write8(0x80000102, 0x42); });
+    while (!paused)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    REQUIRE(last_cpu_state.address == 0x80001000);
+    REQUIRE(last_cpu_state.watch_address == 0x80000102);
+    REQUIRE(last_cpu_state.watch_kind == core_dbg_watch_write);
+    REQUIRE(rdramb[0x102 ^ S8] == 0);
+
+    ctx->dbg_set_is_resumed(true);
+    thread.join();
+    interpcore = 0;
+
+    REQUIRE(rdramb[0x102 ^ S8] == 0x42);
+}
+
+#pragma endregion
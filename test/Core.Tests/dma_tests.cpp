@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/memory/dma.h>
+#include <Core/memory/memory.h>
+
+#if defined(__unix__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * \brief The byte-by-byte copy the DMA kernels replace.
+ */
+static void copy_swizzled_reference(uint8_t *dst, const uint32_t dst_off, const uint8_t *src, const uint32_t src_off,
+                                    const uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) dst[(dst_off + i) ^ S8] = src[(src_off + i) ^ S8];
+}
+
+/**
+ * \brief Creates a buffer of the specified size filled with a deterministic pattern.
+ */
+static std::vector<uint8_t> make_buffer(const size_t size, const uint8_t seed)
+{
+    std::vector<uint8_t> buf(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        buf[i] = static_cast<uint8_t>(i * 31 + seed);
+    }
+    return buf;
+}
+
+#pragma region Unit
+
+TEST_CASE("copy_matches_bytewise_copy_for_all_alignments", "dma_copy_swizzled")
+{
+    const auto src = make_buffer(0x400, 7);
+
+    for (uint32_t dst_off = 0; dst_off < 8; dst_off++)
+    {
+        for (uint32_t src_off = 0; src_off < 8; src_off++)
+        {
+            for (const uint32_t len : {0u, 1u, 3u, 4u, 5u, 15u, 16u, 17u, 33u, 64u, 127u, 0x200u})
+            {
+                auto expected = make_buffer(0x400, 1);
+                auto actual = expected;
+
+                copy_swizzled_reference(expected.data(), dst_off, src.data(), src_off, len);
+                dma_copy_swizzled(actual.data(), dst_off, src.data(), src_off, len);
+
+                INFO("dst_off " << dst_off << " src_off " << src_off << " len " << len);
+                REQUIRE(actual == expected);
+            }
+        }
+    }
+}
+
+#if defined(__unix__)
+TEST_CASE("copy_ending_at_source_end_stays_in_bounds", "dma_copy_swizzled")
+{
+    // The source ends right before an inaccessible page, so reading past its end crashes.
+    const auto page_size = (size_t)sysconf(_SC_PAGESIZE);
+    auto *const pages = (uint8_t *)mmap(nullptr, page_size * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                                        -1, 0);
+    REQUIRE(pages != MAP_FAILED);
+    REQUIRE(mprotect(pages + page_size, page_size, PROT_NONE) == 0);
+
+    const auto pattern = make_buffer(page_size, 7);
+    memcpy(pages, pattern.data(), page_size);
+
+    // Every combination of alignments leaves an unaligned source for the word copy, whose range ends at the page end.
+    for (uint32_t dst_off = 0; dst_off < 4; dst_off++)
+    {
+        for (const uint32_t len : {4u, 5u, 6u, 7u, 8u, 65u, 66u, 0x203u})
+        {
+            const uint32_t src_off = (uint32_t)page_size - len;
+            auto expected = make_buffer(0x400, 1);
+            auto actual = expected;
+
+            copy_swizzled_reference(expected.data(), dst_off, pages, src_off, len);
+            dma_copy_swizzled(actual.data(), dst_off, pages, src_off, len);
+
+            INFO("dst_off " << dst_off << " len " << len);
+            REQUIRE(actual == expected);
+        }
+    }
+
+    munmap(pages, page_size * 2);
+}
+#endif
+
+TEST_CASE("fill_only_touches_range", "dma_fill_swizzled")
+{
+    for (uint32_t dst_off = 0; dst_off < 8; dst_off++)
+    {
+        for (const uint32_t len : {0u, 1u, 3u, 4u, 9u, 0x41u})
+        {
+            auto expected = make_buffer(0x100, 3);
+            auto actual = expected;
+            for (uint32_t i = 0; i < len; i++) expected[(dst_off + i) ^ S8] = 0xFF;
+
+            dma_fill_swizzled(actual.data(), dst_off, 0xFF, len);
+
+            REQUIRE(actual == expected);
+        }
+    }
+}
+
+#pragma endregion
+
+#pragma region Benchmark
+
+TEST_CASE("dma_copy_throughput", "[.][benchmark]")
+{
+    const auto src = make_buffer(0x100000 + 8, 7);
+    auto dst = make_buffer(0x100000 + 8, 1);
+
+    // Small SP transfers, typical PI transfers and large PI transfers. PI transfers often start at a halfword offset
+    // in the ROM, which needs shifting.
+    for (const uint32_t len : {0x100u, 0x4000u, 0x100000u})
+    {
+        for (const uint32_t src_off : {0u, 2u})
+        {
+            const auto suffix = std::format("{:#x}_src_off_{}", len, src_off);
+
+            BENCHMARK("bytewise_" + suffix)
+            {
+                copy_swizzled_reference(dst.data(), 0, src.data(), src_off, len);
+                return dst[0];
+            };
+
+            BENCHMARK("kernel_" + suffix)
+            {
+                dma_copy_swizzled(dst.data(), 0, src.data(), src_off, len);
+                return dst[0];
+            };
+        }
+    }
+}
+
+#pragma endregion
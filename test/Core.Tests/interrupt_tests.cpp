@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/r4300/r4300.h>
+#include <Core/r4300/macros.h>
+#include <Core/r4300/interrupt.h>
+
+using event = std::pair<int32_t, uint32_t>;
+
+/**
+ * \brief Replaces the event queue with the specified events, inserted in order.
+ */
+static void load_queue(const std::vector<event> &events)
+{
+    std::vector<uint32_t> buf;
+    for (const auto &[type, count] : events)
+    {
+        buf.push_back(type);
+        buf.push_back(count);
+    }
+    buf.push_back(0xFFFFFFFF);
+    load_eventqueue_infos((char *)buf.data());
+}
+
+/**
+ * \brief Gets the events in the queue, in dispatch order.
+ */
+static std::vector<event> save_queue()
+{
+    std::vector<uint32_t> buf(1024);
+    const auto len = save_eventqueue_infos((char *)buf.data());
+
+    std::vector<event> events;
+    for (int32_t i = 0; i < len / 4 - 1; i += 2)
+    {
+        events.emplace_back(buf[i], buf[i + 1]);
+    }
+    return events;
+}
+
+#pragma region Unit
+
+TEST_CASE("events_are_ordered_by_count_with_ties_in_insertion_order", "add_interrupt_event")
+{
+    core_Count = 0x1000;
+    load_queue({{VI_INT, 0x5000}, {SI_INT, 0x2000}});
+
+    add_interrupt_event(PI_INT, 0x4000);
+    add_interrupt_event_count(DP_INT, 0x3000);
+    add_interrupt_event_count(AI_INT, 0x5000);
+
+    const std::vector<event> expected = {
+    {SI_INT, 0x2000}, {DP_INT, 0x3000}, {VI_INT, 0x5000}, {PI_INT, 0x5000}, {AI_INT, 0x5000}};
+    REQUIRE(save_queue() == expected);
+}
+
+TEST_CASE("ordering_survives_count_wraparound", "add_interrupt_event")
+{
+    core_Count = 0xFFFFF000;
+    load_queue({});
+
+    add_interrupt_event(SI_INT, 0x2000);
+    add_interrupt_event(VI_INT, 0x800);
+
+    const std::vector<event> expected = {{VI_INT, 0xFFFFF800}, {SI_INT, 0x1000}};
+    REQUIRE(save_queue() == expected);
+}
+
+TEST_CASE("empty_queue_is_saved_as_terminator", "save_eventqueue_infos")
+{
+    load_queue({});
+
+    uint32_t buf[4]{};
+    REQUIRE(save_eventqueue_infos((char *)buf) == 4);
+    REQUIRE(buf[0] == 0xFFFFFFFF);
+}
+
+TEST_CASE("removed_events_free_their_entries", "remove_event")
+{
+    core_Count = 0;
+    load_queue({{VI_INT, 0x5000}});
+
+    // Far more than the pool's capacity, so this fails if entries leak.
+    for (int32_t i = 0; i < 100000; ++i)
+    {
+        add_interrupt_event(SI_INT, 0x100 + i % 0x1000);
+        add_interrupt_event(PI_INT, 0x200);
+        remove_event(SI_INT);
+        remove_event(PI_INT);
+    }
+
+    REQUIRE(get_event(SI_INT) == 0);
+    REQUIRE(get_event(VI_INT) == 0x5000);
+    REQUIRE(save_queue() == std::vector<event>{{VI_INT, 0x5000}});
+}
+
+#pragma endregion
+
+#pragma region Benchmark
+
+TEST_CASE("reschedule_throughput", "[.][benchmark]")
+{
+    core_Count = 0;
+    load_queue({{VI_INT, 0x80000}, {COMPARE_INT, 0x40000}, {SPECIAL_INT, 0}});
+
+    constexpr int32_t types[] = {SI_INT, PI_INT, AI_INT, SP_INT, DP_INT};
+
+    // Each run removes and re-adds 1000 events, roughly the churn of a few frames of emulation.
+    BENCHMARK("remove_and_add")
+    {
+        for (int32_t i = 0; i < 1000; ++i)
+        {
+            const auto type = types[i % std::size(types)];
+            remove_event(type);
+            add_interrupt_event(type, 0x100 + (i * 0x1234) % 0x10000);
+        }
+        return next_interrupt;
+    };
+}
+
+#pragma endregion
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/memory/memory.h>
+#include <Core/r4300/r4300.h>
+#include <Core/r4300/recomp.h>
+
+static void read_rdram_wrapper()
+{
+    read_rdram();
+}
+
+static void write_rdram_wrapper()
+{
+    write_rdram();
+}
+
+static void read_constant()
+{
+    *rdword = 0x1234;
+}
+
+/**
+ * \brief Maps RDRAM into the KSEG0 and KSEG1 regions of the handler tables, like <c>init_memory</c> does.
+ */
+static void prepare_test()
+{
+    memset(rdram, 0, sizeof(rdram));
+    memset(rdram_dirty_pages, 0, sizeof(rdram_dirty_pages));
+    memset(invalid_code, 1, sizeof(invalid_code));
+    for (int32_t i = 0; i < 0x80; i++)
+    {
+        for (const auto base : {0x8000, 0xa000})
+        {
+            readmem[base + i] = read_rdram;
+            readmemb[base + i] = read_rdramb;
+            readmemh[base + i] = read_rdramh;
+            readmemd[base + i] = read_rdramd;
+            writemem[base + i] = write_rdram;
+            writememb[base + i] = write_rdramb;
+            writememh[base + i] = write_rdramh;
+            writememd[base + i] = write_rdramd;
+        }
+    }
+}
+
+/**
+ * \brief Builds a block of alternating LW and SW instructions operating on the RDRAM pointed to by a0.
+ */
+static std::vector<precomp_instr> make_load_store_block(const size_t count)
+{
+    std::vector<precomp_instr> instrs(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const uint32_t offset = (i * 4) & 0xFFF;
+        const uint32_t op = i % 2 == 0 ? 0x23 : 0x2B;
+        PC = &instrs[i];
+        prefetch_opcode((op << 26) | (4 << 21) | (8 << 16) | offset);
+    }
+    return instrs;
+}
+
+static void run_block(std::vector<precomp_instr> &instrs)
+{
+    PC = instrs.data();
+    for (size_t i = 0; i < instrs.size(); ++i)
+    {
+        PC->ops();
+    }
+}
+
+#pragma region Unit
+
+TEST_CASE("word_roundtrip_through_both_segments", "read_word_in_memory")
+{
+    prepare_test();
+
+    uint64_t value = 0;
+    rdword = &value;
+
+    address = 0x80001000;
+    word = 0xDEADBEEF;
+    write_word_in_memory();
+
+    address = 0xA0001000;
+    read_word_in_memory();
+
+    REQUIRE(value == 0xDEADBEEF);
+    REQUIRE(rdram[0x1000 / 4] == 0xDEADBEEF);
+    REQUIRE(rdram_dirty_pages[1] == 1);
+}
+
+TEST_CASE("sub_word_accesses_use_rdram_byte_order", "read_byte_in_memory")
+{
+    prepare_test();
+
+    rdram[0] = 0x11223344;
+
+    uint64_t value = 0;
+    rdword = &value;
+
+    address = 0x80000000;
+    read_byte_in_memory();
+    REQUIRE(value == 0x11);
+
+    address = 0x80000002;
+    read_hword_in_memory();
+    REQUIRE(value == 0x3344);
+
+    address = 0x80000003;
+    g_byte = 0xAB;
+    write_byte_in_memory();
+    REQUIRE(rdram[0] == 0x112233AB);
+
+    address = 0x80000008;
+    dword = 0x0102030405060708;
+    write_dword_in_memory();
+    REQUIRE(rdram[2] == 0x01020304);
+    REQUIRE(rdram[3] == 0x05060708);
+
+    read_dword_in_memory();
+    REQUIRE(value == 0x0102030405060708);
+}
+
+TEST_CASE("hooked_region_uses_handler", "read_word_in_memory")
+{
+    prepare_test();
+
+    rdram[0] = 0xDEADBEEF;
+    readmem[0x8000] = read_constant;
+
+    uint64_t value = 0;
+    rdword = &value;
+    address = 0x80000000;
+    read_word_in_memory();
+
+    REQUIRE(value == 0x1234);
+}
+
+TEST_CASE("typed_accessors_roundtrip", "read32")
+{
+    prepare_test();
+
+    uint32_t paddr = 0;
+    REQUIRE(write32(0x80002000, 0xCAFEBABE, &paddr));
+    REQUIRE(paddr == 0x80002000);
+    REQUIRE(rdram_dirty_pages[2] == 1);
+
+    uint32_t value = 0;
+    REQUIRE(read32(0xA0002000, value));
+    REQUIRE(value == 0xCAFEBABE);
+
+    uint8_t b = 0;
+    REQUIRE(read8(0x80002001, b));
+    REQUIRE(b == 0xFE);
+
+    uint16_t h = 0;
+    REQUIRE(write16(0x80002002, 0x1234));
+    REQUIRE(read16(0x80002002, h));
+    REQUIRE(h == 0x1234);
+    REQUIRE(rdram[0x2000 / 4] == 0xCAFE1234);
+
+    uint64_t d = 0;
+    REQUIRE(write64(0x80002008, 0x0102030405060708));
+    REQUIRE(read64(0x80002008, d));
+    REQUIRE(d == 0x0102030405060708);
+}
+
+TEST_CASE("typed_accessors_use_hooked_handler", "read32")
+{
+    prepare_test();
+
+    rdram[0] = 0xDEADBEEF;
+    readmem[0x8000] = read_constant;
+    writemem[0x8000] = write_rdram_wrapper;
+
+    uint32_t value = 0;
+    uint32_t paddr = 0;
+    REQUIRE(read32(0x80000000, value, &paddr));
+    REQUIRE(value == 0x1234);
+    REQUIRE(paddr == 0x80000000);
+
+    REQUIRE(write32(0x80000004, 0xABCD));
+    REQUIRE(rdram[1] == 0xABCD);
+}
+
+#pragma endregion
+
+#pragma region Benchmark
+
+TEST_CASE("rdram_load_store_throughput", "[.][benchmark]")
+{
+    prepare_test();
+    reg[4] = (int64_t)(int32_t)0x80010000;
+
+    // Each run executes this many instructions, so instructions per second = count / mean.
+    auto instrs = make_load_store_block(4096);
+
+    // Plain wrappers don't match the RDRAM handlers, so this measures the old path through the tables.
+    for (int32_t i = 0; i < 0x80; i++)
+    {
+        readmem[0x8000 + i] = read_rdram_wrapper;
+        writemem[0x8000 + i] = write_rdram_wrapper;
+    }
+    BENCHMARK("handler_tables")
+    {
+        run_block(instrs);
+        return reg[8];
+    };
+
+    prepare_test();
+    BENCHMARK("fast_path")
+    {
+        run_block(instrs);
+        return reg[8];
+    };
+}
+
+#pragma endregion
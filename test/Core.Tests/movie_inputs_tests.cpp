@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/r4300/movie_inputs.h>
+#include <Core/r4300/vcr.h>
+
+static core_cfg cfg{};
+static core_params params{};
+static core_ctx *ctx = nullptr;
+
+/**
+ * \brief Writes a version 3 movie with the specified inputs to an empty directory and returns its path.
+ */
+static std::filesystem::path write_movie_file(const std::vector<core_buttons> &inputs)
+{
+    cfg = {};
+    params = {};
+    params.cfg = &cfg;
+    core_create(&params, &ctx);
+
+    const auto dir = std::filesystem::temp_directory_path() / "mupen64_movie_inputs_tests";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto path = dir / "movie.m64";
+
+    core_vcr_movie_header hdr{};
+    hdr.magic = 0x1a34364d;
+    hdr.version = 3;
+    hdr.length_samples = inputs.size();
+
+    std::vector<uint8_t> buf(sizeof(hdr) + sizeof(core_buttons) * inputs.size());
+    memcpy(buf.data(), &hdr, sizeof(hdr));
+    memcpy(buf.data() + sizeof(hdr), inputs.data(), sizeof(core_buttons) * inputs.size());
+    IOUtils::write_entire_file(path, buf);
+
+    return path;
+}
+
+/**
+ * \brief Creates inputs with distinct values.
+ */
+static std::vector<core_buttons> make_inputs(const size_t count)
+{
+    std::vector<core_buttons> inputs(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        inputs[i].value = static_cast<uint32_t>(i * 2654435761u);
+    }
+    return inputs;
+}
+
+/**
+ * \brief Gets whether two input sequences are equal.
+ */
+static bool inputs_equal(const std::span<const core_buttons> a, const std::span<const core_buttons> b)
+{
+    return std::ranges::equal(a, b, [](auto x, auto y) { return x.value == y.value; });
+}
+
+#pragma region Unit
+
+TEST_CASE("mapped_inputs_match_file", "t_movie_inputs")
+{
+    const auto expected = make_inputs(1000);
+    const auto path = write_movie_file(expected);
+
+    const auto inputs = t_movie_inputs::map(t_mapped_file::open(path), sizeof(core_vcr_movie_header), expected.size());
+
+    REQUIRE(inputs.is_mapped());
+    REQUIRE(inputs_equal(inputs, expected));
+}
+
+TEST_CASE("modification_copies_out_of_mapping", "t_movie_inputs")
+{
+    const auto expected = make_inputs(100);
+    const auto path = write_movie_file(expected);
+
+    auto inputs = t_movie_inputs::map(t_mapped_file::open(path), sizeof(core_vcr_movie_header), expected.size());
+    inputs.push_back({0xDEAD});
+
+    REQUIRE_FALSE(inputs.is_mapped());
+    REQUIRE(inputs.size() == expected.size() + 1);
+    REQUIRE(inputs_equal(std::span(inputs).first(expected.size()), expected));
+    REQUIRE(inputs.back().value == 0xDEAD);
+
+    // The copy doesn't depend on the file anymore.
+    std::filesystem::remove(path);
+    REQUIRE(inputs[99].value == expected[99].value);
+}
+
+TEST_CASE("empty_file_isnt_mapped", "t_mapped_file")
+{
+    const auto path = write_movie_file({});
+    IOUtils::write_entire_file(path, {});
+
+    REQUIRE(t_mapped_file::open(path) == nullptr);
+    REQUIRE(t_mapped_file::open(path.parent_path() / "missing.m64") == nullptr);
+}
+
+TEST_CASE("view_survives_external_truncation", "t_mapped_file")
+{
+    const auto expected = make_inputs(100);
+    const auto path = write_movie_file(expected);
+
+    const auto file = t_mapped_file::open(path);
+    const auto inputs = t_movie_inputs::map(file, sizeof(core_vcr_movie_header), expected.size());
+
+    // Truncation either fails while the file is mapped, or doesn't affect the copy.
+    std::error_code ec;
+    std::filesystem::resize_file(path, 0, ec);
+    if (!ec)
+    {
+        REQUIRE_FALSE(file->is_mapping());
+    }
+
+    REQUIRE(inputs_equal(inputs, expected));
+}
+
+TEST_CASE("stopping_playback_releases_inputs", "vcr_stop_all")
+{
+    const auto expected = make_inputs(100);
+    const auto path = write_movie_file(expected);
+    params.input_set_keys = [](int32_t, core_buttons) {};
+
+    const auto file = t_mapped_file::open(path);
+    vcr.inputs = t_movie_inputs::map(file, sizeof(core_vcr_movie_header), expected.size());
+    vcr.task = task_playback;
+
+    REQUIRE(vcr_stop_all() == Res_Ok);
+
+    REQUIRE(vcr.inputs.empty());
+    REQUIRE(file.use_count() == 1);
+}
+
+TEST_CASE("reads_inputs_from_file", "vcr_read_movie_inputs")
+{
+    const auto expected = make_inputs(100);
+    const auto path = write_movie_file(expected);
+
+    std::vector<core_buttons> inputs;
+    REQUIRE(vcr_read_movie_inputs(path, inputs) == Res_Ok);
+    REQUIRE(inputs_equal(inputs, expected));
+}
+
+#pragma endregion
+
+#pragma region Benchmark
+
+TEST_CASE("movie_load_throughput", "[.][benchmark]")
+{
+    // Roughly 4.5 hours of single-controller input.
+    const auto expected = make_inputs(1'000'000);
+    const auto path = write_movie_file(expected);
+
+    BENCHMARK("read_and_copy")
+    {
+        const auto buf = IOUtils::read_entire_file(path);
+        std::vector<core_buttons> inputs(expected.size());
+        memcpy(inputs.data(), buf.data() + sizeof(core_vcr_movie_header), sizeof(core_buttons) * inputs.size());
+        return inputs.size();
+    };
+
+    BENCHMARK("map")
+    {
+        const auto inputs =
+            t_movie_inputs::map(t_mapped_file::open(path), sizeof(core_vcr_movie_header), expected.size());
+        return inputs.size();
+    };
+}
+
+#pragma endregion
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/r4300/movie_writer.h>
+
+static std::filesystem::path movie_path;
+
+/**
+ * \brief Creates an empty directory for the movie file and returns the movie file's path.
+ */
+static std::filesystem::path prepare_test()
+{
+    const auto dir = std::filesystem::temp_directory_path() / "mupen64_movie_writer_tests";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    movie_path = dir / "movie.m64";
+    return movie_path;
+}
+
+/**
+ * \brief Creates a movie header for the specified inputs.
+ */
+static core_vcr_movie_header make_header(const std::vector<core_buttons> &inputs, const uint32_t rerecords = 0)
+{
+    core_vcr_movie_header hdr{};
+    hdr.length_samples = inputs.size();
+    hdr.rerecord_count = rerecords;
+    return hdr;
+}
+
+/**
+ * \brief Creates inputs with distinct values.
+ */
+static std::vector<core_buttons> make_inputs(const size_t count, const uint32_t seed = 0)
+{
+    std::vector<core_buttons> inputs(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        inputs[i].value = static_cast<uint32_t>(i * 2654435761u + seed);
+    }
+    return inputs;
+}
+
+/**
+ * \brief Gets the contents of a movie file as written by a full rewrite.
+ */
+static std::vector<uint8_t> expected_file(const core_vcr_movie_header &hdr, const std::vector<core_buttons> &inputs)
+{
+    std::vector<uint8_t> buf(sizeof(core_vcr_movie_header) + sizeof(core_buttons) * inputs.size());
+    memcpy(buf.data(), &hdr, sizeof(core_vcr_movie_header));
+    memcpy(buf.data() + sizeof(core_vcr_movie_header), inputs.data(), sizeof(core_buttons) * inputs.size());
+    return buf;
+}
+
+#pragma region Unit
+
+TEST_CASE("appended_samples_match_full_rewrite", "movie_writer_write")
+{
+    const auto path = prepare_test();
+    t_movie_writer writer{};
+
+    auto inputs = make_inputs(100);
+    REQUIRE(movie_writer_write(writer, path, make_header(inputs), inputs, false));
+
+    const auto more = make_inputs(50, 7);
+    inputs.insert(inputs.end(), more.begin(), more.end());
+    REQUIRE(movie_writer_write(writer, path, make_header(inputs, 1), inputs, false));
+
+    REQUIRE(IOUtils::read_entire_file(path) == expected_file(make_header(inputs, 1), inputs));
+}
+
+TEST_CASE("removed_samples_are_truncated", "movie_writer_write")
+{
+    const auto path = prepare_test();
+    t_movie_writer writer{};
+
+    auto inputs = make_inputs(100);
+    REQUIRE(movie_writer_write(writer, path, make_header(inputs), inputs, false));
+
+    inputs.resize(40);
+    REQUIRE(movie_writer_write(writer, path, make_header(inputs), inputs, true));
+
+    REQUIRE(IOUtils::read_entire_file(path) == expected_file(make_header(inputs), inputs));
+}
+
+TEST_CASE("invalidated_samples_are_rewritten", "movie_writer_invalidate")
+{
+    const auto path = prepare_test();
+    t_movie_writer writer{};
+
+    auto inputs = make_inputs(100);
+    REQUIRE(movie_writer_write(writer, path, make_header(inputs), inputs, false));
+
+    inputs[30].value = 0xDEAD;
+    inputs[31].value = 0xBEEF;
+    inputs.resize(60);
+    movie_writer_invalidate(writer, 30);
+    REQUIRE(movie_writer_write(writer, path, make_header(inputs), inputs, false));
+
+    REQUIRE(IOUtils::read_entire_file(path) == expected_file(make_header(inputs), inputs));
+}
+
+TEST_CASE("externally_modified_file_is_rewritten", "movie_writer_write")
+{
+    const auto path = prepare_test();
+    t_movie_writer writer{};
+
+    const auto inputs = make_inputs(100);
+    REQUIRE(movie_writer_write(writer, path, make_header(inputs), inputs, false));
+
+    std::vector<uint8_t> garbage(0x10, 0xAA);
+    IOUtils::write_entire_file(path, garbage);
+
+    REQUIRE(movie_writer_write(writer, path, make_header(inputs), inputs, false));
+    REQUIRE(IOUtils::read_entire_file(path) == expected_file(make_header(inputs), inputs));
+}
+
+TEST_CASE("other_path_is_rewritten", "movie_writer_write")
+{
+    const auto path = prepare_test();
+    t_movie_writer writer{};
+
+    const auto inputs = make_inputs(100);
+    REQUIRE(movie_writer_write(writer, path, make_header(inputs), inputs, false));
+
+    auto other_path = path;
+    other_path.replace_filename("other.m64");
+    REQUIRE(movie_writer_write(writer, other_path, make_header(inputs), inputs, false));
+
+    REQUIRE(IOUtils::read_entire_file(other_path) == expected_file(make_header(inputs), inputs));
+}
+
+#pragma endregion
+
+#pragma region Benchmark
+
+TEST_CASE("movie_flush_throughput", "[.][benchmark]")
+{
+    const auto path = prepare_test();
+
+    // Roughly 4.5 hours of single-controller input.
+    auto inputs = make_inputs(1'000'000);
+    const auto hdr = make_header(inputs);
+
+    BENCHMARK("full_rewrite")
+    {
+        return movie_write_full(path, hdr, inputs, false);
+    };
+
+    t_movie_writer writer{};
+    movie_writer_write(writer, path, hdr, inputs, false);
+
+    // A rerecord followed by a savestate save usually only replaces a few seconds of input.
+    BENCHMARK("incremental_rerecord_120_samples")
+    {
+        inputs.resize(inputs.size() - 120);
+        movie_writer_write(writer, path, make_header(inputs), inputs, false);
+        inputs.resize(inputs.size() + 120);
+        return movie_writer_write(writer, path, make_header(inputs), inputs, false);
+    };
+}
+
+#pragma endregion
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/memory/savedata.h>
+#include <Core/r4300/r4300.h>
+
+static core_cfg cfg{};
+static core_params params{};
+static core_ctx *ctx = nullptr;
+static std::filesystem::path saves_dir;
+static std::vector<std::string> dialogs;
+
+/**
+ * \brief Creates an empty saves directory and points the core at it.
+ */
+static void prepare_test()
+{
+    saves_dir = std::filesystem::temp_directory_path() / "mupen64_savedata_tests";
+    std::filesystem::remove_all(saves_dir);
+    std::filesystem::create_directories(saves_dir);
+
+    cfg = {};
+    params = {};
+    params.cfg = &cfg;
+    params.get_saves_directory = [] { return saves_dir; };
+    params.submit_task = [](const std::function<void()> &func) { std::thread(func).detach(); };
+    params.show_dialog = [](const char *str, const char *, core_dialog_type) { dialogs.emplace_back(str); };
+    dialogs.clear();
+    core_create(&params, &ctx);
+}
+
+#pragma region Integration
+
+TEST_CASE("missing_files_are_created_empty", "savedata_open")
+{
+    prepare_test();
+
+    REQUIRE(savedata_open());
+    REQUIRE(std::filesystem::exists(get_eeprom_path()));
+    REQUIRE(std::filesystem::file_size(get_mempak_path()) == 0);
+    savedata_close();
+}
+
+TEST_CASE("reads_past_end_leave_buffer_untouched", "savedata_read")
+{
+    prepare_test();
+
+    std::vector<uint8_t> existing(0x10, 0xAA);
+    IOUtils::write_entire_file(get_sram_path(), existing);
+    REQUIRE(savedata_open());
+
+    std::vector<uint8_t> buf(0x20, 0x55);
+    savedata_read(savedata_sram, buf.data(), buf.size());
+
+    REQUIRE(std::all_of(buf.begin(), buf.begin() + 0x10, [](auto b) { return b == 0xAA; }));
+    REQUIRE(std::all_of(buf.begin() + 0x10, buf.end(), [](auto b) { return b == 0x55; }));
+    savedata_close();
+}
+
+TEST_CASE("writes_reach_disk_on_close", "savedata_write")
+{
+    prepare_test();
+
+    std::vector<uint8_t> existing(0x1000, 0xAA);
+    IOUtils::write_entire_file(get_eeprom_path(), existing);
+    REQUIRE(savedata_open());
+
+    std::vector<uint8_t> buf(0x800, 0x11);
+    savedata_write(savedata_eeprom, buf.data(), buf.size());
+
+    // Nothing is written until a flush.
+    REQUIRE(IOUtils::read_entire_file(get_eeprom_path()) == existing);
+
+    savedata_close();
+
+    // Only the start of the file is overwritten, like with fwrite.
+    auto expected = existing;
+    std::fill_n(expected.begin(), 0x800, 0x11);
+    REQUIRE(IOUtils::read_entire_file(get_eeprom_path()) == expected);
+
+    auto tmp_path = get_eeprom_path();
+    tmp_path += ".tmp";
+    REQUIRE_FALSE(std::filesystem::exists(tmp_path));
+}
+
+TEST_CASE("unchanged_writes_dont_touch_disk", "savedata_write")
+{
+    prepare_test();
+
+    std::vector<uint8_t> existing(0x800, 0x22);
+    IOUtils::write_entire_file(get_eeprom_path(), existing);
+    REQUIRE(savedata_open());
+
+    const auto before = std::filesystem::last_write_time(get_eeprom_path());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    savedata_write(savedata_eeprom, existing.data(), existing.size());
+    savedata_close();
+
+    REQUIRE(std::filesystem::last_write_time(get_eeprom_path()) == before);
+}
+
+TEST_CASE("failed_write_is_retried_by_next_flush", "savedata_flush")
+{
+    prepare_test();
+
+    static std::vector<std::function<void()>> tasks;
+    tasks.clear();
+    params.submit_task = [](const std::function<void()> &func) { tasks.push_back(func); };
+    REQUIRE(savedata_open());
+
+    std::vector<uint8_t> buf(0x800, 0x11);
+    savedata_write(savedata_eeprom, buf.data(), buf.size());
+
+    // A directory in place of the temporary file makes the write fail.
+    auto tmp_path = get_eeprom_path();
+    tmp_path += ".tmp";
+    std::filesystem::create_directories(tmp_path);
+
+    savedata_flush();
+    std::exchange(tasks, {}).front()();
+    REQUIRE(dialogs.empty());
+
+    std::filesystem::remove(tmp_path);
+    savedata_flush();
+    REQUIRE(dialogs.size() == 1);
+
+    std::exchange(tasks, {}).front()();
+    REQUIRE(IOUtils::read_entire_file(get_eeprom_path()) == buf);
+
+    savedata_close();
+    REQUIRE(dialogs.size() == 1);
+}
+
+TEST_CASE("write_failing_on_close_is_reported", "savedata_close")
+{
+    prepare_test();
+    REQUIRE(savedata_open());
+
+    std::vector<uint8_t> buf(0x800, 0x11);
+    savedata_write(savedata_eeprom, buf.data(), buf.size());
+
+    auto tmp_path = get_eeprom_path();
+    tmp_path += ".tmp";
+    std::filesystem::create_directories(tmp_path);
+
+    savedata_close();
+
+    // One report for the first failure, and one for the data being lost after the retry failed too.
+    REQUIRE(dialogs.size() == 2);
+    REQUIRE(std::filesystem::file_size(get_eeprom_path()) == 0);
+}
+
+#pragma endregion
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/memory/flashram.h>
+#include <Core/memory/memory.h>
+#include <Core/memory/savestates.h>
+#include <Core/memory/tlb.h>
+#include <Core/r4300/interrupt.h>
+#include <Core/r4300/r4300.h>
+
+static core_cfg cfg{};
+static core_params params{};
+static core_ctx *ctx = nullptr;
+static precomp_instr pc_stub{};
+
+// The tasks submitted to the thread pool, which are run by the tests when they see fit.
+static std::vector<std::function<void()>> submitted_tasks;
+
+// The offset of RDRAM in a savestate buffer, which follows the rom hash and the memory-mapped registers.
+constexpr size_t RDRAM_OFFSET = 32 + sizeof(core_rdram_reg) + sizeof(core_mips_reg) + sizeof(core_pi_reg) +
+                                sizeof(core_sp_reg) + sizeof(core_rsp_reg) + sizeof(core_si_reg) +
+                                sizeof(core_vi_reg) + sizeof(core_ri_reg) + sizeof(core_ai_reg) +
+                                sizeof(core_dpc_reg) + sizeof(core_dps_reg);
+
+// The offset of the flashram info slot in a savestate buffer, which holds the version marker.
+constexpr size_t FLASHRAM_OFFSET = 32 + 0x8021F0 - 0x20;
+
+// The offset of the version in the version marker.
+constexpr size_t ST_VERSION_OFFSET = FLASHRAM_OFFSET + 4;
+
+// The amount of entries stored for each TLB LUT.
+constexpr uint32_t ST_TLB_LUT_ENTRIES = 0x100000 / sizeof(uint32_t);
+
+/**
+ * \brief Creates a core and puts the emulator state into a configuration which savestates can be generated from.
+ */
+static void prepare_test()
+{
+    cfg = {};
+    params.cfg = &cfg;
+    params.mge_available = [] { return false; };
+    params.get_saves_directory = [] { return std::filesystem::temp_directory_path(); };
+    params.submit_task = [](const std::function<void()> &func) { submitted_tasks.push_back(func); };
+    params.callbacks.save_state = [] {};
+    submitted_tasks.clear();
+    core_create(&params, &ctx);
+
+    interpcore = 1;
+    PC = &pc_stub;
+    memset(rdram, 0, sizeof(rdram));
+    memset(tlb_LUT_r, 0, sizeof(tlb_LUT_r));
+    memset(tlb_LUT_w, 0, sizeof(tlb_LUT_w));
+
+    const uint32_t events[] = {VI_INT, 0x5000, SI_INT, 0x6000, 0xFFFFFFFF};
+    load_eventqueue_infos((char *)events);
+}
+
+/**
+ * \brief Loads a savestate from memory on the calling thread.
+ * \return The result reported to the savestate callback.
+ */
+static core_result load_savestate(const std::vector<uint8_t> &st)
+{
+    core_result result = Res_Cancelled;
+    core_executing = true;
+    ctx->st_do_memory(st, core_st_job_load, [&](const core_st_callback_info &info, auto) { result = info.result; },
+                      true);
+    st_do_work();
+    core_executing = false;
+    return result;
+}
+
+/**
+ * \brief Saves and reloads the TLB LUTs through a savestate, then checks that they survived unchanged.
+ * \param set_entries Fills the LUTs with the entries under test.
+ */
+static void check_tlb_lut_round_trip(const std::function<void()> &set_entries)
+{
+    prepare_test();
+    set_entries();
+
+    const std::vector<uint32_t> expected_r(tlb_LUT_r, tlb_LUT_r + ST_TLB_LUT_ENTRIES);
+    const std::vector<uint32_t> expected_w(tlb_LUT_w, tlb_LUT_w + ST_TLB_LUT_ENTRIES);
+
+    std::vector<uint8_t> st;
+    generate_savestate(st, false);
+
+    memset(tlb_LUT_r, 0xCC, sizeof(tlb_LUT_r));
+    memset(tlb_LUT_w, 0xCC, sizeof(tlb_LUT_w));
+
+    REQUIRE(load_savestate(st) == Res_Ok);
+    REQUIRE(std::equal(expected_r.begin(), expected_r.end(), tlb_LUT_r));
+    REQUIRE(std::equal(expected_w.begin(), expected_w.end(), tlb_LUT_w));
+}
+
+/**
+ * \brief Runs the tasks submitted to the thread pool so far on the calling thread.
+ */
+static void run_submitted_tasks()
+{
+    const auto tasks = std::exchange(submitted_tasks, {});
+    for (const auto &task : tasks)
+    {
+        task();
+    }
+}
+
+/**
+ * \brief Enqueues a savestate save to a path.
+ * \param results Receives the results reported to the savestate callback.
+ */
+static void save_savestate(const std::filesystem::path &path, std::vector<core_result> &results)
+{
+    core_executing = true;
+    ctx->st_do_file(path, core_st_job_save,
+                    [&results](const core_st_callback_info &info, auto) { results.push_back(info.result); }, true);
+    core_executing = false;
+}
+
+#pragma region Unit
+
+TEST_CASE("incremental_savestate_matches_full_savestate", "generate_savestate")
+{
+    prepare_test();
+
+    std::vector<uint8_t> st;
+    generate_savestate(st, true);
+    REQUIRE(st.size() > RDRAM_OFFSET + 0x800000);
+
+    // A write through the memory handlers, and one which bypasses them as plugins do.
+    address = 0x80005000;
+    word = 0x12345678;
+    write_rdram();
+    rdram[0x7000 / 4] = 0x9ABCDEF0;
+
+    generate_savestate(st, true);
+
+    std::vector<uint8_t> full;
+    generate_savestate(full, false);
+    REQUIRE(std::equal(st.begin(), st.end(), full.begin(), full.end()));
+}
+
+TEST_CASE("incremental_savestate_clears_dirty_pages", "generate_savestate")
+{
+    prepare_test();
+
+    std::vector<uint8_t> st;
+    generate_savestate(st, true);
+
+    REQUIRE(std::none_of(std::begin(rdram_dirty_pages), std::end(rdram_dirty_pages), [](const uint8_t d) { return d; }));
+}
+
+TEST_CASE("marking_all_dirty_marks_every_page", "rdram_mark_all_dirty")
+{
+    prepare_test();
+
+    std::vector<uint8_t> st;
+    generate_savestate(st, true);
+    rdram_mark_all_dirty();
+
+    REQUIRE(std::all_of(std::begin(rdram_dirty_pages), std::end(rdram_dirty_pages), [](const uint8_t d) { return d; }));
+}
+
+TEST_CASE("empty_tlb_luts_round_trip", "generate_savestate")
+{
+    check_tlb_lut_round_trip([] {});
+}
+
+TEST_CASE("full_tlb_luts_round_trip", "generate_savestate")
+{
+    check_tlb_lut_round_trip([] {
+        for (uint32_t i = 0; i < ST_TLB_LUT_ENTRIES; ++i)
+        {
+            tlb_LUT_r[i] = 0x80000000 | (i << 12);
+            tlb_LUT_w[i] = ~i;
+        }
+    });
+}
+
+TEST_CASE("tlb_lut_boundary_entries_round_trip", "generate_savestate")
+{
+    check_tlb_lut_round_trip([] {
+        tlb_LUT_r[0] = 0x80001000;
+        tlb_LUT_r[ST_TLB_LUT_ENTRIES - 1] = 0x80002000;
+        tlb_LUT_w[0] = 0x80003000;
+        tlb_LUT_w[ST_TLB_LUT_ENTRIES - 1] = 0x80004000;
+    });
+}
+
+TEST_CASE("savestate_from_newer_version_is_rejected", "st_do_memory")
+{
+    prepare_test();
+
+    std::vector<uint8_t> st;
+    generate_savestate(st, false);
+
+    uint32_t version;
+    memcpy(&version, &st[ST_VERSION_OFFSET], sizeof(version));
+    ++version;
+    memcpy(&st[ST_VERSION_OFFSET], &version, sizeof(version));
+
+    REQUIRE(load_savestate(st) == ST_UnsupportedVersion);
+}
+
+TEST_CASE("version_marker_fails_legacy_flashram_check", "generate_savestate")
+{
+    prepare_test();
+
+    std::vector<uint8_t> st;
+    generate_savestate(st, false);
+
+    // Versions without the marker validate the flashram info at its old offset before reading the TLB LUTs.
+    REQUIRE_FALSE(check_flashram_infos(&st[FLASHRAM_OFFSET]));
+}
+
+TEST_CASE("path_save_callbacks_run_after_write", "st_do_file")
+{
+    prepare_test();
+
+    const auto path = std::filesystem::temp_directory_path() / "savestates_tests_callbacks.st";
+    std::filesystem::remove(path);
+
+    static std::vector<std::string> events;
+    events.clear();
+    params.callbacks.save_state = [] { events.emplace_back("save_state"); };
+
+    core_executing = true;
+    ctx->st_do_file(path, core_st_job_save,
+                    [&](const core_st_callback_info &info, auto) {
+                        REQUIRE(info.result == Res_Ok);
+                        REQUIRE(std::filesystem::exists(path));
+                        events.emplace_back("callback");
+                    },
+                    true);
+    core_executing = false;
+    st_do_work();
+    REQUIRE(events.empty());
+
+    run_submitted_tasks();
+    REQUIRE(events.empty());
+
+    st_do_work();
+    REQUIRE(events == std::vector<std::string>{"callback", "save_state"});
+
+    st_on_core_stop();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("failed_write_is_reported_once", "st_do_file")
+{
+    prepare_test();
+
+    const auto path = std::filesystem::temp_directory_path() / "savestates_tests_missing" / "failed.st";
+    std::filesystem::remove_all(path.parent_path());
+
+    std::vector<core_result> results;
+    save_savestate(path, results);
+    st_do_work();
+    run_submitted_tasks();
+    REQUIRE(results.empty());
+
+    st_do_work();
+    REQUIRE(results == std::vector{ST_FileWriteError});
+
+    st_on_core_stop();
+    REQUIRE(results == std::vector{ST_FileWriteError});
+}
+
+TEST_CASE("pending_writes_apply_back_pressure", "st_do_file")
+{
+    prepare_test();
+
+    const auto dir = std::filesystem::temp_directory_path() / "savestates_tests_pressure";
+    std::filesystem::create_directories(dir);
+
+    std::vector<core_result> results;
+    for (size_t i = 0; i < MAX_PENDING_WRITES; ++i)
+    {
+        save_savestate(dir / std::format("{}.st", i), results);
+    }
+    st_do_work();
+    REQUIRE(results.empty());
+
+    save_savestate(dir / "blocked.st", results);
+    std::atomic_bool finished = false;
+    std::thread emu_thread([&] {
+        st_do_work();
+        finished = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    REQUIRE_FALSE(finished);
+
+    // The worker frees a slot with its first write, which unblocks the save, and then drains the rest of the queue.
+    run_submitted_tasks();
+    emu_thread.join();
+
+    // The blocked save's write is queued to a new worker.
+    run_submitted_tasks();
+    st_do_work();
+
+    REQUIRE(results.size() == MAX_PENDING_WRITES + 1);
+    REQUIRE(std::ranges::all_of(results, [](const core_result result) { return result == Res_Ok; }));
+    REQUIRE(std::filesystem::exists(dir / "blocked.st"));
+
+    st_on_core_stop();
+    std::filesystem::remove_all(dir);
+}
+
+#pragma endregion
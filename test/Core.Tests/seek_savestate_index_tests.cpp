@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/r4300/seek_savestate_index.h>
+
+/**
+ * \brief Creates an index with empty savestates at the specified frames, inserted in order.
+ */
+static t_seek_savestate_index make_index(const std::vector<size_t> &frames)
+{
+    t_seek_savestate_index index;
+    for (const auto frame : frames)
+    {
+        index.insert(frame, {});
+    }
+    return index;
+}
+
+/**
+ * \brief Gets the frames of the savestates in an index.
+ */
+static std::vector<size_t> frames_of(const std::span<const t_seek_savestate> sts)
+{
+    std::vector<size_t> frames;
+    for (const auto &st : sts)
+    {
+        frames.push_back(st.frame);
+    }
+    return frames;
+}
+
+#pragma region Unit
+
+TEST_CASE("savestates_are_ordered_by_frame", "insert")
+{
+    auto index = make_index({30, 10, 20});
+    index.insert(20, {1, 2, 3});
+
+    REQUIRE(frames_of({index.begin(), index.end()}) == std::vector<size_t>{10, 20, 30});
+    REQUIRE(index.find(20)->data == std::vector<uint8_t>{1, 2, 3});
+    REQUIRE(index.find(25) == nullptr);
+}
+
+TEST_CASE("finds_closest_savestate_before_frame", "find_before")
+{
+    const auto index = make_index({0, 10, 20});
+
+    REQUIRE(index.find_before(0) == nullptr);
+    REQUIRE(index.find_before(10)->frame == 0);
+    REQUIRE(index.find_before(11)->frame == 10);
+    REQUIRE(index.find_before(SIZE_MAX)->frame == 20);
+}
+
+TEST_CASE("range_is_half_open", "range")
+{
+    const auto index = make_index({0, 10, 20, 30});
+
+    REQUIRE(frames_of(index.range(10, 30)) == std::vector<size_t>{10, 20});
+    REQUIRE(index.range(11, 20).empty());
+    REQUIRE(index.range(30, 10).empty());
+}
+
+TEST_CASE("erase_range_returns_erased_frames", "erase_range")
+{
+    auto index = make_index({0, 10, 20, 30});
+
+    REQUIRE(index.erase_range(15, SIZE_MAX) == std::vector<size_t>{20, 30});
+    REQUIRE(frames_of({index.begin(), index.end()}) == std::vector<size_t>{0, 10});
+}
+
+TEST_CASE("oldest_policy_keeps_frame_zero", "pick_eviction")
+{
+    REQUIRE(make_index({0, 10, 20}).pick_eviction(core_seek_savestate_eviction_oldest, 30) == 10);
+    REQUIRE(make_index({5, 10, 20}).pick_eviction(core_seek_savestate_eviction_oldest, 30) == 5);
+    REQUIRE(make_index({0}).pick_eviction(core_seek_savestate_eviction_oldest, 30) == std::nullopt);
+}
+
+TEST_CASE("lru_policy_evicts_least_recently_used", "pick_eviction")
+{
+    auto index = make_index({0, 10, 20, 30});
+    index.touch(10);
+
+    REQUIRE(index.pick_eviction(core_seek_savestate_eviction_lru, 40) == 20);
+}
+
+TEST_CASE("thinning_policy_spaces_savestates_exponentially", "pick_eviction")
+{
+    constexpr size_t max_count = 16;
+    constexpr size_t interval = 10;
+
+    t_seek_savestate_index index;
+    size_t frame = 0;
+    for (; frame < 100000; frame += interval)
+    {
+        if (index.size() > max_count)
+        {
+            index.erase(*index.pick_eviction(core_seek_savestate_eviction_thinning, frame));
+        }
+        index.insert(frame, {});
+    }
+
+    // The start stays reachable and recent frames stay densely covered.
+    REQUIRE(index.find(0));
+    REQUIRE(index.find_before(frame)->frame == frame - interval);
+    REQUIRE(index.range(frame - 10 * interval, frame).size() >= 4);
+
+    // Gaps grow towards the start, so the far half of the movie is still covered.
+    REQUIRE(index.range(1, frame / 2).size() >= 1);
+    for (auto it = std::next(index.begin()); std::next(it) != index.end(); ++it)
+    {
+        REQUIRE(std::next(it)->frame - it->frame <= frame - it->frame);
+    }
+}
+
+#pragma endregion
+
+#pragma region Benchmark
+
+TEST_CASE("closest_savestate_lookup_throughput", "[.][benchmark]")
+{
+    std::vector<size_t> frames;
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        frames.push_back(i * 60);
+    }
+
+    const auto index = make_index(frames);
+
+    std::unordered_map<size_t, std::vector<uint8_t>> map;
+    for (const auto frame : frames)
+    {
+        map[frame] = {};
+    }
+
+    // Seek targets spread over the movie.
+    BENCHMARK("unordered_map_scan")
+    {
+        size_t sum = 0;
+        for (size_t target = 1; target < 300000; target += 3001)
+        {
+            size_t closest = 0;
+            for (const auto &[frame, _] : map)
+            {
+                if (frame < target && target - frame < target - closest)
+                {
+                    closest = frame;
+                }
+            }
+            sum += closest;
+        }
+        return sum;
+    };
+
+    BENCHMARK("index_find_before")
+    {
+        size_t sum = 0;
+        for (size_t target = 1; target < 300000; target += 3001)
+        {
+            sum += index.find_before(target)->frame;
+        }
+        return sum;
+    };
+}
+
+#pragma endregion
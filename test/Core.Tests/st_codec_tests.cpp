@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/memory/st_codec.h>
+
+/**
+ * \brief Creates a buffer resembling a savestate: mostly zeroed memory with some regions of repetitive and noisy data.
+ */
+static std::vector<uint8_t> make_savestate_like_buffer(const size_t size)
+{
+    std::vector<uint8_t> buf(size);
+    uint32_t state = 0x12345678;
+    for (size_t i = 0; i < size / 2; ++i)
+    {
+        if ((i >> 12) % 4 == 0)
+        {
+            state = state * 1664525 + 1013904223;
+            buf[i] = static_cast<uint8_t>(state >> 24);
+        }
+        else if ((i >> 12) % 4 == 1)
+        {
+            buf[i] = static_cast<uint8_t>(i & 0x3F);
+        }
+    }
+    return buf;
+}
+
+static const core_st_codec codecs[] = {core_st_codec_store, core_st_codec_lz4, core_st_codec_zstd, core_st_codec_gzip};
+
+#pragma region Unit
+
+TEST_CASE("codecs_roundtrip", "st_codec_compress")
+{
+    const auto st = make_savestate_like_buffer(0x100000);
+
+    for (const auto codec : codecs)
+    {
+        const auto compressed = st_codec_compress(st, codec);
+        REQUIRE(!compressed.empty());
+        REQUIRE(st_codec_decompress(compressed) == st);
+    }
+}
+
+TEST_CASE("gzip_is_headerless", "st_codec_compress")
+{
+    const auto st = make_savestate_like_buffer(0x10000);
+
+    const auto compressed = st_codec_compress(st, core_st_codec_gzip);
+    REQUIRE(compressed[0] == 0x1F);
+    REQUIRE(compressed[1] == 0x8B);
+
+    // Legacy loaders must still be able to read it
+    REQUIRE(MiscHelpers::auto_decompress(compressed, 0x1000) == st);
+}
+
+TEST_CASE("corrupted_buffer_fails", "st_codec_decompress")
+{
+    const auto st = make_savestate_like_buffer(0x10000);
+
+    for (const auto codec : {core_st_codec_lz4, core_st_codec_zstd})
+    {
+        auto compressed = st_codec_compress(st, codec);
+        compressed.resize(compressed.size() / 2);
+        REQUIRE(st_codec_decompress(compressed).empty());
+    }
+}
+
+#pragma endregion
+
+#pragma region Benchmark
+
+TEST_CASE("codec_save_load_latency", "[.][benchmark]")
+{
+    const auto st = make_savestate_like_buffer(0xB624F0);
+
+    for (const auto codec : codecs)
+    {
+        const auto compressed = st_codec_compress(st, codec);
+        WARN(std::format("codec {}: {} -> {} bytes", (int32_t)codec, st.size(), compressed.size()));
+
+        BENCHMARK(std::format("compress_{}", (int32_t)codec))
+        {
+            return st_codec_compress(st, codec);
+        };
+        BENCHMARK(std::format("decompress_{}", (int32_t)codec))
+        {
+            return st_codec_decompress(compressed);
+        };
+    }
+}
+
+#pragma endregion
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/memory/st_delta.h>
+
+/**
+ * \brief Creates a buffer of the specified size filled with a deterministic pattern.
+ */
+static std::vector<uint8_t> make_buffer(const size_t size, const uint8_t seed)
+{
+    std::vector<uint8_t> buf(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        buf[i] = static_cast<uint8_t>(i * 31 + seed);
+    }
+    return buf;
+}
+
+#pragma region Unit
+
+TEST_CASE("identical_buffers_produce_empty_delta", "st_delta_encode")
+{
+    const auto base = make_buffer(ST_DELTA_PAGE_SIZE * 8, 1);
+
+    const auto delta = st_delta_encode(base, base);
+
+    // magic + size + terminator
+    REQUIRE(delta.size() == 16);
+
+    std::vector<uint8_t> out;
+    REQUIRE(st_delta_decode(base, delta, out));
+    REQUIRE(out == base);
+}
+
+TEST_CASE("sparse_changes_roundtrip", "st_delta_encode")
+{
+    const auto base = make_buffer(ST_DELTA_PAGE_SIZE * 8, 1);
+    auto st = base;
+    st[0] ^= 0xFF;
+    st[ST_DELTA_PAGE_SIZE * 3 + 17] ^= 0x0F;
+    st[ST_DELTA_PAGE_SIZE * 3 + 19] ^= 0x0F;
+    st[st.size() - 1] ^= 0x01;
+
+    const auto delta = st_delta_encode(base, st);
+    REQUIRE(delta.size() < ST_DELTA_PAGE_SIZE);
+
+    std::vector<uint8_t> out;
+    REQUIRE(st_delta_decode(base, delta, out));
+    REQUIRE(out == st);
+}
+
+TEST_CASE("size_differences_roundtrip", "st_delta_encode")
+{
+    const auto base = make_buffer(ST_DELTA_PAGE_SIZE * 4 + 123, 1);
+
+    std::vector<uint8_t> out;
+
+    auto larger = make_buffer(ST_DELTA_PAGE_SIZE * 6 + 7, 1);
+    REQUIRE(st_delta_decode(base, st_delta_encode(base, larger), out));
+    REQUIRE(out == larger);
+
+    auto smaller = make_buffer(ST_DELTA_PAGE_SIZE + 5, 2);
+    REQUIRE(st_delta_decode(base, st_delta_encode(base, smaller), out));
+    REQUIRE(out == smaller);
+
+    REQUIRE(st_delta_decode({}, st_delta_encode({}, larger), out));
+    REQUIRE(out == larger);
+}
+
+TEST_CASE("truncated_delta_fails", "st_delta_decode")
+{
+    const auto base = make_buffer(ST_DELTA_PAGE_SIZE * 2, 1);
+    const auto st = make_buffer(ST_DELTA_PAGE_SIZE * 2, 2);
+
+    auto delta = st_delta_encode(base, st);
+    delta.resize(delta.size() / 2);
+
+    std::vector<uint8_t> out;
+    REQUIRE(!st_delta_decode(base, delta, out));
+}
+
+#pragma endregion
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/memory/memory.h>
+#include <Core/memory/st_hash.h>
+#include <Core/r4300/interrupt.h>
+#include <Core/r4300/r4300.h>
+
+/**
+ * \brief Puts the emulator state into a known configuration.
+ */
+static void prepare_state()
+{
+    memset(rdram, 0, sizeof(rdram));
+    memset(reg, 0, sizeof(reg));
+    memset(reg_cop0, 0, sizeof(reg_cop0));
+    memset(reg_cop1_fgr_64, 0, sizeof(reg_cop1_fgr_64));
+    memset(SP_DMEM, 0, sizeof(SP_DMEM));
+    vi_register = {};
+
+    const uint32_t events[] = {VI_INT, 0x5000, SI_INT, 0x6000, 0xFFFFFFFF};
+    load_eventqueue_infos((char *)events);
+}
+
+#pragma region Unit
+
+TEST_CASE("equal_states_produce_equal_hashes", "st_hash")
+{
+    prepare_state();
+    const auto first = st_hash(core_st_hash_all);
+
+    prepare_state();
+    REQUIRE(st_hash(core_st_hash_all) == first);
+}
+
+TEST_CASE("changes_only_affect_their_region", "st_hash")
+{
+    struct t_case
+    {
+        core_st_hash_region region;
+        std::function<void()> mutate;
+    };
+
+    const t_case cases[] = {
+        {core_st_hash_rdram, [] { rdram[0x1234] = 1; }},
+        {core_st_hash_cpu, [] { reg[4] = 1; }},
+        {core_st_hash_cop0, [] { reg_cop0[12] = 1; }},
+        {core_st_hash_cop1, [] { reg_cop1_fgr_64[3] = 1; }},
+        {core_st_hash_rsp, [] { SP_IMEM[0x10] = 1; }},
+        {core_st_hash_mmio, [] { vi_register.vi_origin = 1; }},
+        {core_st_hash_events, [] { add_interrupt_event_count(PI_INT, 0x5800); }},
+    };
+
+    for (const auto &[region, mutate] : cases)
+    {
+        prepare_state();
+        const auto before = st_hash(core_st_hash_all);
+        const auto before_region = st_hash(region);
+        const auto before_others = st_hash(core_st_hash_all & ~region);
+
+        mutate();
+
+        CHECK(st_hash(core_st_hash_all) != before);
+        CHECK(st_hash(region) != before_region);
+        CHECK(st_hash(core_st_hash_all & ~region) == before_others);
+    }
+}
+
+#pragma endregion
+
+#pragma region Benchmark
+
+TEST_CASE("st_hash_throughput", "[.][benchmark]")
+{
+    prepare_state();
+
+    BENCHMARK("all")
+    {
+        return st_hash(core_st_hash_all);
+    };
+
+    BENCHMARK("all_but_rdram")
+    {
+        return st_hash(core_st_hash_all & ~core_st_hash_rdram);
+    };
+}
+
+#pragma endregion
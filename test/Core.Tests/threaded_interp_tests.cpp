@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/memory/memory.h>
+#include <Core/r4300/macros.h>
+#include <Core/r4300/r4300.h>
+#include <Core/r4300/recomp.h>
+
+static core_cfg cfg{};
+static core_params params{};
+static core_ctx *ctx = nullptr;
+
+// The pages holding the code under test, the page which stops execution when jumped to, and the page loads and stores
+// go to.
+constexpr uint32_t PAGE_A = 0x80001000;
+constexpr uint32_t PAGE_B = 0x80002000;
+constexpr uint32_t STOP_ADDR = 0x80003000;
+constexpr uint32_t DATA_PAGE = 0x80004000;
+
+// The register holding DATA_PAGE, which the generated code never writes to.
+constexpr uint32_t DATA_BASE_REG = 26;
+
+/// The state compared between the cached and the threaded interpreter after running the same code.
+struct t_state
+{
+    std::array<int64_t, 32> regs;
+    int64_t hi;
+    int64_t lo;
+    uint32_t count;
+    std::vector<uint32_t> memory;
+
+    bool operator==(const t_state &) const = default;
+};
+
+// The registers and RDRAM every run starts with.
+static std::array<int64_t, 32> initial_regs;
+static std::vector<uint32_t> initial_rdram;
+
+static uint32_t r_type(const uint32_t funct, const uint32_t rd, const uint32_t rs, const uint32_t rt,
+                       const uint32_t sa = 0)
+{
+    return rs << 21 | rt << 16 | rd << 11 | sa << 6 | funct;
+}
+
+static uint32_t i_type(const uint32_t op, const uint32_t rt, const uint32_t rs, const uint16_t imm)
+{
+    return op << 26 | rs << 21 | rt << 16 | imm;
+}
+
+static uint32_t lui(const uint32_t rt, const uint16_t imm)
+{
+    return i_type(0x0F, rt, 0, imm);
+}
+
+static uint32_t addiu(const uint32_t rt, const uint32_t rs, const uint16_t imm)
+{
+    return i_type(0x09, rt, rs, imm);
+}
+
+static uint32_t ori(const uint32_t rt, const uint32_t rs, const uint16_t imm)
+{
+    return i_type(0x0D, rt, rs, imm);
+}
+
+static uint32_t j(const uint32_t target)
+{
+    return 0x02 << 26 | (target >> 2 & 0x3FFFFFF);
+}
+
+/**
+ * \brief Writes code or data to RDRAM at a KSEG0 address.
+ */
+static void write_words(const uint32_t addr, const std::vector<uint32_t> &words)
+{
+    std::ranges::copy(words, rdram + (addr & 0x7FFFFF) / 4);
+}
+
+/**
+ * \brief Stops the interpreter, standing in for an instruction whose handler the threaded interpreter doesn't know.
+ */
+static void stop_op()
+{
+    stop = 1;
+    PC++;
+}
+
+/**
+ * \brief Maps RDRAM into the KSEG0 and KSEG1 regions of the handler tables and seeds the registers.
+ */
+static void prepare_test()
+{
+    cfg = {};
+    params.cfg = &cfg;
+    core_create(&params, &ctx);
+
+    memset(rdram, 0, sizeof(rdram));
+    for (int32_t i = 0; i < 0x80; i++)
+    {
+        for (const auto base : {0x8000, 0xa000})
+        {
+            readmem[base + i] = read_rdram;
+            readmemb[base + i] = read_rdramb;
+            readmemh[base + i] = read_rdramh;
+            readmemd[base + i] = read_rdramd;
+            writemem[base + i] = write_rdram;
+            writememb[base + i] = write_rdramb;
+            writememh[base + i] = write_rdramh;
+            writememd[base + i] = write_rdramd;
+        }
+    }
+
+    std::mt19937_64 rng(42);
+    for (auto &r : initial_regs)
+    {
+        r = (int64_t)rng();
+    }
+    initial_regs[0] = 0;
+    initial_regs[DATA_BASE_REG] = (int32_t)DATA_PAGE;
+
+    // The stop page ends every run, which jumps to it with its delay slot.
+    write_words(STOP_ADDR, {0});
+}
+
+/**
+ * \brief Runs the code in RDRAM from an address until it jumps to STOP_ADDR.
+ * \param interpreter The interpreter loop to run the code with.
+ * \param entry The address to start at.
+ * \return The state after running.
+ */
+static t_state run(void (*interpreter)(), const uint32_t entry)
+{
+    std::ranges::copy(initial_regs, reg);
+    hi = 0x0123456789ABCDEF;
+    lo = -1;
+    initial_rdram.assign(rdram, rdram + 0x5000 / 4);
+
+    interpcore = 0;
+    dynacore = 0;
+    stop = 0;
+    skip_jump = 0;
+    delay_slot = 0;
+    core_Count = 0;
+    next_interrupt = UINT32_MAX;
+
+    init_blocks();
+    jump_to(STOP_ADDR);
+    PC->ops = stop_op;
+    jump_to(entry);
+    last_addr = PC->addr;
+
+    interpreter();
+
+    t_state state{
+        .hi = hi,
+        .lo = lo,
+        .count = core_Count,
+        .memory = std::vector(rdram, rdram + 0x5000 / 4),
+    };
+    std::copy_n(reg, 32, state.regs.begin());
+
+    // Leave RDRAM as it was for the next run.
+    std::ranges::copy(initial_rdram, rdram);
+    return state;
+}
+
+/**
+ * \brief Runs the code in RDRAM through the cached and the threaded interpreter and checks that both end up in the same
+ * state.
+ * \param entry The address to start at.
+ * \return The state after running, with the threaded interpreter's blocks still alive until the next run.
+ */
+static t_state run_both(const uint32_t entry)
+{
+    const auto expected = run(cached_interpreter, entry);
+    free_blocks();
+
+    const auto actual = run(threaded_interpreter, entry);
+    REQUIRE(actual.regs == expected.regs);
+    REQUIRE(actual.hi == expected.hi);
+    REQUIRE(actual.lo == expected.lo);
+    REQUIRE(actual.count == expected.count);
+    REQUIRE(actual.memory == expected.memory);
+    return actual;
+}
+
+/**
+ * \brief Gets the threaded instruction shadowing an address.
+ */
+static const threaded_instr &threaded_at(const uint32_t addr)
+{
+    const precomp_block *block = blocks[addr >> 12];
+    REQUIRE(block);
+    REQUIRE(block->threaded);
+    return block->threaded[(addr & 0xFFF) / 4];
+}
+
+#pragma region Unit
+
+TEST_CASE("random_integer_code_matches_cached_interpreter", "threaded_interpreter")
+{
+    prepare_test();
+
+    // Native ops, fused pairs, and fallbacks for multiplications and memory accesses, in random order.
+    constexpr uint32_t r_functs[] = {0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x10, 0x11, 0x12, 0x13, 0x14, 0x16,
+                                     0x17, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x2A, 0x2B, 0x2C,
+                                     0x2D, 0x2E, 0x2F, 0x38, 0x3A, 0x3B, 0x3C, 0x3E, 0x3F, 0x18, 0x19, 0x1C};
+    constexpr uint32_t i_ops[] = {0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+
+    std::mt19937 rng(1234);
+    const auto random_reg = [&] { return (uint32_t)rng() % 32; };
+    const auto random_dst = [&] {
+        uint32_t r;
+        do
+        {
+            r = random_reg();
+        }
+        while (r == DATA_BASE_REG);
+        return r;
+    };
+
+    std::vector<uint32_t> code;
+    while (code.size() < 800)
+    {
+        switch (rng() % 5)
+        {
+        case 0:
+        case 1:
+            code.push_back(r_type(r_functs[rng() % std::size(r_functs)], random_dst(), random_reg(), random_reg(),
+                                  rng() % 32));
+            break;
+        case 2:
+            code.push_back(i_type(i_ops[rng() % std::size(i_ops)], random_dst(), random_reg(), (uint16_t)rng()));
+            break;
+        case 3: {
+            const uint32_t rt = random_dst();
+            code.push_back(lui(rt, (uint16_t)rng()));
+            const uint32_t second = random_dst();
+            code.push_back(rng() % 2 ? addiu(second, rt, (uint16_t)rng()) : ori(second, rt, (uint16_t)rng()));
+            break;
+        }
+        case 4: {
+            // LW, SW, LD and SD relative to the data page.
+            constexpr uint32_t mem_ops[] = {0x23, 0x2B, 0x37, 0x3F};
+            const uint32_t op = mem_ops[rng() % std::size(mem_ops)];
+            const uint16_t offset = (uint16_t)(rng() % 0x1000 & ~7u);
+            code.push_back(i_type(op, op == 0x23 || op == 0x37 ? random_dst() : random_reg(), DATA_BASE_REG, offset));
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    code.push_back(j(STOP_ADDR));
+    code.push_back(0);
+    write_words(PAGE_A, code);
+
+    std::vector<uint32_t> data(0x400);
+    std::ranges::generate(data, rng);
+    write_words(DATA_PAGE, data);
+
+    run_both(PAGE_A);
+    free_blocks();
+}
+
+TEST_CASE("lui_pairs_are_fused", "threaded_interpreter")
+{
+    prepare_test();
+
+    // The first pass fuses the pairs, and the second one branches into the first pair's second half.
+    write_words(PAGE_A, {
+                            0,
+                            lui(8, 0x8765),
+                            addiu(8, 8, 0x4321),
+                            lui(9, 0x1234),
+                            ori(9, 9, 0xFFFF),
+                            lui(10, 0x7FFF),
+                            addiu(11, 10, 0x8000),
+                            lui(12, 0x0001),
+                            addiu(13, 14, 0x0001),
+                            addiu(15, 15, 1),
+                            i_type(0x0A, 16, 15, 2),
+                            i_type(0x05, 0, 16, (uint16_t)(2 - 12)),
+                            0,
+                            j(STOP_ADDR),
+                            0,
+                        });
+    initial_regs[15] = 0;
+
+    const auto state = run_both(PAGE_A);
+    REQUIRE(state.regs[8] == (int64_t)(int32_t)0x87654321 + 0x4321);
+    REQUIRE(state.regs[9] == 0x1234FFFF);
+    REQUIRE(state.regs[10] == 0x7FFF0000);
+    REQUIRE(state.regs[11] == 0x7FFE8000);
+    REQUIRE(state.regs[15] == 2);
+
+    REQUIRE(threaded_at(PAGE_A + 0x04).op == TI_LUI_ADDIU);
+    REQUIRE(threaded_at(PAGE_A + 0x08).op == TI_ADDIU);
+    REQUIRE(threaded_at(PAGE_A + 0x0C).op == TI_LUI_ORI);
+    REQUIRE(threaded_at(PAGE_A + 0x14).op == TI_LUI_ADDIU);
+    REQUIRE(threaded_at(PAGE_A + 0x1C).op == TI_LUI);
+    REQUIRE(threaded_at(PAGE_A + 0x20).op == TI_ADDIU);
+    free_blocks();
+}
+
+TEST_CASE("lui_pair_across_page_boundary_isnt_fused", "threaded_interpreter")
+{
+    prepare_test();
+
+    write_words(PAGE_B - 8, {
+                                0,
+                                lui(8, 0x1234),
+                                addiu(8, 8, 0x5678),
+                                j(STOP_ADDR),
+                                0,
+                            });
+
+    const auto state = run_both(PAGE_B - 8);
+    REQUIRE(state.regs[8] == 0x12345678);
+    REQUIRE(threaded_at(PAGE_B - 4).op == TI_LUI);
+    free_blocks();
+}
+
+TEST_CASE("self_modifying_code_retranslates_fused_pair", "threaded_interpreter")
+{
+    prepare_test();
+
+    // Page A accumulates a constant built by a fused pair into t2. Page B patches the pair's ADDIU on its first visit
+    // and jumps back, which recompiles page A, and stops on its second.
+    const uint32_t patched = addiu(8, 8, 0x0100);
+    write_words(PAGE_A, {
+                            0,
+                            lui(8, 0x1234),
+                            addiu(8, 8, 0x0001),
+                            r_type(0x21, 10, 10, 8),
+                            j(PAGE_B),
+                            0,
+                        });
+    write_words(PAGE_B, {
+                            i_type(0x05, 0, 11, 8),
+                            0,
+                            addiu(11, 0, 1),
+                            lui(12, patched >> 16),
+                            ori(12, 12, patched & 0xFFFF),
+                            lui(13, 0x8000),
+                            i_type(0x2B, 12, 13, (PAGE_A + 8) & 0xFFFF),
+                            j(PAGE_A),
+                            0,
+                            j(STOP_ADDR),
+                            0,
+                        });
+    initial_regs[10] = 0;
+    initial_regs[11] = 0;
+
+    const auto state = run_both(PAGE_A);
+    REQUIRE(state.regs[10] == 0x12340001 + 0x12340100);
+    REQUIRE(state.memory[(PAGE_A & 0xFFFF) / 4 + 2] == patched);
+    REQUIRE(threaded_at(PAGE_A + 4).op == TI_LUI_ADDIU);
+    REQUIRE(threaded_at(PAGE_A + 8).imm == 0x0100);
+    free_blocks();
+}
+
+TEST_CASE("unknown_ops_fall_back_to_cached_handlers", "threaded_interpreter")
+{
+    prepare_test();
+
+    // MULT and LW have no native translation, and neither has the stop handler swapped into its precomp_instr.
+    write_words(PAGE_A, {
+                            0,
+                            r_type(0x21, 8, 9, 10),
+                            r_type(0x18, 0, 8, 11),
+                            r_type(0x12, 12, 0, 0),
+                            i_type(0x23, 13, DATA_BASE_REG, 0x10),
+                            r_type(0x21, 14, 13, 12),
+                            j(STOP_ADDR),
+                            0,
+                        });
+    write_words(DATA_PAGE + 0x10, {0xDEADBEEF});
+
+    const auto state = run_both(PAGE_A);
+    REQUIRE(state.regs[13] == (int64_t)(int32_t)0xDEADBEEF);
+
+    REQUIRE(threaded_at(PAGE_A + 0x04).op == TI_ADDU);
+    REQUIRE(threaded_at(PAGE_A + 0x08).op == TI_FALLBACK);
+    REQUIRE(threaded_at(PAGE_A + 0x0C).op == TI_MFLO);
+    REQUIRE(threaded_at(PAGE_A + 0x10).op == TI_FALLBACK);
+    REQUIRE(threaded_at(PAGE_A + 0x14).op == TI_ADDU);
+    REQUIRE(threaded_at(STOP_ADDR).op == TI_FALLBACK);
+    free_blocks();
+}
+
+#pragma endregion
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/include/core_trace.h>
+#include <Core/r4300/r4300.h>
+#include <Core/r4300/tracelog.h>
+
+static core_cfg cfg{};
+static core_params params{};
+static core_ctx *ctx = nullptr;
+static std::filesystem::path trace_path;
+
+/**
+ * \brief Creates an empty directory for the trace file and prepares a core which runs the trace writer.
+ */
+static void prepare_test()
+{
+    const auto dir = std::filesystem::temp_directory_path() / "mupen64_tracelog_tests";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    trace_path = dir / "trace.bin";
+
+    params.cfg = &cfg;
+    params.submit_task = [](const std::function<void()> &func) { std::thread(func).detach(); };
+    params.log_error = [](std::string_view) {};
+    core_create(&params, &ctx);
+    tl_set_filter({});
+
+    // Keeps tl_start from recompiling, as no rom is loaded.
+    interpcore = 1;
+    vr_op = 0;
+}
+
+/**
+ * \brief Reads all records of the trace file.
+ */
+static std::vector<core_trace_record> read_records()
+{
+    core_trace_reader reader;
+    REQUIRE(reader.open(trace_path) == Res_Ok);
+
+    std::vector<core_trace_record> all;
+    std::vector<core_trace_record> records;
+    for (size_t i = 0; i < reader.chunks().size(); ++i)
+    {
+        REQUIRE(reader.read_chunk(i, records) == Res_Ok);
+        all.insert(all.end(), records.begin(), records.end());
+    }
+    return all;
+}
+
+/**
+ * \brief Logs instructions at consecutive addresses as the pure interpreter would.
+ */
+static void log_instructions(const uint32_t start, const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        interp_addr = start + (uint32_t)i * 4;
+        tracelog_log_pure();
+    }
+}
+
+#pragma region Unit
+
+TEST_CASE("binary_trace_round_trips_records", "tl_start")
+{
+    prepare_test();
+
+    REQUIRE(tl_start(trace_path, true, false) == Res_Ok);
+    for (uint32_t vi = 0; vi < 3; ++vi)
+    {
+        log_instructions(0x80001000 * (vi + 1), 100);
+        tracelog_on_vi();
+    }
+    tl_stop();
+
+    core_trace_reader reader;
+    REQUIRE(reader.open(trace_path) == Res_Ok);
+    REQUIRE(reader.header().index_offset != 0);
+    REQUIRE(reader.header().start_vi == -1);
+    REQUIRE(reader.chunks().size() == 3);
+
+    for (uint32_t vi = 0; vi < 3; ++vi)
+    {
+        const auto &chunk = reader.chunks()[vi].header;
+        REQUIRE(chunk.vi == vi);
+        REQUIRE(chunk.record_count == 100);
+        REQUIRE(chunk.pc_min == 0x80001000 * (vi + 1));
+        REQUIRE(chunk.pc_max == 0x80001000 * (vi + 1) + 99 * 4);
+
+        std::vector<core_trace_record> records;
+        REQUIRE(reader.read_chunk(vi, records) == Res_Ok);
+        REQUIRE(records.size() == 100);
+        REQUIRE(records[42].pc == 0x80001000 * (vi + 1) + 42 * 4);
+        REQUIRE(records[42].opcode == 0);
+    }
+}
+
+TEST_CASE("binary_trace_splits_long_vis_into_chunks", "tl_start")
+{
+    prepare_test();
+
+    REQUIRE(tl_start(trace_path, true, false) == Res_Ok);
+    tracelog_on_vi();
+    log_instructions(0x80000000, 100000);
+    tracelog_on_vi();
+    log_instructions(0x80400000, 10);
+    tl_stop();
+
+    core_trace_reader reader;
+    REQUIRE(reader.open(trace_path) == Res_Ok);
+    REQUIRE(reader.chunks().size() == 3);
+    REQUIRE(reader.chunks()[0].header.vi == 1);
+    REQUIRE(reader.chunks()[1].header.vi == 1);
+    REQUIRE(reader.chunks()[0].header.record_count + reader.chunks()[1].header.record_count == 100000);
+    REQUIRE(reader.chunks()[2].header.vi == 2);
+
+    REQUIRE(reader.find_vi(0) == 0);
+    REQUIRE(reader.find_vi(1) == 0);
+    REQUIRE(reader.find_vi(2) == 2);
+    REQUIRE(reader.find_vi(3) == 3);
+}
+
+TEST_CASE("unfinished_binary_trace_is_readable", "core_trace_reader")
+{
+    prepare_test();
+
+    REQUIRE(tl_start(trace_path, true, false) == Res_Ok);
+    log_instructions(0x80000000, 100);
+    tracelog_on_vi();
+    log_instructions(0x80000000, 50);
+    tl_stop();
+
+    // Drops the index as if tracing never stopped.
+    {
+        std::fstream file(trace_path, std::ios::binary | std::ios::in | std::ios::out);
+        const uint64_t index_offset = 0;
+        file.seekp(offsetof(core_trace_header, index_offset));
+        file.write((const char *)&index_offset, sizeof(index_offset));
+    }
+
+    core_trace_reader reader;
+    REQUIRE(reader.open(trace_path) == Res_Ok);
+    REQUIRE(reader.chunks().size() == 2);
+    REQUIRE(reader.chunks()[1].header.record_count == 50);
+
+    std::vector<core_trace_record> records;
+    REQUIRE(reader.read_chunk(1, records) == Res_Ok);
+    REQUIRE(records.back().pc == 0x80000000 + 49 * 4);
+}
+
+TEST_CASE("writer_gives_pool_thread_back_while_tracing", "tl_start")
+{
+    prepare_test();
+
+    static std::atomic<size_t> running_tasks;
+    static std::atomic<size_t> submitted_tasks;
+    running_tasks = 0;
+    submitted_tasks = 0;
+    params.submit_task = [](const std::function<void()> &func) {
+        ++submitted_tasks;
+        ++running_tasks;
+        std::thread([func] {
+            func();
+            --running_tasks;
+        }).detach();
+    };
+    core_create(&params, &ctx);
+
+    REQUIRE(tl_start(trace_path, true, false) == Res_Ok);
+    REQUIRE(submitted_tasks == 0);
+
+    for (uint32_t vi = 0; vi < 3; ++vi)
+    {
+        log_instructions(0x80000000, 100);
+        tracelog_on_vi();
+
+        // The writer exits once it has written the chunk, and the next publish submits it again.
+        while (running_tasks != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    REQUIRE(submitted_tasks == 3);
+
+    tl_stop();
+    REQUIRE(read_records().size() == 300);
+}
+
+TEST_CASE("text_trace_writes_one_line_per_instruction", "tl_start")
+{
+    prepare_test();
+
+    // addiu sp, sp, -0x18
+    vr_op = 0x27BDFFE8;
+
+    REQUIRE(tl_start(trace_path, false, false) == Res_Ok);
+    log_instructions(0x80000000, 100000);
+    tl_stop();
+
+    std::ifstream file(trace_path);
+    std::string line;
+    std::string last_line;
+    size_t lines = 0;
+    while (std::getline(file, line))
+    {
+        last_line = line;
+        ++lines;
+    }
+    REQUIRE(lines == 100000);
+    REQUIRE(last_line.starts_with("80061a7c: 27bdffe8 addiu sp, sp, +ffe8"));
+}
+
+TEST_CASE("filter_restricts_addresses_and_classes", "tl_set_filter")
+{
+    prepare_test();
+
+    // addiu sp, sp, -0x18
+    vr_op = 0x27BDFFE8;
+
+    tl_set_filter({
+        .pc_ranges = {{0x80000100, 0x800001FF}, {0x80000300, 0x80000303}},
+        .classes = core_tl_class_alu,
+    });
+    REQUIRE(tl_start(trace_path, true, false) == Res_Ok);
+
+    REQUIRE(tracelog_is_traced(0x80000100, vr_op));
+    REQUIRE_FALSE(tracelog_is_traced(0x80000200, vr_op));
+    // lw at, 0x10(sp)
+    REQUIRE_FALSE(tracelog_is_traced(0x80000100, 0x8FA10010));
+
+    log_instructions(0x80000000, 0x100);
+    tl_stop();
+
+    const auto records = read_records();
+    REQUIRE(records.size() == 0x40 + 1);
+    REQUIRE(records.front().pc == 0x80000100);
+    REQUIRE(records[0x3F].pc == 0x800001FC);
+    REQUIRE(records.back().pc == 0x80000300);
+}
+
+TEST_CASE("filter_restricts_vis", "tl_set_filter")
+{
+    prepare_test();
+
+    tl_set_filter({.first_vi = 1, .last_vi = 2});
+    REQUIRE(tl_start(trace_path, true, false) == Res_Ok);
+    for (uint32_t vi = 0; vi < 4; ++vi)
+    {
+        log_instructions(0x80000000, 10);
+        tracelog_on_vi();
+    }
+    tl_stop();
+
+    core_trace_reader reader;
+    REQUIRE(reader.open(trace_path) == Res_Ok);
+    REQUIRE(reader.chunks().size() == 2);
+    REQUIRE(reader.chunks()[0].header.vi == 1);
+    REQUIRE(reader.chunks()[1].header.vi == 2);
+}
+
+TEST_CASE("filter_restricts_written_addresses", "tl_set_filter")
+{
+    prepare_test();
+
+    tl_set_filter({.write_ranges = {{0x80300012, 0x80300012}}});
+    REQUIRE(tl_start(trace_path, true, false) == Res_Ok);
+
+    // addiu sp, sp, -0x18
+    vr_op = 0x27BDFFE8;
+    log_instructions(0x80000000, 1);
+
+    // sw at, 0x10(sp)
+    vr_op = 0xAFA10010;
+    reg[29] = (int32_t)0x80300000;
+    log_instructions(0x80000004, 1);
+    reg[29] = (int32_t)0x80300004;
+    log_instructions(0x80000008, 1);
+
+    // sb at, 0x12(sp)
+    vr_op = 0xA3A10012;
+    reg[29] = (int32_t)0x80300000;
+    log_instructions(0x8000000C, 1);
+    reg[29] = (int32_t)0x80300001;
+    log_instructions(0x80000010, 1);
+    tl_stop();
+
+    const auto records = read_records();
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].pc == 0x80000004);
+    REQUIRE(records[0].operands[0] == 0x80300010);
+    REQUIRE(records[1].pc == 0x8000000C);
+}
+
+TEST_CASE("reader_rejects_invalid_files", "core_trace_reader")
+{
+    prepare_test();
+
+    core_trace_reader reader;
+    REQUIRE(reader.open(trace_path) == TL_BadFile);
+
+    std::ofstream(trace_path) << "not a trace file, but long enough to hold a header";
+    REQUIRE(reader.open(trace_path) == TL_InvalidFormat);
+}
+
+TEST_CASE("reader_rejects_index_larger_than_file", "core_trace_reader")
+{
+    prepare_test();
+
+    REQUIRE(tl_start(trace_path, true, false) == Res_Ok);
+    log_instructions(0x80000000, 100);
+    tl_stop();
+
+    core_trace_reader reader;
+    REQUIRE(reader.open(trace_path) == Res_Ok);
+    const uint64_t index_offset = reader.header().index_offset;
+
+    // Corrupts the index's chunk count.
+    {
+        std::fstream file(trace_path, std::ios::binary | std::ios::in | std::ios::out);
+        const uint32_t count = UINT32_MAX;
+        file.seekp((std::streamoff)(index_offset + offsetof(core_trace_index_header, count)));
+        file.write((const char *)&count, sizeof(count));
+    }
+
+    REQUIRE(reader.open(trace_path) == TL_InvalidFormat);
+    REQUIRE(reader.chunks().empty());
+}
+
+#pragma endregion
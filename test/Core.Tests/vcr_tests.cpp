@@ -7,6 +7,8 @@
 #include "stdafx.h"
 #include <Core/r4300/vcr.h>
 #include <Core/r4300/r4300.h>
+#include <Core/memory/st_delta.h>
+#include <set>
 
 static core_cfg cfg{};
 static core_params params{};
@@ -857,6 +859,37 @@ TEST_CASE("mutex_unlocked_during_input_callback_called_while_playback", "vcr_on_
     vcr_on_controller_poll(0, &input);
 }
 
+/*
+ * Tests that vcr_on_controller_poll notifies about the advanced sample with the VCR mutex unlocked.
+ */
+TEST_CASE("sample_changed_callback_called_unlocked_after_playback_poll", "vcr_on_controller_poll")
+{
+    prepare_test();
+
+    static std::vector<int32_t> samples;
+    samples.clear();
+    params.callbacks.input = [](core_buttons *, int) {};
+    params.callbacks.current_sample_changed = [](int32_t value) {
+        REQUIRE(!is_vcr_lock_held());
+        samples.push_back(value);
+    };
+
+    core_create(&params, &ctx);
+
+    vcr.inputs = {{1}, {2}, {3}, {4}};
+    vcr.hdr.length_samples = vcr.inputs.size();
+    vcr.hdr.controller_flags = CONTROLLER_X_PRESENT(0);
+    vcr.task = task_playback;
+    vcr.current_sample = 1;
+
+    core_buttons input{};
+    vcr_on_controller_poll(0, &input);
+    vcr_on_controller_poll(0, &input);
+
+    REQUIRE(samples == std::vector<int32_t>{2, 3});
+    REQUIRE(vcr.pending_event_count == 0);
+}
+
 /*
  * Tests that vcr_on_controller_poll unlocks the VCR mutex during the vr_pause_emu call.
  * This is important to avoid deadlocks when the input callback dispatches synchronous calls to other threads that also
@@ -1076,4 +1109,155 @@ TEST_CASE("invokes_task_callback_correctly", "vcr_continue_recording")
     REQUIRE(called);
 }
 
+// Tasks submitted via core_params::submit_task, which the prefetch tests run by hand.
+static std::vector<std::function<void()>> submitted_tasks;
+
+/**
+ * \brief Puts the VCR into playback at frame 50 with seek savestates at frames 0, 10 and 20, each of which is filled
+ * with its frame number.
+ */
+static void prepare_seek_savestates()
+{
+    submitted_tasks.clear();
+    params.submit_task = [](const std::function<void()> &func) { submitted_tasks.push_back(func); };
+    cfg.seek_savestate_interval = 10;
+
+    core_create(&params, &ctx);
+
+    vcr.task = task_playback;
+    vcr.hdr.length_samples = 100;
+    vcr.current_sample = 50;
+    vcr.seek_savestate_keyframe = std::make_shared<const std::vector<uint8_t>>(4096, 0);
+    for (const size_t frame : {0, 10, 20})
+    {
+        vcr.seek_savestates.insert(
+            frame, st_delta_encode(*vcr.seek_savestate_keyframe, std::vector<uint8_t>(4096, (uint8_t)frame)),
+            vcr.seek_savestate_keyframe);
+    }
+}
+
+TEST_CASE("decodes_closest_savestate_before_target", "vcr_prefetch_seek")
+{
+    prepare_test();
+    prepare_seek_savestates();
+
+    // Seeking to frame 16 with pause_at_end targets frame 15.
+    vcr_prefetch_seek("16", true);
+
+    REQUIRE(vcr.seek_prefetch.frame == 10);
+    REQUIRE(vcr.seek_prefetch.st.empty());
+    REQUIRE(submitted_tasks.size() == 1);
+
+    submitted_tasks[0]();
+
+    REQUIRE(vcr.seek_prefetch.st == std::vector<uint8_t>(4096, 10));
+}
+
+TEST_CASE("does_nothing_when_seeking_forward", "vcr_prefetch_seek")
+{
+    prepare_test();
+    prepare_seek_savestates();
+
+    vcr_prefetch_seek("60", true);
+
+    REQUIRE(vcr.seek_prefetch.frame == SIZE_MAX);
+    REQUIRE(submitted_tasks.empty());
+}
+
+TEST_CASE("stale_decode_is_dropped", "vcr_prefetch_seek")
+{
+    prepare_test();
+    prepare_seek_savestates();
+
+    vcr_prefetch_seek("16", true);
+    vcr_prefetch_seek("26", true);
+
+    REQUIRE(submitted_tasks.size() == 2);
+    submitted_tasks[0]();
+
+    REQUIRE(vcr.seek_prefetch.frame == 20);
+    REQUIRE(vcr.seek_prefetch.st.empty());
+
+    submitted_tasks[1]();
+
+    REQUIRE(vcr.seek_prefetch.st == std::vector<uint8_t>(4096, 20));
+}
+
+TEST_CASE("seek_savestate_deltas_stay_bounded", "vcr_create_n_frame_savestate")
+{
+    prepare_test();
+
+    static constexpr size_t pages = 64;
+    cfg.seek_savestate_interval = 1;
+    cfg.seek_savestate_max_count = 1000;
+    core_create(&params, &ctx);
+
+    // Every frame changes one more page than the previous one, so the savestates drift further away from the first.
+    static size_t current_frame;
+    ctx->st_do_memory = [](const std::vector<uint8_t> &, core_st_job, const core_st_callback &callback, bool) {
+        std::vector<uint8_t> buf(pages * ST_DELTA_PAGE_SIZE, 0);
+        for (size_t page = 0; page < std::min(current_frame, pages); ++page)
+        {
+            std::ranges::fill_n(buf.begin() + page * ST_DELTA_PAGE_SIZE, ST_DELTA_PAGE_SIZE, (uint8_t)(page + 1));
+        }
+        callback({.result = Res_Ok}, buf);
+        return true;
+    };
+
+    vcr.task = task_recording;
+    for (current_frame = 0; current_frame < pages * 2; ++current_frame)
+    {
+        vcr.current_sample = current_frame;
+        vcr_create_n_frame_savestate(current_frame);
+    }
+
+    std::set<const std::vector<uint8_t> *> keyframes;
+    for (const auto &st : vcr.seek_savestates)
+    {
+        REQUIRE(st.data.size() <= pages * ST_DELTA_PAGE_SIZE / SEEK_SAVESTATE_REKEY_DIVISOR);
+        keyframes.insert(st.keyframe.get());
+    }
+    REQUIRE(vcr.seek_savestates.size() == pages * 2);
+    REQUIRE(keyframes.size() > 1);
+
+    // Savestates encoded against an older keyframe still decode.
+    std::vector<uint8_t> st;
+    REQUIRE(st_delta_decode(*vcr.seek_savestates.find(3)->keyframe, vcr.seek_savestates.find(3)->data, st));
+    REQUIRE(st[2 * ST_DELTA_PAGE_SIZE] == 3);
+    REQUIRE(st[3 * ST_DELTA_PAGE_SIZE] == 0);
+}
+
+#pragma endregion
+
+#pragma region Benchmark
+
+TEST_CASE("playback_poll_throughput", "[.][benchmark]")
+{
+    prepare_test();
+
+    static int32_t last_sample = -1;
+    params.callbacks.input = [](core_buttons *, int) {};
+    params.callbacks.current_sample_changed = [](int32_t value) { last_sample = value; };
+    core_create(&params, &ctx);
+
+    constexpr int32_t polls = 10000;
+
+    vcr.inputs = std::vector<core_buttons>(polls, {0x1234});
+    vcr.hdr.length_samples = vcr.inputs.size();
+    vcr.hdr.controller_flags = CONTROLLER_X_PRESENT(0);
+    vcr.task = task_playback;
+
+    // Each run plays back the whole movie, which is roughly 3 minutes of single-controller input.
+    BENCHMARK("playback_10000_polls")
+    {
+        vcr.current_sample = 0;
+        core_buttons input{};
+        for (int32_t i = 0; i < polls; ++i)
+        {
+            vcr_on_controller_poll(0, &input);
+        }
+        return last_sample;
+    };
+}
+
 #pragma endregion
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Core/memory/memory.h>
+#include <Core/r4300/macros.h>
+#include <Core/r4300/r4300.h>
+#include <Core/r4300/recomp.h>
+
+static core_cfg cfg{};
+static core_params params{};
+static core_ctx *ctx = nullptr;
+
+// The pages holding the code under test, the page which stops execution when jumped to, and the page loads and stores
+// go to.
+constexpr uint32_t PAGE_A = 0x80001000;
+constexpr uint32_t PAGE_B = 0x80002000;
+constexpr uint32_t STOP_ADDR = 0x80003000;
+constexpr uint32_t DATA_PAGE = 0x80004000;
+
+// The register holding DATA_PAGE, which the generated code never writes to.
+constexpr uint32_t DATA_BASE_REG = 26;
+
+/// The state compared between the cached interpreter and the dynarec after running the same code.
+struct t_state
+{
+    std::array<int64_t, 32> regs;
+    int64_t hi;
+    int64_t lo;
+    uint32_t count;
+    std::vector<uint32_t> memory;
+
+    bool operator==(const t_state &) const = default;
+};
+
+// The registers and RDRAM every run starts with.
+static std::array<int64_t, 32> initial_regs;
+static std::vector<uint32_t> initial_rdram;
+
+static uint32_t r_type(const uint32_t funct, const uint32_t rd, const uint32_t rs, const uint32_t rt,
+                       const uint32_t sa = 0)
+{
+    return rs << 21 | rt << 16 | rd << 11 | sa << 6 | funct;
+}
+
+static uint32_t i_type(const uint32_t op, const uint32_t rt, const uint32_t rs, const uint16_t imm)
+{
+    return op << 26 | rs << 21 | rt << 16 | imm;
+}
+
+static uint32_t lui(const uint32_t rt, const uint16_t imm)
+{
+    return i_type(0x0F, rt, 0, imm);
+}
+
+static uint32_t addiu(const uint32_t rt, const uint32_t rs, const uint16_t imm)
+{
+    return i_type(0x09, rt, rs, imm);
+}
+
+static uint32_t ori(const uint32_t rt, const uint32_t rs, const uint16_t imm)
+{
+    return i_type(0x0D, rt, rs, imm);
+}
+
+static uint32_t j(const uint32_t target)
+{
+    return 0x02 << 26 | (target >> 2 & 0x3FFFFFF);
+}
+
+/**
+ * \brief Writes code or data to RDRAM at a KSEG0 address.
+ */
+static void write_words(const uint32_t addr, const std::vector<uint32_t> &words)
+{
+    std::ranges::copy(words, rdram + (addr & 0x7FFFFF) / 4);
+}
+
+/**
+ * \brief Stops the interpreter, standing in for an instruction the dynarec can't compile.
+ */
+static void stop_op()
+{
+    stop = 1;
+    PC++;
+}
+
+/**
+ * \brief Maps RDRAM into the KSEG0 and KSEG1 regions of the handler tables and seeds the registers.
+ */
+static void prepare_test()
+{
+    cfg = {};
+    params.cfg = &cfg;
+    core_create(&params, &ctx);
+
+    memset(rdram, 0, sizeof(rdram));
+    for (int32_t i = 0; i < 0x80; i++)
+    {
+        for (const auto base : {0x8000, 0xa000})
+        {
+            readmem[base + i] = read_rdram;
+            readmemb[base + i] = read_rdramb;
+            readmemh[base + i] = read_rdramh;
+            readmemd[base + i] = read_rdramd;
+            writemem[base + i] = write_rdram;
+            writememb[base + i] = write_rdramb;
+            writememh[base + i] = write_rdramh;
+            writememd[base + i] = write_rdramd;
+        }
+    }
+
+    std::mt19937_64 rng(42);
+    for (auto &r : initial_regs)
+    {
+        r = (int64_t)rng();
+    }
+    initial_regs[0] = 0;
+    initial_regs[DATA_BASE_REG] = (int32_t)DATA_PAGE;
+
+    // The stop page ends every run, which jumps to it with its delay slot.
+    write_words(STOP_ADDR, {0});
+}
+
+/**
+ * \brief Runs the code in RDRAM from an address until it jumps to STOP_ADDR.
+ * \param interpreter The interpreter loop to run the code with.
+ * \param entry The address to start at.
+ * \return The state after running.
+ */
+static t_state run(void (*interpreter)(), const uint32_t entry)
+{
+    std::ranges::copy(initial_regs, reg);
+    hi = 0x0123456789ABCDEF;
+    lo = -1;
+    initial_rdram.assign(rdram, rdram + 0x5000 / 4);
+
+    interpcore = 0;
+    dynacore = 0;
+    stop = 0;
+    skip_jump = 0;
+    delay_slot = 0;
+    core_Count = 0;
+    next_interrupt = UINT32_MAX;
+
+    init_blocks();
+    jump_to(STOP_ADDR);
+    PC->ops = stop_op;
+    jump_to(entry);
+    last_addr = PC->addr;
+
+    interpreter();
+
+    t_state state{
+        .hi = hi,
+        .lo = lo,
+        .count = core_Count,
+        .memory = std::vector(rdram, rdram + 0x5000 / 4),
+    };
+    std::copy_n(reg, 32, state.regs.begin());
+
+    // Leave RDRAM as it was for the next run.
+    std::ranges::copy(initial_rdram, rdram);
+    return state;
+}
+
+/**
+ * \brief Runs the code in RDRAM through the cached interpreter and the dynarec and checks that both end up in the same
+ * state.
+ * \param entry The address to start at.
+ * \return The state after running, with the dynarec's blocks still alive until the next run.
+ */
+static t_state run_both(const uint32_t entry)
+{
+    const auto expected = run(cached_interpreter, entry);
+    free_blocks();
+
+    const auto actual = run(x64_dynarec, entry);
+    REQUIRE(actual.regs == expected.regs);
+    REQUIRE(actual.hi == expected.hi);
+    REQUIRE(actual.lo == expected.lo);
+    REQUIRE(actual.count == expected.count);
+    REQUIRE(actual.memory == expected.memory);
+    return actual;
+}
+
+/**
+ * \brief Gets the dynarec's entry for an address.
+ */
+static void *entry_at(const uint32_t addr)
+{
+    const precomp_block *block = blocks[addr >> 12];
+    REQUIRE(block);
+    REQUIRE(block->x64_entries);
+    return block->x64_entries[(addr & 0xFFF) / 4];
+}
+
+/**
+ * \brief Gets whether a run of compiled code starts at an address.
+ */
+static bool compiled_at(const uint32_t addr)
+{
+    const auto entry = entry_at(addr);
+    return entry && entry != X64_FALLBACK_ENTRY;
+}
+
+#pragma region Unit
+
+TEST_CASE("compiled_random_integer_code_matches_cached_interpreter", "x64_dynarec")
+{
+    prepare_test();
+
+    // Compiled ops, and fallbacks for multiplications and memory accesses which split the code into runs.
+    constexpr uint32_t r_functs[] = {0x00, 0x02, 0x03, 0x04, 0x06, 0x07, 0x10, 0x11, 0x12, 0x13, 0x14, 0x16,
+                                     0x17, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x2A, 0x2B, 0x2C,
+                                     0x2D, 0x2E, 0x2F, 0x38, 0x3A, 0x3B, 0x3C, 0x3E, 0x3F, 0x18, 0x19, 0x1C};
+    constexpr uint32_t i_ops[] = {0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+
+    for (const uint32_t seed : {1234, 5678, 9012, 3456})
+    {
+        std::mt19937 rng(seed);
+        const auto random_reg = [&] { return (uint32_t)rng() % 32; };
+        const auto random_dst = [&] {
+            uint32_t r;
+            do
+            {
+                r = random_reg();
+            }
+            while (r == DATA_BASE_REG);
+            return r;
+        };
+
+        // The first instruction runs before the block is compiled, so the code starts with a NOP.
+        std::vector<uint32_t> code{0};
+        while (code.size() < 800)
+        {
+            switch (rng() % 8)
+            {
+            case 0:
+            case 1:
+            case 2:
+                code.push_back(r_type(r_functs[rng() % std::size(r_functs)], random_dst(), random_reg(), random_reg(),
+                                      rng() % 32));
+                break;
+            case 3:
+            case 4:
+            case 5:
+                code.push_back(i_type(i_ops[rng() % std::size(i_ops)], random_dst(), random_reg(), (uint16_t)rng()));
+                break;
+            case 6: {
+                // LW, SW, LD and SD relative to the data page.
+                constexpr uint32_t mem_ops[] = {0x23, 0x2B, 0x37, 0x3F};
+                const uint32_t op = mem_ops[rng() % std::size(mem_ops)];
+                const uint16_t offset = (uint16_t)(rng() % 0x1000 & ~7u);
+                const uint32_t rt = op == 0x23 || op == 0x37 ? random_dst() : random_reg();
+                code.push_back(i_type(op, rt, DATA_BASE_REG, offset));
+                break;
+            }
+            default:
+                code.push_back(r_type(0x21, random_dst(), random_reg(), random_reg()));
+                break;
+            }
+        }
+        code.push_back(j(STOP_ADDR));
+        code.push_back(0);
+        write_words(PAGE_A, code);
+
+        std::vector<uint32_t> data(0x400);
+        std::ranges::generate(data, rng);
+        write_words(DATA_PAGE, data);
+
+        run_both(PAGE_A);
+        REQUIRE(compiled_at(PAGE_A + 4));
+        free_blocks();
+    }
+}
+
+TEST_CASE("long_runs_spill_registers", "x64_dynarec")
+{
+    prepare_test();
+
+    // Each instruction touches three registers, cycling through all of them so the register cache runs out of host
+    // registers and has to write back and evict.
+    std::vector<uint32_t> code{0};
+    for (uint32_t i = 0; i < 120; ++i)
+    {
+        const uint32_t rd = 1 + i * 7 % 31;
+        const uint32_t rs = 1 + i * 11 % 31;
+        const uint32_t rt = 1 + i * 13 % 31;
+        code.push_back(r_type(i % 2 ? 0x2D : 0x26, rd == DATA_BASE_REG ? 25 : rd, rs, rt));
+    }
+    code.push_back(j(STOP_ADDR));
+    code.push_back(0);
+    write_words(PAGE_A, code);
+
+    run_both(PAGE_A);
+    REQUIRE(compiled_at(PAGE_A + 4));
+    free_blocks();
+}
+
+TEST_CASE("registers_used_as_source_and_destination", "x64_dynarec")
+{
+    prepare_test();
+
+    write_words(PAGE_A, {
+                            0,
+                            r_type(0x21, 8, 8, 8),
+                            r_type(0x23, 9, 9, 8),
+                            r_type(0x04, 10, 10, 10),
+                            r_type(0x2A, 11, 11, 11),
+                            addiu(12, 12, 0xFFFF),
+                            i_type(0x0B, 13, 13, 0x8000),
+                            r_type(0x3C, 14, 0, 14, 31),
+                            j(STOP_ADDR),
+                            0,
+                        });
+
+    const auto state = run_both(PAGE_A);
+    REQUIRE(state.regs[11] == 0);
+    REQUIRE(compiled_at(PAGE_A + 4));
+    free_blocks();
+}
+
+TEST_CASE("hi_and_lo_moves", "x64_dynarec")
+{
+    prepare_test();
+
+    write_words(PAGE_A, {
+                            0,
+                            r_type(0x10, 8, 0, 0),
+                            r_type(0x12, 9, 0, 0),
+                            r_type(0x11, 0, 9, 0),
+                            r_type(0x13, 0, 8, 0),
+                            r_type(0x10, 10, 0, 0),
+                            r_type(0x12, 11, 0, 0),
+                            j(STOP_ADDR),
+                            0,
+                        });
+
+    const auto state = run_both(PAGE_A);
+    REQUIRE(state.regs[10] == -1);
+    REQUIRE(state.regs[11] == 0x0123456789ABCDEF);
+    REQUIRE(state.hi == -1);
+    REQUIRE(state.lo == 0x0123456789ABCDEF);
+    free_blocks();
+}
+
+TEST_CASE("self_modifying_code_recompiles_runs", "x64_dynarec")
+{
+    prepare_test();
+
+    // Page A accumulates a constant into t2. Page B patches one of its instructions on its first visit and jumps back,
+    // which recompiles page A, and stops on its second.
+    const uint32_t patched = addiu(8, 8, 0x0100);
+    write_words(PAGE_A, {
+                            0,
+                            lui(8, 0x1234),
+                            addiu(8, 8, 0x0001),
+                            r_type(0x21, 10, 10, 8),
+                            j(PAGE_B),
+                            0,
+                        });
+    write_words(PAGE_B, {
+                            i_type(0x05, 0, 11, 8),
+                            0,
+                            addiu(11, 0, 1),
+                            lui(12, patched >> 16),
+                            ori(12, 12, patched & 0xFFFF),
+                            lui(13, 0x8000),
+                            i_type(0x2B, 12, 13, (PAGE_A + 8) & 0xFFFF),
+                            j(PAGE_A),
+                            0,
+                            j(STOP_ADDR),
+                            0,
+                        });
+    initial_regs[10] = 0;
+    initial_regs[11] = 0;
+
+    const auto state = run_both(PAGE_A);
+    REQUIRE(state.regs[10] == 0x12340001 + 0x12340100);
+    REQUIRE(state.memory[(PAGE_A & 0xFFFF) / 4 + 2] == patched);
+    REQUIRE(compiled_at(PAGE_A + 4));
+    free_blocks();
+}
+
+TEST_CASE("uncompilable_ops_fall_back_to_cached_handlers", "x64_dynarec")
+{
+    prepare_test();
+
+    // MULT and LW can't be compiled, and neither can the stop handler swapped into its precomp_instr.
+    write_words(PAGE_A, {
+                            0,
+                            r_type(0x21, 8, 9, 10),
+                            r_type(0x18, 0, 8, 11),
+                            r_type(0x12, 12, 0, 0),
+                            i_type(0x23, 13, DATA_BASE_REG, 0x10),
+                            r_type(0x21, 14, 13, 12),
+                            j(STOP_ADDR),
+                            0,
+                        });
+    write_words(DATA_PAGE + 0x10, {0xDEADBEEF});
+
+    const auto state = run_both(PAGE_A);
+    REQUIRE(state.regs[13] == (int64_t)(int32_t)0xDEADBEEF);
+
+    REQUIRE(compiled_at(PAGE_A + 0x04));
+    REQUIRE(entry_at(PAGE_A + 0x08) == X64_FALLBACK_ENTRY);
+    REQUIRE(compiled_at(PAGE_A + 0x0C));
+    REQUIRE(entry_at(PAGE_A + 0x10) == X64_FALLBACK_ENTRY);
+    REQUIRE(compiled_at(PAGE_A + 0x14));
+    REQUIRE(entry_at(PAGE_A + 0x18) == X64_FALLBACK_ENTRY);
+    REQUIRE(entry_at(STOP_ADDR) == X64_FALLBACK_ENTRY);
+    free_blocks();
+}
+
+#pragma endregion
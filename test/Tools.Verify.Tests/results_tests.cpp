@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <Results.h>
+
+using namespace Runner;
+
+#pragma region Unit
+
+TEST_CASE("playback_reaching_end_is_ok", "get_status")
+{
+    REQUIRE(get_status(true, 1000, 1000) == t_status::ok);
+    REQUIRE(get_status(true, 0, 0) == t_status::ok);
+}
+
+TEST_CASE("playback_stopping_early_is_incomplete", "get_status")
+{
+    REQUIRE(get_status(true, 0, 1000) == t_status::incomplete);
+    REQUIRE(get_status(true, 999, 1000) == t_status::incomplete);
+}
+
+TEST_CASE("playback_not_stopping_is_timeout", "get_status")
+{
+    REQUIRE(get_status(false, 500, 1000) == t_status::timeout);
+    REQUIRE(get_status(false, 1000, 1000) == t_status::timeout);
+}
+
+TEST_CASE("identical_hashes_dont_mismatch", "find_first_mismatch")
+{
+    const std::vector<t_hash> hashes = {{0, 1}, {60, 2}, {120, 3}};
+
+    REQUIRE(find_first_mismatch(hashes, hashes) == std::nullopt);
+    REQUIRE(find_first_mismatch({}, {}) == std::nullopt);
+}
+
+TEST_CASE("differing_hash_mismatches_at_its_sample", "find_first_mismatch")
+{
+    const std::vector<t_hash> actual = {{0, 1}, {60, 2}, {120, 3}};
+    const std::vector<t_hash> expected = {{0, 1}, {60, 5}, {120, 6}};
+
+    REQUIRE(find_first_mismatch(actual, expected) == 60);
+}
+
+TEST_CASE("shorter_sequence_mismatches_at_first_missing_sample", "find_first_mismatch")
+{
+    const std::vector<t_hash> shorter = {{0, 1}, {60, 2}};
+    const std::vector<t_hash> longer = {{0, 1}, {60, 2}, {120, 3}};
+
+    REQUIRE(find_first_mismatch(shorter, longer) == 120);
+    REQUIRE(find_first_mismatch(longer, shorter) == 120);
+}
+
+TEST_CASE("differing_samples_mismatch_at_earlier_sample", "find_first_mismatch")
+{
+    const std::vector<t_hash> actual = {{0, 1}, {90, 2}};
+    const std::vector<t_hash> expected = {{0, 1}, {60, 2}};
+
+    REQUIRE(find_first_mismatch(actual, expected) == 60);
+    REQUIRE(find_first_mismatch(expected, actual) == 60);
+}
+
+TEST_CASE("result_round_trips_through_json", "to_json")
+{
+    const t_result result{
+        .movie = "movie.m64",
+        .status = t_status::incomplete,
+        .message = "Playback stopped at sample 5",
+        .length_samples = 10,
+        .samples_played = 5,
+        .seconds = 1.5,
+        .hashes = {{0, 0xFFFFFFFFFFFFFFFF}},
+        .first_mismatch = 0,
+    };
+
+    const t_result parsed = nlohmann::json(result).get<t_result>();
+
+    REQUIRE(parsed.movie == result.movie);
+    REQUIRE(parsed.status == t_status::incomplete);
+    REQUIRE(parsed.samples_played == 5);
+    REQUIRE(parsed.hashes.size() == 1);
+    REQUIRE(parsed.hashes[0].hash == 0xFFFFFFFFFFFFFFFF);
+    REQUIRE(parsed.first_mismatch == 0);
+}
+
+#pragma endregion